@@ -0,0 +1,78 @@
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <Engine/BinarySinkFormat.hpp>
+#include <Engine/Operators.hpp>
+
+using namespace SNCB::Engine;
+namespace fs = std::filesystem;
+
+struct BinarySinkToCsvOptions {
+    std::string input;
+    // Empty writes the CSV file next to the input
+    std::string output;
+};
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " --input path [--output path]\n"
+              << "Converts a BINARY_FORMAT sink file into the CSV file a CSV_FORMAT sink would have written.\n"
+              << "  --input path   binary sink file\n"
+              << "  --output path  CSV file, overwritten (default: the input with extension .csv)" << std::endl;
+}
+
+static BinarySinkToCsvOptions parseOptions(int argc, char** argv) {
+    BinarySinkToCsvOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + flag);
+        }
+        std::string value = argv[++i];
+        if (flag == "--input") {
+            options.input = value;
+        } else if (flag == "--output") {
+            options.output = value;
+        } else {
+            throw std::invalid_argument("unknown option " + flag);
+        }
+    }
+    if (options.input.empty()) {
+        throw std::invalid_argument("--input is required");
+    }
+    if (options.output.empty()) {
+        options.output = fs::path(options.input).replace_extension(".csv").string();
+    }
+    if (fs::exists(options.output) && fs::equivalent(options.input, options.output)) {
+        throw std::invalid_argument("--output must differ from --input");
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+    }
+
+    try {
+        auto options = parseOptions(argc, argv);
+        BinarySinkReader reader(options.input);
+        CsvFileSink sink(SinkDescriptor{options.output, "CSV_FORMAT", false}, reader.getSchema());
+        TupleBuffer buffer(reader.getSchema(), BinaryFileSink::BlockTuples);
+        while (reader.readBlock(buffer)) {
+            sink.execute(buffer);
+        }
+        sink.finish();
+        std::cout << options.input << " (" << fs::file_size(options.input) << " bytes) -> " << options.output << " ("
+                  << fs::file_size(options.output) << " bytes), " << sink.getWrittenTuples() << " tuples" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Bench/Statistics.hpp>
+#include <Engine/CsvSource.hpp>
+#include <Engine/SourceCatalog.hpp>
+
+using namespace SNCB::Engine;
+namespace fs = std::filesystem;
+
+struct CsvBenchmarkOptions {
+    std::vector<std::string> sources;
+    std::string coordinatorConfig = "config/coordinator.yaml";
+    std::string workerConfig = "config/worker.yaml";
+    std::string dataDirectory = "data";
+    size_t scale = 1;
+    size_t tuplesPerBuffer = 1024;
+    int repetitions = 5;
+};
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "Measures CSV ingestion of the worker's sources into tuple buffers of all fields, against parsing\n"
+              << "line by line with strtod/strtoull, and checks that both read the same values.\n"
+              << "  --source name              logical source to read, repeatable (default weather and sncb)\n"
+              << "  --coordinator-config path  logical source schemas (default config/coordinator.yaml)\n"
+              << "  --worker-config path       physical CSV sources (default config/worker.yaml)\n"
+              << "  --data-dir dir             look up source files missing at their configured path here (default data)\n"
+              << "  --scale n                  repeat the rows of each file n times in a temporary copy (default 1)\n"
+              << "  --buffer-tuples n          tuples per buffer (default 1024)\n"
+              << "  --repetitions n            measured runs per source (default 5)" << std::endl;
+}
+
+static uint64_t parseNumber(const std::string& flag, const std::string& value) {
+    try {
+        size_t consumed = 0;
+        auto parsed = std::stoull(value, &consumed);
+        if (consumed == value.size() && parsed > 0) {
+            return parsed;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument(flag + " expects a positive integer, got '" + value + "'");
+}
+
+static CsvBenchmarkOptions parseOptions(int argc, char** argv) {
+    CsvBenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + flag);
+        }
+        std::string value = argv[++i];
+        if (flag == "--source") {
+            options.sources.push_back(value);
+        } else if (flag == "--coordinator-config") {
+            options.coordinatorConfig = value;
+        } else if (flag == "--worker-config") {
+            options.workerConfig = value;
+        } else if (flag == "--data-dir") {
+            options.dataDirectory = value;
+        } else if (flag == "--scale") {
+            options.scale = parseNumber(flag, value);
+        } else if (flag == "--buffer-tuples") {
+            options.tuplesPerBuffer = parseNumber(flag, value);
+        } else if (flag == "--repetitions") {
+            options.repetitions = static_cast<int>(parseNumber(flag, value));
+        } else {
+            throw std::invalid_argument("unknown option " + flag);
+        }
+    }
+    if (options.sources.empty()) {
+        options.sources = {"weather", "sncb"};
+    }
+    return options;
+}
+
+/** @brief Copy of the file with its rows repeated, the header (if any) written once. */
+static fs::path writeScaledCopy(const PhysicalSourceConfig& config, size_t scale) {
+    std::ifstream input(config.filePath, std::ios::binary);
+    if (!input.is_open()) {
+        throw std::runtime_error("Cannot open " + config.filePath);
+    }
+    std::string header;
+    if (config.skipHeader) {
+        std::getline(input, header);
+        header += '\n';
+    }
+    std::string rows((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (!rows.empty() && rows.back() != '\n') {
+        rows += '\n';
+    }
+    auto path = fs::temp_directory_path() / ("csv_parse_benchmark_" + config.logicalSourceName + ".csv");
+    std::ofstream output(path, std::ios::binary);
+    output << header;
+    for (size_t i = 0; i < scale; ++i) {
+        output << rows;
+    }
+    if (!output) {
+        throw std::runtime_error("Cannot write " + path.string());
+    }
+    return path;
+}
+
+/** @brief Reads the file with the CSV source; collects all values column by column if columns is given. */
+static void readWithSource(const PhysicalSourceConfig& config, const SchemaPtr& schema, size_t tuplesPerBuffer,
+                           std::vector<std::vector<uint64_t>>* columns) {
+    CsvSource source(config, schema);
+    TupleBuffer buffer(schema, tuplesPerBuffer);
+    while (source.fillBuffer(buffer)) {
+        for (size_t field = 0; columns != nullptr && field < schema->size(); ++field) {
+            const auto* column = buffer.getColumn(field);
+            (*columns)[field].insert((*columns)[field].end(), column, column + buffer.getNumberOfTuples());
+        }
+    }
+}
+
+/** @brief Reference reader: getline and strtod/strtoull per field, as the engine read CSV before. */
+static void readLineByLine(const PhysicalSourceConfig& config, const SchemaPtr& schema,
+                           std::vector<std::vector<uint64_t>>* columns) {
+    std::ifstream file(config.filePath);
+    std::string line;
+    if (config.skipHeader) {
+        std::getline(file, line);
+    }
+    std::vector<uint64_t> row(schema->size());
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            continue;
+        }
+        // Fields after the end of a short line stay 0
+        std::fill(row.begin(), row.end(), 0);
+        const char* cursor = line.c_str();
+        for (size_t field = 0; field < schema->size(); ++field) {
+            row[field] = schema->getField(field).type == DataType::FLOAT64 ? std::bit_cast<uint64_t>(std::strtod(cursor, nullptr))
+                                                                            : std::strtoull(cursor, nullptr, 10);
+            while (*cursor != '\0' && *cursor != config.delimiter) {
+                ++cursor;
+            }
+            if (*cursor == '\0') {
+                break;
+            }
+            ++cursor;
+        }
+        for (size_t field = 0; columns != nullptr && field < schema->size(); ++field) {
+            (*columns)[field].push_back(row[field]);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+    }
+
+    try {
+        auto options = parseOptions(argc, argv);
+        auto catalog = SourceCatalog::fromYaml(options.coordinatorConfig, options.workerConfig, options.dataDirectory);
+        bool consistent = true;
+
+        std::cout << "=== CSV Parse Benchmark: rows repeated " << options.scale << " times ===" << std::endl;
+        for (const auto& sourceName : options.sources) {
+            auto config = catalog.getPhysicalSource(sourceName);
+            auto schema = catalog.getSchema(sourceName);
+            std::optional<fs::path> scaledCopy;
+            if (options.scale > 1) {
+                scaledCopy = writeScaledCopy(config, options.scale);
+                config.filePath = scaledCopy->string();
+            }
+            auto bytes = static_cast<double>(fs::file_size(config.filePath));
+
+            std::vector<double> sourceSeconds;
+            std::vector<double> lineSeconds;
+            // The first run warms the page cache and is not measured
+            for (int run = 0; run <= options.repetitions; ++run) {
+                auto start = std::chrono::steady_clock::now();
+                readWithSource(config, schema, options.tuplesPerBuffer, nullptr);
+                auto middle = std::chrono::steady_clock::now();
+                readLineByLine(config, schema, nullptr);
+                auto end = std::chrono::steady_clock::now();
+                if (run > 0) {
+                    sourceSeconds.push_back(std::chrono::duration<double>(middle - start).count());
+                    lineSeconds.push_back(std::chrono::duration<double>(end - middle).count());
+                }
+            }
+            std::vector<std::vector<uint64_t>> parsed(schema->size());
+            std::vector<std::vector<uint64_t>> reference(schema->size());
+            readWithSource(config, schema, options.tuplesPerBuffer, &parsed);
+            readLineByLine(config, schema, &reference);
+            if (scaledCopy) {
+                fs::remove(*scaledCopy);
+            }
+
+            size_t mismatches = 0;
+            for (size_t field = 0; field < schema->size(); ++field) {
+                if (parsed[field].size() != reference[field].size()) {
+                    mismatches += std::max(parsed[field].size(), reference[field].size());
+                    continue;
+                }
+                for (size_t row = 0; row < parsed[field].size(); ++row) {
+                    mismatches += parsed[field][row] != reference[field][row];
+                }
+            }
+            consistent = consistent && mismatches == 0;
+
+            auto source = SNCB::Bench::summarize(sourceSeconds);
+            auto line = SNCB::Bench::summarize(lineSeconds);
+            std::cout << std::fixed << std::setprecision(1) << sourceName << ": " << parsed.front().size() << " rows, "
+                      << schema->size() << " columns, " << bytes / 1e6 << " MB; CsvSource " << bytes / source.median / 1e6
+                      << " MB/s (p95 " << bytes / source.p95 / 1e6 << "), line by line " << bytes / line.median / 1e6
+                      << " MB/s, " << std::setprecision(2) << line.median / source.median << "x; " << mismatches
+                      << " mismatching values" << std::endl;
+        }
+        return consistent ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
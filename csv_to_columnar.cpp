@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Engine/ColumnarFile.hpp>
+#include <Engine/CsvSource.hpp>
+#include <Engine/SourceCatalog.hpp>
+
+using namespace SNCB::Engine;
+namespace fs = std::filesystem;
+
+struct CsvToColumnarOptions {
+    std::vector<std::string> sources;
+    std::string coordinatorConfig = "config/coordinator.yaml";
+    std::string workerConfig = "config/worker.yaml";
+    std::string dataDirectory = "data";
+    // Empty writes each columnar file next to its CSV file
+    std::string outputDirectory;
+    size_t rowsPerChunk = 65536;
+    std::string timeField = "timestamp";
+};
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "Converts the CSV files of the worker's sources once into columnar files (<name>.sncbcol) that\n"
+              << "LocalQuery --columnar source=path replays without parsing.\n"
+              << "  --source name              logical source to convert, repeatable (default weather and sncb)\n"
+              << "  --coordinator-config path  logical source schemas (default config/coordinator.yaml)\n"
+              << "  --worker-config path       physical CSV sources (default config/worker.yaml)\n"
+              << "  --data-dir dir             look up source files missing at their configured path here (default data)\n"
+              << "  --output-dir dir           directory of the columnar files (default: next to the CSV file)\n"
+              << "  --rows-per-chunk n         rows per chunk (default 65536)\n"
+              << "  --time-field name          field whose range each chunk records (default timestamp)" << std::endl;
+}
+
+static uint64_t parseNumber(const std::string& flag, const std::string& value) {
+    try {
+        size_t consumed = 0;
+        auto parsed = std::stoull(value, &consumed);
+        if (consumed == value.size() && parsed > 0) {
+            return parsed;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument(flag + " expects a positive integer, got '" + value + "'");
+}
+
+static CsvToColumnarOptions parseOptions(int argc, char** argv) {
+    CsvToColumnarOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + flag);
+        }
+        std::string value = argv[++i];
+        if (flag == "--source") {
+            options.sources.push_back(value);
+        } else if (flag == "--coordinator-config") {
+            options.coordinatorConfig = value;
+        } else if (flag == "--worker-config") {
+            options.workerConfig = value;
+        } else if (flag == "--data-dir") {
+            options.dataDirectory = value;
+        } else if (flag == "--output-dir") {
+            options.outputDirectory = value;
+        } else if (flag == "--rows-per-chunk") {
+            options.rowsPerChunk = parseNumber(flag, value);
+        } else if (flag == "--time-field") {
+            options.timeField = value;
+        } else {
+            throw std::invalid_argument("unknown option " + flag);
+        }
+    }
+    if (options.sources.empty()) {
+        options.sources = {"weather", "sncb"};
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+    }
+
+    try {
+        auto options = parseOptions(argc, argv);
+        auto catalog = SourceCatalog::fromYaml(options.coordinatorConfig, options.workerConfig, options.dataDirectory);
+        if (!options.outputDirectory.empty()) {
+            fs::create_directories(options.outputDirectory);
+        }
+
+        for (const auto& name : options.sources) {
+            const auto& config = catalog.getPhysicalSource(name);
+            auto schema = catalog.getSchema(name);
+            fs::path output = fs::path(config.filePath).replace_extension(".sncbcol");
+            if (!options.outputDirectory.empty()) {
+                output = fs::path(options.outputDirectory) / output.filename();
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            CsvSource source(config, schema);
+            ColumnarFileWriter writer(output.string(), schema, options.rowsPerChunk, options.timeField);
+            TupleBuffer buffer(schema, 4096);
+            while (source.fillBuffer(buffer)) {
+                writer.write(buffer);
+            }
+            writer.finish();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::cout << name << ": " << config.filePath << " -> " << output.string() << "\n  " << writer.getNumberOfRows()
+                      << " rows in " << writer.getChunks().size() << " chunks, " << fs::file_size(output) << " bytes, "
+                      << std::fixed << std::setprecision(3) << seconds << " s" << std::endl;
+            const auto& chunks = writer.getChunks();
+            if (!chunks.empty() && schema->contains(options.timeField)) {
+                uint64_t first = chunks.front().minTimestamp;
+                uint64_t last = chunks.front().maxTimestamp;
+                for (const auto& chunk : chunks) {
+                    first = std::min(first, chunk.minTimestamp);
+                    last = std::max(last, chunk.maxTimestamp);
+                }
+                std::cout << "  " << options.timeField << " from " << first << " to " << last << std::endl;
+            }
+        }
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,386 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include <Bench/E2EConfig.hpp>
+#include <Bench/ResourceSampler.hpp>
+#include <Bench/Statistics.hpp>
+#include <Engine/GeoContext.hpp>
+#include <Engine/LocalEngine.hpp>
+#include <Engine/QueryParser.hpp>
+#include <Engine/SncbGenerator.hpp>
+#include <Engine/SourceCatalog.hpp>
+
+using namespace SNCB::Engine;
+using namespace SNCB::Bench;
+namespace fs = std::filesystem;
+
+struct SweepOptions {
+    std::vector<std::string> configs;
+    // Parameters set or swept for every configuration, name and comma-separated values
+    std::vector<std::pair<std::string, std::string>> overrides;
+    std::string resultsPath = "e2e_sweep_results.csv";
+    std::string coordinatorConfig = "config/coordinator.yaml";
+    std::string workerConfig = "config/worker.yaml";
+    std::string dataDirectory = "data";
+    std::string areasFile = "data/high_risk_areas_ordered_unix.csv";
+    // Sink files are kept here; without it results are formatted and discarded
+    std::string outputDirectory;
+    uint64_t trains = 100;
+    bool list = false;
+};
+
+// Parameters runPoint applies; a sweep over any other one would repeat the same run under different labels
+static const std::vector<std::string> appliedParameters = {"numberOfWorkerThreads",
+                                                           "numberOfSources",
+                                                           "bufferSizeInBytes",
+                                                           "numberOfBuffersToProduce",
+                                                           "experimentMeasureIntervalInSeconds",
+                                                           "startupSleepIntervalInSeconds",
+                                                           "numberOfMeasurementsToCollect"};
+
+/** @brief Throughput of all queries of a point over one measurement interval. */
+struct Measurement {
+    size_t index = 0;
+    double seconds = 0.0;
+    uint64_t inputTuples = 0;
+    uint64_t outputTuples = 0;
+    double cpuPercent = 0.0;
+    double rssMb = 0.0;
+};
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " --config path [--config path ...] [options]\n"
+              << "Runs every combination of the comma-separated parameters of NES e2e benchmark configurations\n"
+              << "(e.g. numberOfWorkerThreads: 1,2) on the local engine and writes one CSV row per measurement.\n"
+              << "`type: SNCB` sources are generated within their bounds, numberOfBuffersToProduce buffers per source;\n"
+              << "other sources are read from the worker configuration. Every source copy (numberOfSources) runs on its own\n"
+              << "thread, and at most numberOfWorkerThreads of them execute their pipelines at once. The buffer pool sizes\n"
+              << "and other engine parameters are recorded in the results but not applied, so they cannot be swept.\n"
+              << "  --config path              e2e configuration, e.g. config/sncb_query2_e2e.yaml, repeatable\n"
+              << "  --set name=v1,v2           set or sweep a parameter in every configuration, repeatable\n"
+              << "  --results path             results CSV (default e2e_sweep_results.csv)\n"
+              << "  --list                     print the points of every configuration without running them\n"
+              << "  --trains n                 trains of a generated source (default 100)\n"
+              << "  --output-dir dir           keep the sink files here, named after the point (default: discard results)\n"
+              << "  --coordinator-config path  logical source schemas (default config/coordinator.yaml)\n"
+              << "  --worker-config path       physical CSV sources (default config/worker.yaml)\n"
+              << "  --data-dir dir             look up source files missing at their configured path here (default data)\n"
+              << "  --areas path               high-risk areas CSV (default data/high_risk_areas_ordered_unix.csv)"
+              << std::endl;
+}
+
+static SweepOptions parseOptions(int argc, char** argv) {
+    SweepOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--list") {
+            options.list = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + flag);
+        }
+        std::string value = argv[++i];
+        if (flag == "--config") {
+            options.configs.push_back(value);
+        } else if (flag == "--set") {
+            auto separator = value.find('=');
+            if (separator == std::string::npos || separator == 0) {
+                throw std::invalid_argument("--set expects name=values, got '" + value + "'");
+            }
+            options.overrides.emplace_back(value.substr(0, separator), value.substr(separator + 1));
+        } else if (flag == "--results") {
+            options.resultsPath = value;
+        } else if (flag == "--trains") {
+            options.trains = std::stoull(value);
+        } else if (flag == "--output-dir") {
+            options.outputDirectory = value;
+        } else if (flag == "--coordinator-config") {
+            options.coordinatorConfig = value;
+        } else if (flag == "--worker-config") {
+            options.workerConfig = value;
+        } else if (flag == "--data-dir") {
+            options.dataDirectory = value;
+        } else if (flag == "--areas") {
+            options.areasFile = value;
+        } else {
+            throw std::invalid_argument("unknown option " + flag);
+        }
+    }
+    if (options.configs.empty()) {
+        throw std::invalid_argument("--config is required");
+    }
+    if (options.trains == 0) {
+        throw std::invalid_argument("--trains must be positive");
+    }
+    return options;
+}
+
+/** @brief The swept parameters of a point, e.g. "numberOfWorkerThreads=2 bufferSizeInBytes=8192". */
+static std::string describe(const E2EConfig& config, const SweepPoint& point) {
+    std::string text;
+    for (const auto& [name, value] : point.values) {
+        for (const auto& parameter : config.getParameters()) {
+            if (parameter.name == name && parameter.values.size() > 1) {
+                text += (text.empty() ? "" : " ") + name + "=" + value;
+            }
+        }
+    }
+    return text.empty() ? "single point" : text;
+}
+
+/**
+ * @brief Applies the point to the catalog: bufferSizeInBytes, and generated `type: SNCB` sources of
+ * numberOfBuffersToProduce buffers each.
+ */
+static void configureSources(SourceCatalog& catalog, const E2EConfig& config, const SweepPoint& point, uint64_t trains) {
+    catalog.setBufferSizeInBytes(point.getUInt("bufferSizeInBytes", 4096));
+    for (const auto& source : config.getRoot()["logicalSources"].items()) {
+        if (source["type"].asString() != "SNCB") {
+            continue;
+        }
+        auto name = source["name"].asString();
+        auto generator = SncbGenerator::readE2EConfig(config.getPath(), name);
+        auto names = catalog.getLogicalSourceNames();
+        if (std::find(names.begin(), names.end(), name) == names.end()) {
+            catalog.addLogicalSource(name, *SncbGenerator::getSchema());
+            PhysicalSourceConfig physical;
+            physical.logicalSourceName = name;
+            physical.physicalSourceName = name;
+            catalog.addPhysicalSource(std::move(physical));
+        }
+        auto tuples = point.getUInt("numberOfBuffersToProduce", 1000) * catalog.getTuplesPerBuffer(name);
+        generator.trains = trains;
+        generator.samplesPerTrain = std::max<uint64_t>(1, (tuples + trains - 1) / trains);
+        // One thread per copy of the source, so numberOfSources sets the threads
+        generator.threads = 1;
+        catalog.setGenerator(name, generator);
+    }
+}
+
+/**
+ * @brief Runs numberOfSources copies of every query of the configuration, each on its own scan and thread,
+ * numberOfWorkerThreads of them executing at once. After startupSleepIntervalInSeconds it takes
+ * numberOfMeasurementsToCollect measurements of experimentMeasureIntervalInSeconds and stops the queries. If
+ * the sources run out first, the interval they end in is cut short and dropped, leaving fewer measurements.
+ * @throws std::invalid_argument or std::runtime_error if a query cannot be parsed, built or run
+ */
+static std::vector<Measurement> runPoint(const SweepOptions& options, const E2EConfig& config, const SweepPoint& point,
+                                         size_t pointIndex, const std::shared_ptr<const GeoContext>& geo, size_t& tuplesPerBuffer) {
+    auto catalog = SourceCatalog::fromYaml(options.coordinatorConfig, options.workerConfig, options.dataDirectory);
+    configureSources(catalog, config, point, options.trains);
+
+    auto copies = std::max<uint64_t>(1, point.getUInt("numberOfSources", 1));
+    std::vector<Query> queries;
+    for (const auto& text : config.getQueries()) {
+        auto query = parseQuery(text);
+        tuplesPerBuffer = catalog.getTuplesPerBuffer(query.getSourceName());
+        for (uint64_t copy = 0; copy < copies; ++copy) {
+            auto sink = *query.getSink();
+            if (options.outputDirectory.empty() || sink.filePath == "/dev/null") {
+                sink.filePath = "/dev/null";
+            } else {
+                fs::path file = sink.filePath;
+                auto name = file.stem().string() + "_p" + std::to_string(pointIndex)
+                    + (copies > 1 ? "_" + std::to_string(copy) : "") + file.extension().string();
+                sink.filePath = (fs::path(options.outputDirectory) / name).string();
+                fs::remove(sink.filePath);
+            }
+            queries.push_back(query);
+            queries.back().sink(FileSinkDescriptor::create(sink.filePath, sink.format, sink.append ? "APPEND" : "OVERWRITE"));
+        }
+    }
+
+    LocalEngine engine(std::move(catalog), geo);
+    engine.setWorkerThreads(point.getUInt("numberOfWorkerThreads", 0));
+    auto queryIds = engine.submitQueries(queries, false);
+
+    auto running = [&] {
+        return std::any_of(queryIds.begin(), queryIds.end(), [&](uint64_t id) { return engine.getQueryStatus(id) == QueryStatus::Running; });
+    };
+    // Tuples, results and process CPU time in microseconds so far
+    struct Counters {
+        uint64_t inputTuples = 0;
+        uint64_t outputTuples = 0;
+        uint64_t cpuUs = 0;
+        uint64_t rssKb = 0;
+    };
+    auto sample = [&] {
+        Counters counters;
+        for (auto id : queryIds) {
+            auto statistics = engine.getStatistics(id);
+            counters.inputTuples += statistics.inputTuples;
+            counters.outputTuples += statistics.outputTuples;
+        }
+        ResourceSample resources;
+        ResourceSampler::sample(getpid(), 0, resources);
+        counters.cpuUs = resources.userCpuUs + resources.systemCpuUs;
+        counters.rssKb = resources.rssKb;
+        return counters;
+    };
+    // Sleeps until the deadline or until all queries consumed their sources, whichever is first
+    auto waitUntil = [&](std::chrono::steady_clock::time_point deadline) {
+        while (running() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(std::chrono::milliseconds(20),
+                                                                                       deadline - std::chrono::steady_clock::now()));
+        }
+    };
+
+    auto startup = std::chrono::duration<double>(point.getDouble("startupSleepIntervalInSeconds", 0.0));
+    auto interval = std::chrono::duration<double>(point.getDouble("experimentMeasureIntervalInSeconds", 1.0));
+    auto measurementsToCollect = point.getUInt("numberOfMeasurementsToCollect", 5);
+    waitUntil(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(startup));
+
+    std::vector<Measurement> measurements;
+    auto previous = sample();
+    auto previousTime = std::chrono::steady_clock::now();
+    for (size_t index = 1; index <= measurementsToCollect && running(); ++index) {
+        auto deadline = previousTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval);
+        waitUntil(deadline);
+        auto current = sample();
+        auto now = std::chrono::steady_clock::now();
+        if (now < deadline) {
+            break;
+        }
+        double seconds = std::chrono::duration<double>(now - previousTime).count();
+        measurements.push_back({index, seconds, current.inputTuples - previous.inputTuples, current.outputTuples - previous.outputTuples,
+                                static_cast<double>(current.cpuUs - previous.cpuUs) / 1e4 / seconds,
+                                static_cast<double>(current.rssKb) / 1024.0});
+        previous = current;
+        previousTime = now;
+    }
+
+    for (auto id : queryIds) {
+        engine.stopQuery(id);
+        engine.waitForQuery(id);
+        if (engine.getQueryStatus(id) == QueryStatus::Failed) {
+            throw std::runtime_error("Query failed: " + engine.getError(id));
+        }
+    }
+    return measurements;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+    }
+
+    try {
+        auto options = parseOptions(argc, argv);
+        std::vector<E2EConfig> configs;
+        // Every parameter of any configuration is a column, in order of first appearance
+        std::vector<std::string> columns;
+        for (const auto& path : options.configs) {
+            auto config = E2EConfig::load(path);
+            for (const auto& [name, values] : options.overrides) {
+                config.setParameter(name, splitSweepValues(values));
+            }
+            for (const auto& parameter : config.getParameters()) {
+                if (parameter.values.size() > 1
+                    && std::find(appliedParameters.begin(), appliedParameters.end(), parameter.name) == appliedParameters.end()) {
+                    throw std::invalid_argument(path + " sweeps " + parameter.name
+                                                + ", which the local engine does not apply; fix it to a single value");
+                }
+                if (std::find(columns.begin(), columns.end(), parameter.name) == columns.end()) {
+                    columns.push_back(parameter.name);
+                }
+            }
+            configs.push_back(std::move(config));
+        }
+
+        if (options.list) {
+            for (const auto& config : configs) {
+                auto points = config.expand();
+                std::cout << config.getPath() << " (" << config.getBenchmarkName() << "): " << points.size() << " points" << std::endl;
+                for (size_t i = 0; i < points.size(); ++i) {
+                    std::cout << "  " << i + 1 << ": " << describe(config, points[i]) << std::endl;
+                }
+            }
+            return 0;
+        }
+
+        auto geo = std::make_shared<const GeoContext>(GeoContext::fromCsv(options.areasFile));
+        if (!options.outputDirectory.empty()) {
+            fs::create_directories(options.outputDirectory);
+        }
+        std::ofstream results(options.resultsPath, std::ios::trunc);
+        if (!results) {
+            throw std::runtime_error("Cannot open " + options.resultsPath);
+        }
+        results << "benchmark,config,point";
+        for (const auto& column : columns) {
+            results << ',' << column;
+        }
+        results << ",tuples_per_buffer,measurement,seconds,input_tuples,output_tuples,tuples_per_second,results_per_second,cpu_percent,rss_mb"
+                << std::endl;
+
+        bool success = true;
+        for (const auto& config : configs) {
+            auto points = config.expand();
+            for (size_t i = 0; i < points.size(); ++i) {
+                const auto& point = points[i];
+                std::cout << config.getBenchmarkName() << " [" << i + 1 << "/" << points.size() << "] " << describe(config, point)
+                          << ": " << std::flush;
+                std::vector<Measurement> measurements;
+                size_t tuplesPerBuffer = 0;
+                try {
+                    measurements = runPoint(options, config, point, i + 1, geo, tuplesPerBuffer);
+                } catch (const std::exception& e) {
+                    std::cout << "failed: " << e.what() << std::endl;
+                    success = false;
+                    continue;
+                }
+
+                std::vector<double> throughputs;
+                for (const auto& measurement : measurements) {
+                    double tuplesPerSecond = measurement.inputTuples / measurement.seconds;
+                    throughputs.push_back(tuplesPerSecond);
+                    results << config.getBenchmarkName() << ',' << config.getPath() << ',' << i + 1;
+                    for (const auto& column : columns) {
+                        results << ',';
+                        for (const auto& [name, value] : point.values) {
+                            if (name == column) {
+                                results << value;
+                            }
+                        }
+                    }
+                    results << ',' << tuplesPerBuffer << ',' << measurement.index << std::fixed << std::setprecision(3) << ','
+                            << measurement.seconds << ',' << measurement.inputTuples << ',' << measurement.outputTuples << ','
+                            << std::setprecision(0) << tuplesPerSecond << ',' << measurement.outputTuples / measurement.seconds << ','
+                            << std::setprecision(1) << measurement.cpuPercent << ',' << measurement.rssMb << std::defaultfloat
+                            << '\n';
+                }
+                results.flush();
+                if (measurements.empty()) {
+                    std::cout << "no measurements, the sources ran out before the first interval ended; raise numberOfBuffersToProduce"
+                              << std::endl;
+                    continue;
+                }
+                auto summary = summarize(throughputs);
+                std::cout << std::fixed << std::setprecision(0) << "median " << summary.median << " tuples/s (min " << summary.min
+                          << ", max " << summary.max << ") over " << summary.count << " measurements" << std::defaultfloat << std::endl;
+            }
+        }
+        std::cout << "Results written to " << options.resultsPath << std::endl;
+        return success ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,263 @@
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Bench/Statistics.hpp>
+#include <Engine/FusedPipeline.hpp>
+#include <Engine/LocalEngine.hpp>
+#include <Engine/Query.hpp>
+#include <Engine/SncbGenerator.hpp>
+#include <Engine/SncbQueries.hpp>
+
+using namespace SNCB::Engine;
+namespace fs = std::filesystem;
+
+struct FusedBenchmarkOptions {
+    std::string e2eConfig = "config/sncb_query5_e2e.yaml";
+    SncbGeneratorConfig generator;
+    size_t tuplesPerBuffer = 1024;
+    int repetitions = 5;
+};
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "Runs query5 on synthetic trains held in memory, once with the interpreted operators of the LocalEngine\n"
+              << "and once with its maps and filters fused into one loop by Engine/FusedPipeline.hpp, both followed by\n"
+              << "the same window, and checks that both give the same windows and that leaving out dead maps changes\n"
+              << "no result.\n"
+              << "  --config path              e2e configuration with the bounds (default config/sncb_query5_e2e.yaml)\n"
+              << "  --trains n                 trains reporting at every sample (default 200)\n"
+              << "  --samples n                samples per train, one per second (default 3600)\n"
+              << "  --buffer-tuples n          tuples per buffer (default 1024)\n"
+              << "  --repetitions n            measured runs per variant (default 5)" << std::endl;
+}
+
+static uint64_t parseNumber(const std::string& flag, const std::string& value) {
+    try {
+        size_t consumed = 0;
+        auto parsed = std::stoull(value, &consumed);
+        if (consumed == value.size() && parsed > 0) {
+            return parsed;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument(flag + " expects a positive integer, got '" + value + "'");
+}
+
+static FusedBenchmarkOptions parseOptions(int argc, char** argv) {
+    FusedBenchmarkOptions options;
+    options.generator.trains = 200;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + flag);
+        }
+        std::string value = argv[++i];
+        if (flag == "--config") {
+            options.e2eConfig = value;
+        } else if (flag == "--trains") {
+            options.generator.trains = parseNumber(flag, value);
+        } else if (flag == "--samples") {
+            options.generator.samplesPerTrain = parseNumber(flag, value);
+        } else if (flag == "--buffer-tuples") {
+            options.tuplesPerBuffer = parseNumber(flag, value);
+        } else if (flag == "--repetitions") {
+            options.repetitions = static_cast<int>(parseNumber(flag, value));
+        } else {
+            throw std::invalid_argument("unknown option " + flag);
+        }
+    }
+    auto bounds = SncbGenerator::readE2EConfig(options.e2eConfig);
+    bounds.trains = options.generator.trains;
+    bounds.samplesPerTrain = options.generator.samplesPerTrain;
+    options.generator = bounds;
+    return options;
+}
+
+/** @brief Maps and filters of query5 (SncbQueries.cpp); adjusted_temp and adjusted_light are dead. */
+static auto query5Plan() {
+    using Fused::Attribute;
+    auto passengerCount = (Attribute<"T1_bar", BasicType::FLOAT64>() + Attribute<"T2_bar", BasicType::FLOAT64>()
+                           + Attribute<"PCF1_bar", BasicType::FLOAT64>() + Attribute<"PCF2_bar", BasicType::FLOAT64>())
+        / 4.0;
+    return Fused::from()
+        .map<"passenger_count">(passengerCount)
+        .filter(Attribute<"passenger_count">() > 3.15)
+        .filter(Fused::tpointatstbox(Attribute<"longitude", BasicType::FLOAT64>(), Attribute<"latitude", BasicType::FLOAT64>(),
+                                     Attribute<"timestamp", BasicType::UINT64>())
+                        == 1
+                && Attribute<"speed", BasicType::FLOAT64>() > -1)
+        .map<"adjusted_temp">(20.0)
+        .map<"adjusted_light">(80.0)
+        .project<"timestamp", "speed">();
+}
+
+/** @brief The window of query5 on the fields the fused plan writes. */
+static Query query5Window(const std::string& sinkPath) {
+    return Query::from("sncb")
+        .window(TumblingWindow::of(EventTime(Attribute("timestamp")), Milliseconds(500)))
+        .apply(Avg(Attribute("speed")))
+        .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+}
+
+static std::unique_ptr<ExecutableOperator> interpreted(const SchemaPtr& schema, const GeoContext& geo, size_t capacity,
+                                                       const std::string& sinkPath) {
+    return LocalEngine::compile(findSncbQueries("Query5").front().build(sinkPath), schema, &geo, capacity);
+}
+
+static std::unique_ptr<ExecutableOperator> fused(const SchemaPtr& schema, const GeoContext& geo, size_t capacity,
+                                                 const std::string& sinkPath) {
+    auto pipeline = query5Plan().compile(schema, &geo, capacity);
+    pipeline->setNext(LocalEngine::compile(query5Window(sinkPath), pipeline->getOutputSchema(), &geo, capacity));
+    return pipeline;
+}
+
+/**
+ * @brief Copies every buffer into the one the pipeline reads before running it, as a source fills its buffer, so the
+ * pipelines read from the cache and not from the input held in memory; only the pipeline is timed.
+ * @return nanoseconds in the pipeline
+ */
+static double run(ExecutableOperator& pipeline, const std::vector<TupleBuffer>& input) {
+    double nanos = 0;
+    TupleBuffer current(input.front().getSchema(), input.front().getCapacity());
+    for (const auto& buffer : input) {
+        current = buffer;
+        auto start = std::chrono::steady_clock::now();
+        pipeline.execute(current);
+        nanos += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    auto start = std::chrono::steady_clock::now();
+    pipeline.finish();
+    return nanos + std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::string readFile(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+/**
+ * @brief Runs each query compiled with and without dead maps left out on the same generated trains and checks
+ * that both write the same file: query5, whose adjusted_temp and adjusted_light are dropped, a query whose first
+ * map creates a field that a map of another type overwrites, which must keep the type of the first, and one where
+ * a map appends another field before the overwriting map, which must keep the column of the first.
+ */
+static void checkDeadMaps(const SncbGeneratorConfig& generatorConfig, const GeoContext& geo, size_t capacity) {
+    std::vector<std::pair<std::string, std::function<Query(const std::string&)>>> queries{
+        {"query5", [](const std::string& sinkPath) { return findSncbQueries("Query5").front().build(sinkPath); }},
+        {"the overwritten map", [](const std::string& sinkPath) {
+            return Query::from("sncb")
+                .map(Attribute("code") = Attribute("Code1"))
+                .map(Attribute("code") = Attribute("speed") * 0.5)
+                .project(Attribute("timestamp"), Attribute("code"))
+                .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+        }},
+        {"the map overwritten after another field", [](const std::string& sinkPath) {
+            return Query::from("sncb")
+                .map(Attribute("code") = Attribute("Code1"))
+                .map(Attribute("other") = Attribute("Code2"))
+                .map(Attribute("code") = Attribute("Code2") + 1)
+                .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+        }}};
+    for (const auto& [name, build] : queries) {
+        // Without dropping, the query reads the fields of every map, which the dropping variant reads too
+        auto schema = LocalEngine::getReadSchema(build("/dev/null"), SncbGenerator::getSchema(), false);
+        std::vector<std::string> outputs;
+        for (bool dropDeadMaps : {true, false}) {
+            auto path = fs::temp_directory_path() / "fused_pipeline_benchmark_dead_maps.csv";
+            fs::remove(path);
+            auto pipeline = LocalEngine::compile(build(path.string()), schema, &geo, capacity, nullptr, dropDeadMaps);
+            SncbGenerator generator(generatorConfig, schema);
+            for (TupleBuffer buffer(schema, capacity); generator.fillBuffer(buffer);) {
+                pipeline->execute(buffer);
+            }
+            pipeline->finish();
+            pipeline.reset();
+            outputs.push_back(readFile(path));
+            fs::remove(path);
+        }
+        if (outputs.front() != outputs.back()) {
+            throw std::runtime_error("leaving out dead maps changed the results of " + name);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+    }
+
+    try {
+        auto options = parseOptions(argc, argv);
+        // tpointatstbox only needs the box, which defaults to the one of the clients
+        GeoContext geo;
+        auto schema = LocalEngine::getReadSchema(findSncbQueries("Query5").front().build("/dev/null"), SncbGenerator::getSchema());
+        SncbGenerator generator(options.generator, schema);
+        std::vector<TupleBuffer> input;
+        for (TupleBuffer buffer(schema, options.tuplesPerBuffer); generator.fillBuffer(buffer);) {
+            input.push_back(buffer);
+        }
+        auto tuples = generator.getProducedTuples();
+        checkDeadMaps(options.generator, geo, options.tuplesPerBuffer);
+
+        // Both variants once into files, whose windows must be equal
+        auto interpretedPath = fs::temp_directory_path() / "fused_pipeline_benchmark_interpreted.csv";
+        auto fusedPath = fs::temp_directory_path() / "fused_pipeline_benchmark_fused.csv";
+        fs::remove(interpretedPath);
+        fs::remove(fusedPath);
+        run(*interpreted(schema, geo, options.tuplesPerBuffer, interpretedPath.string()), input);
+        run(*fused(schema, geo, options.tuplesPerBuffer, fusedPath.string()), input);
+        bool equal = readFile(interpretedPath) == readFile(fusedPath);
+        fs::remove(interpretedPath);
+        fs::remove(fusedPath);
+        if (!equal) {
+            throw std::runtime_error("the fused pipeline gave other windows than the interpreted one");
+        }
+
+        using Plan = decltype(query5Plan().compile(schema, &geo, 1))::element_type;
+        std::cout << "=== Fused Pipeline Benchmark: query5 on " << tuples << " tuples, " << Plan::numberOfLiveMaps() << " of "
+                  << Plan::numberOfMaps() << " maps live after fusing ===" << std::endl;
+        double interpretedMedian = 0;
+        for (bool fuse : {false, true}) {
+            std::vector<double> nanosPerTuple;
+            // The first run warms caches and the allocator and is not measured
+            for (int run = 0; run <= options.repetitions; ++run) {
+                auto pipeline = fuse ? fused(schema, geo, options.tuplesPerBuffer, "/dev/null")
+                                     : interpreted(schema, geo, options.tuplesPerBuffer, "/dev/null");
+                auto elapsed = ::run(*pipeline, input);
+                if (run > 0) {
+                    nanosPerTuple.push_back(elapsed / static_cast<double>(tuples));
+                }
+            }
+
+            auto summary = SNCB::Bench::summarize(nanosPerTuple);
+            std::cout << std::fixed << std::setprecision(1) << (fuse ? "fused:       " : "interpreted: ") << "median "
+                      << summary.median << " ns/tuple (p95 " << summary.p95 << ", stddev " << summary.stddev << "), "
+                      << std::setprecision(0) << 1e9 / summary.median << " tuples/s";
+            if (fuse) {
+                std::cout << std::setprecision(2) << ", " << interpretedMedian / summary.median << "x";
+            } else {
+                interpretedMedian = summary.median;
+            }
+            std::cout << std::endl;
+        }
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Engine/ColumnarFile.hpp>
+#include <Engine/SncbGenerator.hpp>
+
+using namespace SNCB::Engine;
+namespace fs = std::filesystem;
+
+struct GenerateOptions {
+    std::string e2eConfig = "config/sncb_query6_e2e.yaml";
+    std::string source = "sncb";
+    // Written as a columnar file if it ends in .sncbcol, as CSV otherwise
+    std::string output;
+    SncbGeneratorConfig generator;
+    // 0 takes one sample per second of the time unit
+    uint64_t sampleInterval = 0;
+    bool startSet = false;
+    size_t rowsPerBlock = 262144;
+    size_t rowsPerChunk = 65536;
+};
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " --output path [options]\n"
+              << "Generates synthetic SNCB train data within the bounds of a `type: SNCB` source of an e2e configuration.\n"
+              << "The output is CSV with the sncb schema of coordinator.yaml, or a columnar file for LocalQuery --columnar\n"
+              << "if the path ends in .sncbcol. The rows only depend on the options, not on the number of threads.\n"
+              << "  --output path              CSV or .sncbcol file to write\n"
+              << "  --config path              e2e configuration with the bounds (default config/sncb_query6_e2e.yaml)\n"
+              << "  --source name              logical source of the configuration (default sncb)\n"
+              << "  --trains n                 trains reporting at every sample (default 100)\n"
+              << "  --samples n                samples per train (default 3600)\n"
+              << "  --time-unit ms|s           unit of the timestamps (default ms)\n"
+              << "  --interval n               time units between two samples of a train (default: one second)\n"
+              << "  --start timestamp          timestamp of the first sample (default 1719784681 s in the time unit)\n"
+              << "  --cfa-spikes p             probability per sample that a CFA pressure spike starts (default 0.002)\n"
+              << "  --alarms p                 probability per sample that an alarm code burst starts (default 0.001)\n"
+              << "  --seed n                   seed of the trains (default 1)\n"
+              << "  --threads n                threads generating and formatting rows (default: one per core)\n"
+              << "  --rows-per-chunk n         rows per chunk of a columnar file (default 65536)" << std::endl;
+}
+
+static double parseNumber(const std::string& flag, const std::string& value) {
+    try {
+        size_t consumed = 0;
+        double parsed = std::stod(value, &consumed);
+        if (consumed == value.size() && parsed >= 0) {
+            return parsed;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument(flag + " expects a non-negative number, got '" + value + "'");
+}
+
+static GenerateOptions parseOptions(int argc, char** argv) {
+    GenerateOptions options;
+    std::string timeUnit = "ms";
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + flag);
+        }
+        std::string value = argv[++i];
+        if (flag == "--output") {
+            options.output = value;
+        } else if (flag == "--config") {
+            options.e2eConfig = value;
+        } else if (flag == "--source") {
+            options.source = value;
+        } else if (flag == "--trains") {
+            options.generator.trains = static_cast<uint64_t>(parseNumber(flag, value));
+        } else if (flag == "--samples") {
+            options.generator.samplesPerTrain = static_cast<uint64_t>(parseNumber(flag, value));
+        } else if (flag == "--time-unit") {
+            if (value != "ms" && value != "s") {
+                throw std::invalid_argument("--time-unit expects ms or s, got '" + value + "'");
+            }
+            timeUnit = value;
+        } else if (flag == "--interval") {
+            options.sampleInterval = static_cast<uint64_t>(parseNumber(flag, value));
+        } else if (flag == "--start") {
+            options.generator.startTimestamp = std::stoull(value);
+            options.startSet = true;
+        } else if (flag == "--cfa-spikes") {
+            options.generator.cfaSpikeProbability = parseNumber(flag, value);
+        } else if (flag == "--alarms") {
+            options.generator.alarmProbability = parseNumber(flag, value);
+        } else if (flag == "--seed") {
+            options.generator.seed = static_cast<uint64_t>(parseNumber(flag, value));
+        } else if (flag == "--threads") {
+            options.generator.threads = static_cast<size_t>(parseNumber(flag, value));
+        } else if (flag == "--rows-per-chunk") {
+            options.rowsPerChunk = static_cast<size_t>(parseNumber(flag, value));
+        } else {
+            throw std::invalid_argument("unknown option " + flag);
+        }
+    }
+    if (options.output.empty()) {
+        throw std::invalid_argument("--output is required");
+    }
+    options.generator.timeUnitsPerSecond = timeUnit == "ms" ? 1000.0 : 1.0;
+    if (options.sampleInterval == 0) {
+        options.sampleInterval = timeUnit == "ms" ? 1000 : 1;
+    }
+    if (!options.startSet && timeUnit == "s") {
+        options.generator.startTimestamp /= 1000;
+    }
+    return options;
+}
+
+/** @brief Appends rows [begin, end) of the buffer as CSV lines, numbers in their shortest exact form. */
+static void formatRows(const TupleBuffer& buffer, size_t begin, size_t end, std::string& text) {
+    const auto& schema = *buffer.getSchema();
+    char number[32];
+    for (size_t row = begin; row < end; ++row) {
+        for (size_t field = 0; field < schema.size(); ++field) {
+            auto result = schema.getField(field).type == DataType::FLOAT64
+                ? std::to_chars(number, number + sizeof(number), buffer.getDouble(row, field))
+                : std::to_chars(number, number + sizeof(number), buffer.getUInt(row, field));
+            text.append(number, result.ptr);
+            text.push_back(field + 1 < schema.size() ? ',' : '\n');
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+    }
+
+    try {
+        auto options = parseOptions(argc, argv);
+        auto generatorConfig = SncbGenerator::readE2EConfig(options.e2eConfig, options.source);
+        generatorConfig.trains = options.generator.trains;
+        generatorConfig.samplesPerTrain = options.generator.samplesPerTrain;
+        generatorConfig.startTimestamp = options.generator.startTimestamp;
+        generatorConfig.sampleInterval = options.sampleInterval;
+        generatorConfig.timeUnitsPerSecond = options.generator.timeUnitsPerSecond;
+        generatorConfig.cfaSpikeProbability = options.generator.cfaSpikeProbability;
+        generatorConfig.alarmProbability = options.generator.alarmProbability;
+        generatorConfig.seed = options.generator.seed;
+        generatorConfig.threads = options.generator.threads;
+
+        auto schema = SncbGenerator::getSchema();
+        SncbGenerator generator(generatorConfig, schema);
+        size_t threads = generatorConfig.threads > 0 ? generatorConfig.threads : std::max(1U, std::thread::hardware_concurrency());
+        std::cout << "Generating " << generatorConfig.trains << " trains x " << generatorConfig.samplesPerTrain << " samples, speed "
+                  << generatorConfig.minSpeed << "-" << generatorConfig.maxSpeed << ", longitude " << generatorConfig.minLongitude << "-"
+                  << generatorConfig.maxLongitude << ", latitude " << generatorConfig.minLatitude << "-" << generatorConfig.maxLatitude
+                  << " on " << threads << " threads" << std::endl;
+
+        auto start = std::chrono::steady_clock::now();
+        TupleBuffer buffer(schema, options.rowsPerBlock);
+        if (fs::path(options.output).extension() == ".sncbcol") {
+            ColumnarFileWriter writer(options.output, schema, options.rowsPerChunk, "timestamp");
+            while (generator.fillBuffer(buffer)) {
+                writer.write(buffer);
+            }
+            writer.finish();
+        } else {
+            std::ofstream file(options.output, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                throw std::runtime_error("Cannot open " + options.output);
+            }
+            std::string header;
+            for (const auto& field : schema->getFields()) {
+                header += (header.empty() ? "" : ",") + field.name;
+            }
+            file << header << '\n';
+            // Every thread formats a contiguous part of the block; the parts are written in order
+            std::vector<std::string> parts(threads);
+            while (generator.fillBuffer(buffer)) {
+                auto rows = buffer.getNumberOfTuples();
+                std::vector<std::thread> formatters;
+                for (size_t part = 0; part < threads; ++part) {
+                    parts[part].clear();
+                    formatters.emplace_back([&, part] { formatRows(buffer, rows * part / threads, rows * (part + 1) / threads, parts[part]); });
+                }
+                for (size_t part = 0; part < threads; ++part) {
+                    formatters[part].join();
+                    file.write(parts[part].data(), static_cast<std::streamsize>(parts[part].size()));
+                }
+            }
+            if (!file.flush()) {
+                throw std::runtime_error("Cannot write " + options.output);
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        auto bytes = fs::file_size(options.output);
+        std::cout << options.output << ": " << generator.getProducedTuples() << " rows, " << bytes << " bytes in " << std::fixed
+                  << std::setprecision(3) << seconds << " s (" << std::setprecision(0) << generator.getProducedTuples() / seconds
+                  << " rows/s, " << std::setprecision(1) << bytes / seconds / 1e6 << " MB/s)" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
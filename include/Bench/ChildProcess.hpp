@@ -0,0 +1,55 @@
+#ifndef SNCB_BENCH_CHILDPROCESS_HPP_
+#define SNCB_BENCH_CHILDPROCESS_HPP_
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace SNCB::Bench {
+
+/**
+ * @brief A program started with fork/exec by a benchmark harness, e.g. a query driver, a worker or a
+ * coordinator. The process is terminated when the object goes out of scope.
+ */
+class ChildProcess {
+  public:
+    /**
+     * @brief Starts argv[0] with the given arguments, looked up in PATH like execvp.
+     * @param logFile if not empty, stdout and stderr of the child are appended to this file
+     * @throws std::runtime_error if the process cannot be forked
+     */
+    static ChildProcess spawn(const std::vector<std::string>& argv, const std::string& logFile = "");
+
+    /** @brief Runs a command line through /bin/sh -c, for user-supplied coordinator and worker commands. */
+    static ChildProcess spawnShell(const std::string& command, const std::string& logFile = "");
+
+    ~ChildProcess();
+    ChildProcess(ChildProcess&& other) noexcept;
+    ChildProcess& operator=(ChildProcess&& other) noexcept;
+    ChildProcess(const ChildProcess&) = delete;
+    ChildProcess& operator=(const ChildProcess&) = delete;
+
+    /**
+     * @brief Waits for the process to exit.
+     * @return the exit code (128 + signal for a killed process), or nothing if the timeout passed first
+     */
+    std::optional<int> wait(std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+    /** @brief Sends SIGTERM, waits for the grace period and sends SIGKILL if the process is still alive. */
+    int terminate(std::chrono::milliseconds grace = std::chrono::seconds(5));
+
+    bool isRunning();
+    pid_t getPid() const;
+
+  private:
+    explicit ChildProcess(pid_t pid);
+
+    pid_t pid = -1;
+    std::optional<int> exitCode;
+};
+
+}// namespace SNCB::Bench
+
+#endif// SNCB_BENCH_CHILDPROCESS_HPP_
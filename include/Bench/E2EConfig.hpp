@@ -0,0 +1,72 @@
+#ifndef SNCB_BENCH_E2ECONFIG_HPP_
+#define SNCB_BENCH_E2ECONFIG_HPP_
+
+#include <Util/YamlLite.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SNCB::Bench {
+
+/** @brief A numeric top-level entry of an e2e configuration and its values, e.g. numberOfWorkerThreads: 1,2. */
+struct SweepParameter {
+    std::string name;
+    std::vector<std::string> values;
+};
+
+/** @brief One value for every parameter of a configuration, in the order of the configuration. */
+struct SweepPoint {
+    std::vector<std::pair<std::string, std::string>> values;
+
+    bool has(const std::string& name) const;
+    /** @brief Value of a parameter, fallback if the point has no such parameter. */
+    uint64_t getUInt(const std::string& name, uint64_t fallback) const;
+    double getDouble(const std::string& name, double fallback) const;
+};
+
+/**
+ * @brief Benchmark configuration in the format of the NES e2e benchmark runner (config/sncb_query*_e2e.yaml):
+ * every top-level entry that is a number or a comma-separated list of numbers is a parameter, and a run is
+ * made for every combination of their values.
+ */
+class E2EConfig {
+  public:
+    /** @throws std::runtime_error or std::invalid_argument if the file cannot be read or has no query */
+    static E2EConfig load(const std::string& path);
+
+    const std::string& getPath() const;
+    const std::string& getBenchmarkName() const;
+    /** @brief Source text of the `query` entry or of the queries of `querySet`. */
+    const std::vector<std::string>& getQueries() const;
+    const Util::YamlNode& getRoot() const;
+
+    /** @brief Parameters in file order; those with more than one value are swept. */
+    const std::vector<SweepParameter>& getParameters() const;
+    /**
+     * @brief Replaces the values of a parameter, or adds it, e.g. to sweep a value the file fixes.
+     * @throws std::invalid_argument if a value is not a number
+     */
+    void setParameter(const std::string& name, const std::vector<std::string>& values);
+
+    /** @brief Cartesian product of the parameter values; the first parameter in file order varies slowest. */
+    std::vector<SweepPoint> expand() const;
+
+  private:
+    std::string path;
+    std::string benchmarkName;
+    std::vector<std::string> queries;
+    Util::YamlNode root;
+    std::vector<SweepParameter> parameters;
+};
+
+/** @brief Items of a comma-separated list, trimmed, e.g. "1, 2" gives "1" and "2". */
+std::vector<std::string> splitSweepValues(const std::string& value);
+
+/** @brief True if the text is a non-empty decimal number, as accepted for sweep values. */
+bool isSweepNumber(const std::string& value);
+
+}// namespace SNCB::Bench
+
+#endif// SNCB_BENCH_E2ECONFIG_HPP_
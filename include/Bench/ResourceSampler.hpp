@@ -0,0 +1,126 @@
+#ifndef SNCB_BENCH_RESOURCESAMPLER_HPP_
+#define SNCB_BENCH_RESOURCESAMPLER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+#include <vector>
+
+namespace SNCB::Bench {
+
+/** @brief Resource usage of one process, or of one of its threads, at one point in time. */
+struct ResourceSample {
+    // Time since the sampler was started
+    std::chrono::microseconds elapsed{0};
+    std::string process;
+    pid_t pid = 0;
+    // 0 for the process as a whole, otherwise the thread the counters belong to
+    pid_t tid = 0;
+    std::string threadName;
+    uint64_t rssKb = 0;
+    uint64_t minorFaults = 0;
+    uint64_t majorFaults = 0;
+    uint64_t voluntaryContextSwitches = 0;
+    uint64_t involuntaryContextSwitches = 0;
+    uint64_t userCpuUs = 0;
+    uint64_t systemCpuUs = 0;
+    uint64_t threads = 0;
+    // Bytes passed through read/write calls and bytes that actually hit storage
+    uint64_t readChars = 0;
+    uint64_t writeChars = 0;
+    uint64_t readBytes = 0;
+    uint64_t writeBytes = 0;
+    // Value of the progress probe at this sample, e.g. the records in the sink so far
+    uint64_t progress = 0;
+};
+
+/** @brief Peak and mean resource usage of one process over its process-level samples. */
+struct ResourceSummary {
+    uint64_t maxRssKb = 0;
+    double averageRssKb = 0.0;
+    // User plus system CPU time between the first and last sample; 100 % is one busy core. Peaks are taken
+    // over spans of ResourceSampler::PeakSpan, as CPU time only advances in clock ticks of 10 ms
+    double cpuSeconds = 0.0;
+    double averageCpuPercent = 0.0;
+    double maxCpuPercent = 0.0;
+    // Bytes passed through read and write calls per second, mean and peak
+    double averageReadKbPerSecond = 0.0;
+    double maxReadKbPerSecond = 0.0;
+    double averageWriteKbPerSecond = 0.0;
+    double maxWriteKbPerSecond = 0.0;
+};
+
+/**
+ * @brief Background thread that samples /proc/<pid>/{stat,status,io} of a set of processes at a
+ * fixed interval, optionally with one sample per thread from /proc/<pid>/task. Replaces external
+ * memory logging scripts so that memory and CPU can be put next to the throughput of the same run.
+ */
+class ResourceSampler {
+  public:
+    static constexpr std::chrono::milliseconds PeakSpan{100};
+
+    /**
+     * @param interval time between two samples; sampling itself takes a few microseconds per file
+     * @param perThread also sample user and system CPU time and context switches of every thread
+     */
+    explicit ResourceSampler(std::chrono::microseconds interval, bool perThread = false);
+    ~ResourceSampler();
+
+    ResourceSampler(const ResourceSampler&) = delete;
+    ResourceSampler& operator=(const ResourceSampler&) = delete;
+
+    /** @brief Adds a process to sample under the given label. Must be called before start(). */
+    void watch(pid_t pid, std::string process);
+
+    /** @brief Called on every tick, its value is stored in ResourceSample::progress. Must be thread safe. */
+    void setProgressProbe(std::function<uint64_t()> probe);
+
+    void start();
+
+    /** @brief Stops the sampling thread after taking one last sample. */
+    void stop();
+
+    /** @brief Samples taken so far; only valid after stop(). */
+    const std::vector<ResourceSample>& getSamples() const;
+
+    /** @brief Peak and mean RSS, CPU and I/O of a process; all zero if it was never sampled. */
+    ResourceSummary getSummary(const std::string& process) const;
+
+    static void writeCsvHeader(std::ostream& out);
+
+    /** @brief Writes every sample as one CSV row, prefixed with the given run label. */
+    void writeCsv(std::ostream& out, const std::string& run) const;
+
+    /** @brief Reads the counters of one process or thread once, returns false if it does not exist anymore. */
+    static bool sample(pid_t pid, pid_t tid, ResourceSample& sample);
+
+  private:
+    struct Target {
+        pid_t pid;
+        std::string process;
+    };
+
+    void run();
+    void sampleAll(std::chrono::steady_clock::time_point now);
+
+    std::chrono::microseconds interval;
+    bool perThread;
+    std::vector<Target> targets;
+    std::function<uint64_t()> progressProbe;
+    std::vector<ResourceSample> samples;
+    std::chrono::steady_clock::time_point startTime;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable stopRequested;
+    bool stopping = false;
+};
+
+}// namespace SNCB::Bench
+
+#endif// SNCB_BENCH_RESOURCESAMPLER_HPP_
@@ -0,0 +1,60 @@
+#ifndef SNCB_BENCH_SINKTAILREADER_HPP_
+#define SNCB_BENCH_SINKTAILREADER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SNCB::Bench {
+
+/**
+ * @brief Counts the records a query appends to its CSV sink without rescanning the file. Each poll
+ * reads only the bytes appended since the previous one, in large pread blocks, and counts their
+ * newlines with a vectorized scan. A trailing partial line is counted once its newline arrives.
+ */
+class SinkTailReader {
+  public:
+    /**
+     * @param path sink file, it does not need to exist yet
+     * @param startOffset bytes at the start of the file that are not counted, e.g. output of earlier runs
+     * @param skipHeader do not count the first line if reading starts at the beginning of the file
+     */
+    explicit SinkTailReader(std::string path, uint64_t startOffset = 0, bool skipHeader = false, size_t blockSize = 1 << 20);
+    ~SinkTailReader();
+
+    SinkTailReader(const SinkTailReader&) = delete;
+    SinkTailReader& operator=(const SinkTailReader&) = delete;
+    SinkTailReader(SinkTailReader&& other) noexcept;
+    SinkTailReader& operator=(SinkTailReader&& other) noexcept;
+
+    /** @brief Starts counting at the current end of the file, ignoring everything written so far. */
+    static SinkTailReader fromEnd(std::string path, bool skipHeader = false);
+
+    /**
+     * @brief Reads what was appended since the last poll. If the file shrank it was recreated and is
+     * read again from its beginning, keeping the records counted so far.
+     * @return number of records completed by this poll
+     */
+    uint64_t poll();
+
+    uint64_t getRecords() const;
+    uint64_t getOffset() const;
+    const std::string& getPath() const;
+
+  private:
+    bool open();
+    void close();
+
+    std::string path;
+    int fd = -1;
+    uint64_t offset;
+    uint64_t records = 0;
+    bool skipHeader;
+    bool headerPending;
+    std::vector<char> block;
+};
+
+}// namespace SNCB::Bench
+
+#endif// SNCB_BENCH_SINKTAILREADER_HPP_
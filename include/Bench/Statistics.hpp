@@ -0,0 +1,31 @@
+#ifndef SNCB_BENCH_STATISTICS_HPP_
+#define SNCB_BENCH_STATISTICS_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace SNCB::Bench {
+
+/** @brief Summary of repeated measurements of one metric. */
+struct Summary {
+    size_t count = 0;
+    double mean = 0.0;
+    double median = 0.0;
+    double p95 = 0.0;
+    double stddev = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * @brief Summarizes a set of measurements. Percentiles interpolate linearly between the closest
+ * ranks; stddev is the sample standard deviation.
+ */
+Summary summarize(std::vector<double> values);
+
+/** @brief Percentile in [0, 100] of already sorted values. */
+double percentile(const std::vector<double>& sortedValues, double percent);
+
+}// namespace SNCB::Bench
+
+#endif// SNCB_BENCH_STATISTICS_HPP_
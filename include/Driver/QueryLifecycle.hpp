@@ -0,0 +1,96 @@
+#ifndef SNCB_DRIVER_QUERYLIFECYCLE_HPP_
+#define SNCB_DRIVER_QUERYLIFECYCLE_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SNCB::Driver {
+
+/** @brief How a driver decides that a query has run long enough. */
+enum class LifecycleMode : uint8_t {
+    // Sleep for the configured duration, then stop
+    FixedDuration,
+    // Poll until the query is terminal or its sink stopped growing; the duration only caps the run
+    Completion
+};
+
+LifecycleMode parseLifecycleMode(const std::string& name);
+std::string toString(LifecycleMode mode);
+
+/** @brief Coarse query state as reported by the coordinator's query-status endpoint. */
+enum class QueryState : uint8_t { Unknown, Pending, Running, Stopped, Failed };
+
+/**
+ * @brief Extracts the state from a RemoteClient::getQueryStatus response. Accepts the raw status name
+ * as well as a JSON document with a "queryStatus" or "status" member.
+ */
+QueryState parseQueryState(const std::string& statusResponse);
+bool isTerminal(QueryState state);
+std::string toString(QueryState state);
+
+/** @brief Why CompletionMonitor::waitForCompletion returned. */
+enum class CompletionReason : uint8_t { Terminal, SinkIdle, Timeout };
+std::string toString(CompletionReason reason);
+
+struct CompletionSettings {
+    // Upper bound of the run, also in completion mode
+    std::chrono::milliseconds timeout = std::chrono::seconds(20);
+    // Sinks are checked every initialPollInterval; status polling starts there and doubles up to
+    // maxPollInterval while the state does not change
+    std::chrono::milliseconds initialPollInterval = std::chrono::milliseconds(50);
+    std::chrono::milliseconds maxPollInterval = std::chrono::seconds(2);
+    // The run ends once no sink grew for idleIntervals consecutive idleInterval periods after the first result
+    std::chrono::milliseconds idleInterval = std::chrono::seconds(1);
+    uint32_t idleIntervals = 5;
+};
+
+/** @brief Timings of one query, measured from its submission. */
+struct QueryProgress {
+    QueryState state = QueryState::Unknown;
+    uint64_t initialSinkBytes = 0;
+    uint64_t sinkBytes = 0;
+    std::optional<std::chrono::milliseconds> timeToFirstResult;
+    std::optional<std::chrono::milliseconds> timeOfLastResult;
+
+    // Time between the first and the last observed growth of the sink
+    std::optional<std::chrono::milliseconds> timeToDrain() const;
+};
+
+struct CompletionReport {
+    CompletionReason reason = CompletionReason::Timeout;
+    std::chrono::milliseconds elapsed{0};
+    std::vector<QueryProgress> queries;
+};
+
+/**
+ * @brief Watches the sink files and, with adaptive backoff, the status of a set of submitted queries and
+ * returns when all of them are terminal, when their sinks stopped growing or when the timeout hits.
+ */
+class CompletionMonitor {
+  public:
+    using StatusProvider = std::function<std::string(size_t queryIndex)>;
+
+    CompletionMonitor(CompletionSettings settings, std::vector<std::string> sinkPaths);
+
+    /**
+     * @brief Blocks until completion. statusOf is called with the index of a sink path and returns the
+     * raw status of the corresponding query; a throwing provider counts as an unknown state.
+     */
+    CompletionReport waitForCompletion(const StatusProvider& statusOf);
+
+  private:
+    CompletionSettings settings;
+    std::vector<std::string> sinkPaths;
+    std::chrono::steady_clock::time_point submissionTime;
+    std::vector<QueryProgress> progress;
+};
+
+uint64_t sinkFileSize(const std::string& sinkPath);
+
+}// namespace SNCB::Driver
+
+#endif// SNCB_DRIVER_QUERYLIFECYCLE_HPP_
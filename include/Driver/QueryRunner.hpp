@@ -0,0 +1,115 @@
+#ifndef SNCB_DRIVER_QUERYRUNNER_HPP_
+#define SNCB_DRIVER_QUERYRUNNER_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <API/Query.hpp>
+#include <Client/RemoteClient.hpp>
+#include <Driver/QueryLifecycle.hpp>
+#include <Driver/RunConfig.hpp>
+#include <Driver/WorkerPool.hpp>
+
+namespace SNCB::Driver {
+
+/**
+ * @brief A query a driver submits: a name used in the output, the sink file it writes to unless the
+ * run config says otherwise, and a factory that builds the query for the resolved sink path.
+ */
+struct QueryDefinition {
+    std::string name;
+    std::string defaultSinkPath;
+    std::function<NES::Query(const std::string& sinkPath)> build;
+};
+
+struct QueryRunResult {
+    std::string name;
+    std::string sinkPath;
+    NES::QueryId queryId = NES::INVALID_QUERY_ID;
+    std::string finalStatus;
+    bool stopped = false;
+    // Only measured in completion mode
+    std::optional<std::chrono::milliseconds> timeToFirstResult;
+    std::optional<std::chrono::milliseconds> timeToDrain;
+    // Offsets from the start of the run at which the submission and the stop request returned
+    std::chrono::milliseconds submittedAt{0};
+    std::chrono::milliseconds stoppedAt{0};
+    // Records appended to the sink during the run, without the CSV header of a new sink
+    uint64_t results = 0;
+
+    double throughput() const;
+};
+
+struct RunResult {
+    std::vector<QueryRunResult> queries;
+    std::chrono::milliseconds executionTime{0};
+    std::optional<CompletionReason> completionReason;
+    // Wall time until every query was submitted and until every query was stopped again
+    std::chrono::milliseconds submissionTime{0};
+    std::chrono::milliseconds stopTime{0};
+
+    bool success() const;
+    uint64_t totalResults() const;
+    // Results of all queries per second between the first submission and the last stop
+    double aggregateThroughput() const;
+};
+
+/**
+ * @brief Connects to a coordinator, submits one or more queries, waits for the configured duration
+ * or, in completion mode, until the queries finished, and stops every query that is still running.
+ * With a parallelism above one the coordinator round trips of all queries go through a worker pool
+ * while a single monitor watches all of them. All drivers go through this class so that measurement
+ * logic lives in one place.
+ */
+class QueryRunner {
+  public:
+    explicit QueryRunner(RunConfig config);
+
+    /**
+     * @brief Creates the client and tests the connection to the coordinator.
+     * @return true if the coordinator answered
+     */
+    bool connect();
+
+    /**
+     * @brief Submits every definition, waits and stops them again.
+     * @throws std::logic_error if connect() did not succeed before
+     */
+    RunResult run(const std::vector<QueryDefinition>& definitions);
+    RunResult run(const QueryDefinition& definition);
+
+    std::string resolveSinkPath(const QueryDefinition& definition, size_t numberOfDefinitions) const;
+
+    const RunConfig& getConfig() const;
+    const std::shared_ptr<NES::Client::RemoteClient>& getClient() const;
+
+  private:
+    // Runs task(index, client) for all queries, on the worker pool if there is one
+    void forEachQuery(size_t count, const std::function<void(size_t index, NES::Client::RemoteClient& client)>& task);
+    // Best-effort stop of every submitted query after a failure
+    void stopSubmitted(RunResult& result, std::chrono::high_resolution_clock::time_point startTime);
+    void waitForDuration(const std::vector<QueryRunResult>& queries) const;
+    void waitForCompletion(CompletionMonitor& monitor, RunResult& result) const;
+
+    RunConfig config;
+    std::shared_ptr<NES::Client::RemoteClient> client;
+    // One client per pool worker, so no client is shared between threads
+    std::vector<std::shared_ptr<NES::Client::RemoteClient>> workerClients;
+    std::unique_ptr<WorkerPool> pool;
+};
+
+/**
+ * @brief The whole main() of a driver: parses the command line on top of the defaults, connects,
+ * runs the definitions and reports the result.
+ * @return the process exit code
+ */
+int runMain(int argc, char** argv, const std::vector<QueryDefinition>& definitions, RunConfig defaults = {});
+
+}// namespace SNCB::Driver
+
+#endif// SNCB_DRIVER_QUERYRUNNER_HPP_
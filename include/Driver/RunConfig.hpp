@@ -0,0 +1,59 @@
+#ifndef SNCB_DRIVER_RUNCONFIG_HPP_
+#define SNCB_DRIVER_RUNCONFIG_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <Client/QueryConfig.hpp>
+#include <Driver/QueryLifecycle.hpp>
+
+namespace SNCB::Driver {
+
+/**
+ * @brief Settings shared by every query driver: where the coordinator lives, how long a query runs,
+ * where it is placed and where its sink writes. Drivers pass their own defaults to fromArgs and
+ * anything given on the command line overrides them.
+ */
+struct RunConfig {
+    std::string coordinatorHost = "127.0.0.1";
+    uint16_t coordinatorPort = 8081;
+    std::chrono::seconds clientTimeout = std::chrono::seconds(20);
+    // Run time in fixed mode, upper bound of the run in completion mode
+    std::chrono::seconds duration = std::chrono::seconds(20);
+    LifecycleMode lifecycle = LifecycleMode::FixedDuration;
+    // Polling and idle detection of the completion mode; its timeout is taken from duration
+    CompletionSettings completion;
+    // Print the query status every statusInterval while waiting; zero only checks it once before stopping
+    std::chrono::seconds statusInterval = std::chrono::seconds(0);
+    NES::Optimizer::PlacementStrategy placement = NES::Optimizer::PlacementStrategy::TopDown;
+    // Overrides the sink file of a single-query driver
+    std::string sinkPath;
+    // Directory prepended to the default sink file of every query
+    std::string outputDirectory;
+    bool listLogicalSources = false;
+    // Number of workers that submit, poll and stop queries concurrently; 1 keeps everything on the calling thread
+    uint32_t parallelism = 1;
+    // Submits every query definition this many times, each copy with its own sink file
+    uint32_t copies = 1;
+
+    /**
+     * @brief Parses --coordinator host[:port], --duration s, --status-interval s, --placement name,
+     * --sink path, --output-dir dir, --client-timeout s, --list-sources, --lifecycle fixed|completion,
+     * --idle-intervals n, --idle-interval-ms ms, --max-poll-ms ms, --parallel n and --copies n on top of
+     * the given defaults.
+     * @throws std::invalid_argument on an unknown flag or a malformed value
+     */
+    static RunConfig fromArgs(int argc, char** argv, RunConfig defaults);
+
+    static std::string usage(const std::string& program);
+
+    CompletionSettings completionSettings() const;
+};
+
+NES::Optimizer::PlacementStrategy parsePlacementStrategy(const std::string& name);
+std::string toString(NES::Optimizer::PlacementStrategy placement);
+
+}// namespace SNCB::Driver
+
+#endif// SNCB_DRIVER_RUNCONFIG_HPP_
@@ -0,0 +1,47 @@
+#ifndef SNCB_DRIVER_WORKERPOOL_HPP_
+#define SNCB_DRIVER_WORKERPOOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SNCB::Driver {
+
+/**
+ * @brief Fixed set of threads that run blocking coordinator round trips (submit, status, stop) for
+ * many queries at once. Tasks learn the index of the worker running them so that callers can keep
+ * one client per worker.
+ */
+class WorkerPool {
+  public:
+    explicit WorkerPool(size_t numberOfWorkers);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Runs task(index, worker) for every index in [0, count) and blocks until all returned.
+     * @throws the first exception thrown by a task, after all tasks finished
+     */
+    void parallelFor(size_t count, const std::function<void(size_t index, size_t worker)>& task);
+
+    size_t size() const;
+
+  private:
+    void workerLoop(size_t worker);
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void(size_t worker)>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    bool stopping = false;
+};
+
+}// namespace SNCB::Driver
+
+#endif// SNCB_DRIVER_WORKERPOOL_HPP_
@@ -0,0 +1,40 @@
+#ifndef SNCB_ENGINE_AGGREGATION_HPP_
+#define SNCB_ENGINE_AGGREGATION_HPP_
+
+#include <Engine/Expressions.hpp>
+#include <Engine/TupleBuffer.hpp>
+#include <Engine/Windowing.hpp>
+
+#include <cstdint>
+#include <optional>
+
+namespace SNCB::Engine {
+
+/** @brief Running state of one aggregation in one window. */
+struct AggregateValue {
+    double value = 0.0;
+    uint64_t count = 0;
+};
+
+/** @brief An aggregation bound to the window's input schema: how to fold a tuple and what to emit. */
+class AggregationFunction {
+  public:
+    AggregationFunction(const WindowAggregation& aggregation, const Schema& inputSchema, const GeoContext* geo);
+
+    AggregateValue initial() const;
+    void lift(AggregateValue& state, const TupleBuffer& buffer, size_t row) const;
+    void combine(AggregateValue& state, const AggregateValue& other) const;
+    double lower(const AggregateValue& state) const;
+
+    AggregationKind getKind() const;
+    const Field& getResultField() const;
+
+  private:
+    AggregationKind kind;
+    std::optional<CompiledExpression> input;
+    Field resultField;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_AGGREGATION_HPP_
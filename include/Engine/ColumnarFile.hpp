@@ -0,0 +1,97 @@
+#ifndef SNCB_ENGINE_COLUMNARFILE_HPP_
+#define SNCB_ENGINE_COLUMNARFILE_HPP_
+
+#include <Engine/Schema.hpp>
+#include <Engine/TupleBuffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/**
+ * @brief Binary columnar copy of a source, converted once from CSV and replayed without parsing. All
+ * integers are little-endian:
+ *   header     "SNCBCOL1", u32 fields, u32 time field (0xFFFFFFFF: none), u64 rows, u64 chunks, u64 directory offset
+ *   fields     per field u8 type (0 UINT64, 1 FLOAT64, 2 BOOLEAN), u8 0, u16 name length, name
+ *   chunks     at 64 byte aligned offsets, one column of 8 byte slots per field in schema order, the
+ *              same slots as TupleBuffer
+ *   directory  per chunk u64 offset, u64 rows, u64 min and u64 max of the time field
+ * The magic is written last, so a file whose conversion did not finish is rejected.
+ */
+struct ColumnarChunk {
+    uint64_t offset;
+    uint64_t rows;
+    uint64_t minTimestamp;
+    uint64_t maxTimestamp;
+};
+
+/** @brief Writes tuple buffers of one schema to a columnar file, in chunks of rowsPerChunk rows. */
+class ColumnarFileWriter {
+  public:
+    /**
+     * @param timeField field whose per-chunk range goes into the directory, none if the schema lacks it
+     * @throws std::runtime_error if the file cannot be created
+     */
+    ColumnarFileWriter(const std::string& path, SchemaPtr schema, size_t rowsPerChunk, const std::string& timeField = "timestamp");
+
+    /** @brief Appends the tuples of a buffer with the writer's schema. */
+    void write(const TupleBuffer& buffer);
+
+    /**
+     * @brief Writes the last chunk, the directory and the header; without it the file is incomplete.
+     * @throws std::runtime_error if writing failed
+     */
+    void finish();
+
+    uint64_t getNumberOfRows() const;
+    const std::vector<ColumnarChunk>& getChunks() const;
+
+  private:
+    void writeChunk();
+
+    std::string path;
+    std::ofstream file;
+    SchemaPtr schema;
+    std::optional<size_t> timeField;
+    TupleBuffer pending;
+    std::vector<ColumnarChunk> chunks;
+    uint64_t rows = 0;
+};
+
+/**
+ * @brief Columnar file mapped into memory. The mapping is private and writable: operators may change
+ * buffers over it in place, which copies only the touched pages and never reaches the file.
+ */
+class ColumnarFile {
+  public:
+    /** @throws std::runtime_error if the file cannot be mapped or is no complete columnar file */
+    explicit ColumnarFile(const std::string& path);
+    ~ColumnarFile();
+    ColumnarFile(const ColumnarFile&) = delete;
+    ColumnarFile& operator=(const ColumnarFile&) = delete;
+
+    const SchemaPtr& getSchema() const;
+    std::optional<size_t> getTimeField() const;
+    uint64_t getNumberOfRows() const;
+    const std::vector<ColumnarChunk>& getChunks() const;
+
+    /** @brief First slot of a field's column in a chunk. */
+    uint64_t* getColumn(size_t chunk, size_t field) const;
+
+  private:
+    char* mapping = nullptr;
+    size_t size = 0;
+    SchemaPtr schema;
+    std::optional<size_t> timeField;
+    uint64_t rows = 0;
+    std::vector<ColumnarChunk> chunks;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_COLUMNARFILE_HPP_
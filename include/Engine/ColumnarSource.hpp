@@ -0,0 +1,43 @@
+#ifndef SNCB_ENGINE_COLUMNARSOURCE_HPP_
+#define SNCB_ENGINE_COLUMNARSOURCE_HPP_
+
+#include <Engine/ColumnarFile.hpp>
+#include <Engine/DataSource.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/**
+ * @brief Replays a columnar file. Buffers are views of the mapped columns, so producing one copies
+ * nothing and parses nothing; only the pages the operators read are loaded.
+ */
+class ColumnarSource : public DataSource {
+  public:
+    /**
+     * @param readSchema fields to produce, matched to the file's fields by name and type
+     * @throws std::runtime_error if the file cannot be read
+     * @throws std::invalid_argument if the file lacks a field of readSchema or stores it with another type
+     */
+    ColumnarSource(const std::string& path, SchemaPtr readSchema, size_t tuplesPerBuffer);
+
+    /** @brief Points the buffer at the next tuplesPerBuffer rows or the rest of the current chunk. */
+    bool fillBuffer(TupleBuffer& buffer) override;
+    uint64_t getProducedTuples() const override;
+
+  private:
+    ColumnarFile file;
+    SchemaPtr schema;
+    // Field of the file behind each field of the read schema
+    std::vector<size_t> fileFields;
+    size_t tuplesPerBuffer;
+    size_t chunk = 0;
+    uint64_t row = 0;
+    uint64_t producedTuples = 0;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_COLUMNARSOURCE_HPP_
@@ -0,0 +1,69 @@
+#ifndef SNCB_ENGINE_CSVSOURCE_HPP_
+#define SNCB_ENGINE_CSVSOURCE_HPP_
+
+#include <Engine/DataSource.hpp>
+#include <Engine/SourceCatalog.hpp>
+#include <Engine/TupleBuffer.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/**
+ * @brief Reads a CSV file once, front to back, into tuple buffers of the source schema. Missing or
+ * unparsable values become 0, extra columns are ignored. The file is read in chunks of whole lines whose
+ * delimiters and newlines are indexed with SIMD, and values are parsed straight into the buffer columns.
+ */
+class CsvSource : public DataSource {
+  public:
+    /** @throws std::runtime_error if the file cannot be opened */
+    CsvSource(const PhysicalSourceConfig& config, SchemaPtr schema);
+
+    /**
+     * @brief Reads only the columns of readSchema, a subset of the file's schema in file order; the
+     * other columns are skipped without parsing them.
+     * @throws std::invalid_argument if readSchema has a field the file schema lacks
+     */
+    CsvSource(const PhysicalSourceConfig& config, const SchemaPtr& fileSchema, SchemaPtr readSchema);
+
+    bool fillBuffer(TupleBuffer& buffer) override;
+    uint64_t getProducedTuples() const override;
+
+  private:
+    /** @brief Reads the next chunk of whole lines and indexes it; false at the end of the file. */
+    bool readChunk();
+    /** @brief Parses the line at lineStart into the row, or skips it if it is blank. */
+    void parseLine(TupleBuffer& buffer);
+
+    struct Column {
+        // Field of the read schema the column is parsed into, or none to skip it
+        std::optional<size_t> field;
+        DataType type;
+    };
+
+    std::ifstream file;
+    SchemaPtr schema;
+    // Columns of a line up to the last one that is read
+    std::vector<Column> columns;
+    char delimiter;
+    bool skipLine;
+    // Whole lines in chunk[0, chunkSize), a partial last line follows up to chunkSize + tailSize
+    std::vector<char> chunk;
+    size_t chunkSize = 0;
+    size_t tailSize = 0;
+    // Offsets of the delimiters and newlines in the whole lines, the next one to consume and where the
+    // next line starts
+    std::vector<uint32_t> structurals;
+    size_t structuralCount = 0;
+    size_t nextStructural = 0;
+    size_t lineStart = 0;
+    uint64_t producedTuples = 0;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_CSVSOURCE_HPP_
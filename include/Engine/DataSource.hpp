@@ -0,0 +1,26 @@
+#ifndef SNCB_ENGINE_DATASOURCE_HPP_
+#define SNCB_ENGINE_DATASOURCE_HPP_
+
+#include <Engine/TupleBuffer.hpp>
+
+#include <cstdint>
+
+namespace SNCB::Engine {
+
+/** @brief Producer of the tuple buffers a query group scans, read once front to back. */
+class DataSource {
+  public:
+    virtual ~DataSource() = default;
+
+    /**
+     * @brief Fills the buffer with the next tuples, replacing its content.
+     * @return false once the source is exhausted and the buffer stayed empty
+     */
+    virtual bool fillBuffer(TupleBuffer& buffer) = 0;
+
+    virtual uint64_t getProducedTuples() const = 0;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_DATASOURCE_HPP_
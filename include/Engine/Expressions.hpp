@@ -0,0 +1,173 @@
+#ifndef SNCB_ENGINE_EXPRESSIONS_HPP_
+#define SNCB_ENGINE_EXPRESSIONS_HPP_
+
+#include <Engine/GeoContext.hpp>
+#include <Engine/Schema.hpp>
+#include <Engine/TupleBuffer.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SNCB::Engine {
+
+enum class ExpressionKind {
+    Field,
+    Constant,
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Less,
+    LessEquals,
+    Greater,
+    GreaterEquals,
+    Equals,
+    NotEquals,
+    And,
+    Or,
+    Not,
+    TEIntersects,
+    TPointAtSTBox,
+    TEDWithin
+};
+
+struct ExpressionNode;
+using ExpressionNodePtr = std::shared_ptr<const ExpressionNode>;
+
+/** @brief Immutable node of an expression tree as built by the query API. */
+struct ExpressionNode {
+    ExpressionKind kind;
+    // Field: the referenced field, its declared type if given (the schema type wins)
+    std::string fieldName;
+    std::optional<DataType> declaredType;
+    // Constant: value and the type of the literal
+    double constant = 0.0;
+    DataType constantType = DataType::FLOAT64;
+    std::vector<ExpressionNodePtr> children;
+
+    /** @brief Field names read by this expression, in order of first use. */
+    void collectFields(std::vector<std::string>& fields) const;
+    std::string toString() const;
+};
+
+class FieldAssignment;
+
+/**
+ * @brief Value handle of the query API, mirroring NES' ExpressionItem: Attribute("speed") > 100 builds a
+ * comparison node and Attribute("x") = expression builds a FieldAssignment for map.
+ */
+class ExpressionItem {
+  public:
+    ExpressionItem(ExpressionNodePtr node);
+    ExpressionItem(int value);
+    ExpressionItem(int64_t value);
+    ExpressionItem(uint64_t value);
+    ExpressionItem(double value);
+    ExpressionItem(const ExpressionItem& other) = default;
+
+    /** @brief Assigns the value of an expression to this field, as in NES this does not copy the item. */
+    FieldAssignment operator=(const ExpressionItem& value) const;
+
+    const ExpressionNodePtr& getNode() const;
+
+  private:
+    ExpressionNodePtr node;
+};
+
+/** @brief Target field and value expression of a map operator. */
+class FieldAssignment {
+  public:
+    FieldAssignment(std::string field, ExpressionNodePtr value);
+
+    const std::string& getField() const;
+    const ExpressionNodePtr& getValue() const;
+
+  private:
+    std::string field;
+    ExpressionNodePtr value;
+};
+
+ExpressionItem Attribute(const std::string& name);
+ExpressionItem Attribute(const std::string& name, DataType type);
+
+ExpressionItem operator+(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator-(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator*(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator/(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator<(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator<=(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator>(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator>=(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator==(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator!=(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator&&(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator||(const ExpressionItem& left, const ExpressionItem& right);
+ExpressionItem operator!(const ExpressionItem& value);
+
+/** @brief 1 if the position is inside a high-risk area, see GeoContext. */
+ExpressionItem teintersects(const ExpressionItem& longitude, const ExpressionItem& latitude, const ExpressionItem& timestamp);
+/** @brief 1 if the position is inside the spatio-temporal box, see GeoContext. */
+ExpressionItem tpointatstbox(const ExpressionItem& longitude, const ExpressionItem& latitude, const ExpressionItem& timestamp);
+/** @brief 1 if the position is within the configured distance of a high-risk area, see GeoContext. */
+ExpressionItem tedwithin(const ExpressionItem& longitude, const ExpressionItem& latitude, const ExpressionItem& timestamp);
+/** @brief tedwithin with the distance widened by slackMeters, e.g. for GPS error. */
+ExpressionItem tedwithin(const ExpressionItem& longitude, const ExpressionItem& latitude, const ExpressionItem& timestamp,
+                         double slackMeters);
+
+/**
+ * @brief Expression bound to an input schema: field references are resolved to slots and the result
+ * type is inferred, so evaluation does no lookups.
+ */
+class CompiledExpression {
+  public:
+    // Rows evaluated per evaluateBatch call; scratch columns of this length stay in L1/L2
+    static constexpr size_t BatchSize = 1024;
+
+    /** @throws std::invalid_argument if a field is not part of the schema */
+    CompiledExpression(const ExpressionNodePtr& root, const Schema& schema, const GeoContext* geo);
+
+    double evaluate(const TupleBuffer& buffer, size_t row) const { return evaluate(0, buffer, row); }
+    bool evaluatePredicate(const TupleBuffer& buffer, size_t row) const { return evaluate(0, buffer, row) != 0.0; }
+
+    /**
+     * @brief Evaluates rows [begin, begin + count) node by node with the vector kernels, count <= BatchSize.
+     * @return the results, valid until the next call
+     */
+    const double* evaluateBatch(const TupleBuffer& buffer, size_t begin, size_t count);
+
+    /**
+     * @brief Writes the indices of the rows in [begin, begin + count) that satisfy the predicate.
+     * @return the number of selected rows
+     */
+    size_t selectBatch(const TupleBuffer& buffer, size_t begin, size_t count, uint32_t* selection);
+
+    DataType getResultType() const;
+    /** @brief Result type the expression would have on the schema, without compiling it; none if a field is missing. */
+    static std::optional<DataType> resultTypeOf(const ExpressionNodePtr& root, const Schema& schema);
+
+  private:
+    struct Node {
+        ExpressionKind kind;
+        size_t field = 0;
+        DataType type = DataType::FLOAT64;
+        double constant = 0.0;
+        std::vector<size_t> children;
+    };
+
+    size_t compile(const ExpressionNodePtr& node, const Schema& schema);
+    double evaluate(size_t index, const TupleBuffer& buffer, size_t row) const;
+    const double* evaluateBatch(size_t index, const TupleBuffer& buffer, size_t begin, size_t count);
+
+    std::vector<Node> nodes;
+    const GeoContext* geo;
+    // One column of BatchSize values per node; constants are filled in once
+    std::vector<double> scratch;
+    std::vector<uint64_t> bitmap;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_EXPRESSIONS_HPP_
@@ -0,0 +1,656 @@
+#ifndef SNCB_ENGINE_FUSEDPIPELINE_HPP_
+#define SNCB_ENGINE_FUSEDPIPELINE_HPP_
+
+#include <Engine/GeoContext.hpp>
+#include <Engine/Operators.hpp>
+#include <Engine/Schema.hpp>
+#include <Engine/TupleBuffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Pipelines of a fixed shape compiled into one loop per buffer. Stages are written like the query API,
+ * with field names as template arguments:
+ *
+ *     auto plan = Fused::from()
+ *                     .map<"passenger_count">((Fused::Attribute<"T1_bar">() + Fused::Attribute<"T2_bar">()) / 2.0)
+ *                     .filter(Fused::Attribute<"passenger_count">() > 3.15)
+ *                     .project<"timestamp", "speed">();
+ *     auto executable = plan.compile(schema, &geo, capacity);
+ *
+ * Each stage is an expression template, so a tuple runs through all of them inlined, without intermediate
+ * buffers, and only the projected fields are written. Maps whose field no later stage reads and the projection
+ * drops are removed at compile time. Fields are bound to columns once, when the plan is compiled. Values are
+ * doubles as in CompiledExpression::evaluate, so results equal the interpreted operators', except that map
+ * fields are always FLOAT64.
+ */
+namespace SNCB::Engine::Fused {
+
+/** @brief String literal as a template argument, the name of a field. */
+template <size_t N>
+struct FieldName {
+    constexpr FieldName(const char (&text)[N]) { std::copy_n(text, N, value); }
+    constexpr std::string_view view() const { return {value, N - 1}; }
+
+    char value[N];
+};
+
+/** @brief A tuple while it runs through the stages: its row and the values of the maps so far. */
+struct Row {
+    size_t row;
+    const double* values;
+};
+
+/** @brief What the expressions of a stage read: the input schema and the maps of the stages before it. */
+struct Binding {
+    const Schema& schema;
+    const GeoContext* geo;
+    // Field of every map before the stage; map i stores its value at Row::values[i]
+    std::vector<std::string_view> mapFields;
+};
+
+// Row::values index of a field that is read from the input instead
+inline constexpr size_t noSlot = std::numeric_limits<size_t>::max();
+
+/*
+ * Expressions are bound to a Scope, the stage they belong to, whose slot<Field>() is the Row::values index of
+ * the latest map of the field before the stage or noSlot; so whether a field is a map or an input column is
+ * decided at compile time. prepare() takes the columns of each buffer before its rows are evaluated.
+ */
+struct ExpressionBase {};
+
+template <class T>
+concept Expression = std::derived_from<T, ExpressionBase>;
+
+template <class T>
+concept Operand = Expression<T> || std::is_arithmetic_v<T>;
+
+/**
+ * @brief Field of the input, or of the latest map of that name before the stage. With Typed, the field must have
+ * the given type and its values are read without looking at the schema's type per tuple.
+ */
+template <FieldName Name, bool Typed = false, DataType Type = DataType::FLOAT64>
+struct Attr : ExpressionBase {
+    template <FieldName Field>
+    static constexpr bool reads() {
+        return Name.view() == Field.view();
+    }
+
+    template <class Scope>
+    void bind(const Binding& binding) {
+        if constexpr (Scope::template slot<Name>() == noSlot) {
+            column = binding.schema.getIndex(std::string(Name.view()));
+            floating = binding.schema.getField(column).type == DataType::FLOAT64;
+            if (Typed && binding.schema.getField(column).type != Type) {
+                throw std::invalid_argument("Fused attribute " + std::string(Name.view()) + " does not have its declared type");
+            }
+        }
+    }
+    void prepare(const TupleBuffer& buffer) { data = buffer.getColumn(column); }
+
+    template <class Scope>
+    double evaluate(const Row& row) const {
+        if constexpr (constexpr auto slot = Scope::template slot<Name>(); slot != noSlot) {
+            return row.values[slot];
+        } else if constexpr (Typed) {
+            return Type == DataType::FLOAT64 ? std::bit_cast<double>(data[row.row]) : static_cast<double>(data[row.row]);
+        } else {
+            return floating ? std::bit_cast<double>(data[row.row]) : static_cast<double>(data[row.row]);
+        }
+    }
+
+    size_t column = 0;
+    bool floating = false;
+    const uint64_t* data = nullptr;
+};
+
+struct Constant : ExpressionBase {
+    explicit Constant(double value) : value(value) {}
+
+    template <FieldName>
+    static constexpr bool reads() {
+        return false;
+    }
+    template <class Scope>
+    void bind(const Binding&) {}
+    void prepare(const TupleBuffer&) {}
+    template <class Scope>
+    double evaluate(const Row&) const {
+        return value;
+    }
+
+    double value;
+};
+
+/** @brief Arithmetic or comparison; comparisons give 1.0 or 0.0. */
+template <class Function, Expression Left, Expression Right>
+struct Binary : ExpressionBase {
+    Binary(Left left, Right right) : left(std::move(left)), right(std::move(right)) {}
+
+    template <FieldName Field>
+    static constexpr bool reads() {
+        return Left::template reads<Field>() || Right::template reads<Field>();
+    }
+    template <class Scope>
+    void bind(const Binding& binding) {
+        left.template bind<Scope>(binding);
+        right.template bind<Scope>(binding);
+    }
+    void prepare(const TupleBuffer& buffer) {
+        left.prepare(buffer);
+        right.prepare(buffer);
+    }
+    template <class Scope>
+    double evaluate(const Row& row) const {
+        return static_cast<double>(Function{}(left.template evaluate<Scope>(row), right.template evaluate<Scope>(row)));
+    }
+
+    Left left;
+    Right right;
+};
+
+/** @brief Conjunction or disjunction that skips its right side once the left side decides. */
+template <bool IsAnd, Expression Left, Expression Right>
+struct Logical : ExpressionBase {
+    Logical(Left left, Right right) : left(std::move(left)), right(std::move(right)) {}
+
+    template <FieldName Field>
+    static constexpr bool reads() {
+        return Left::template reads<Field>() || Right::template reads<Field>();
+    }
+    template <class Scope>
+    void bind(const Binding& binding) {
+        left.template bind<Scope>(binding);
+        right.template bind<Scope>(binding);
+    }
+    void prepare(const TupleBuffer& buffer) {
+        left.prepare(buffer);
+        right.prepare(buffer);
+    }
+    template <class Scope>
+    double evaluate(const Row& row) const {
+        if constexpr (IsAnd) {
+            return left.template evaluate<Scope>(row) != 0.0 && right.template evaluate<Scope>(row) != 0.0;
+        } else {
+            return left.template evaluate<Scope>(row) != 0.0 || right.template evaluate<Scope>(row) != 0.0;
+        }
+    }
+
+    Left left;
+    Right right;
+};
+
+template <Expression Value>
+struct Not : ExpressionBase {
+    explicit Not(Value value) : value(std::move(value)) {}
+
+    template <FieldName Field>
+    static constexpr bool reads() {
+        return Value::template reads<Field>();
+    }
+    template <class Scope>
+    void bind(const Binding& binding) {
+        value.template bind<Scope>(binding);
+    }
+    void prepare(const TupleBuffer& buffer) { value.prepare(buffer); }
+    template <class Scope>
+    double evaluate(const Row& row) const {
+        return value.template evaluate<Scope>(row) == 0.0;
+    }
+
+    Value value;
+};
+
+enum class GeoFunction { TEIntersects, TPointAtSTBox, TEDWithin };
+
+/** @brief The MEOS predicates of the query API, evaluated with the GeoContext of the plan. */
+template <GeoFunction Function, Expression Longitude, Expression Latitude, Expression Timestamp>
+struct Geo : ExpressionBase {
+    Geo(Longitude longitude, Latitude latitude, Timestamp timestamp, double slackMeters = 0.0)
+        : longitude(std::move(longitude)), latitude(std::move(latitude)), timestamp(std::move(timestamp)), slackMeters(slackMeters) {}
+
+    template <FieldName Field>
+    static constexpr bool reads() {
+        return Longitude::template reads<Field>() || Latitude::template reads<Field>() || Timestamp::template reads<Field>();
+    }
+    template <class Scope>
+    void bind(const Binding& binding) {
+        if (binding.geo == nullptr) {
+            throw std::invalid_argument("A fused geo predicate needs a GeoContext");
+        }
+        geo = binding.geo;
+        longitude.template bind<Scope>(binding);
+        latitude.template bind<Scope>(binding);
+        timestamp.template bind<Scope>(binding);
+    }
+    void prepare(const TupleBuffer& buffer) {
+        longitude.prepare(buffer);
+        latitude.prepare(buffer);
+        timestamp.prepare(buffer);
+    }
+    template <class Scope>
+    double evaluate(const Row& row) const {
+        auto x = longitude.template evaluate<Scope>(row);
+        auto y = latitude.template evaluate<Scope>(row);
+        auto time = static_cast<uint64_t>(timestamp.template evaluate<Scope>(row));
+        if constexpr (Function == GeoFunction::TEIntersects) {
+            return geo->intersectsArea(x, y, time);
+        } else if constexpr (Function == GeoFunction::TPointAtSTBox) {
+            return geo->atSTBox(x, y, time);
+        } else {
+            return geo->withinDistance(x, y, time, slackMeters);
+        }
+    }
+
+    Longitude longitude;
+    Latitude latitude;
+    Timestamp timestamp;
+    double slackMeters;
+    const GeoContext* geo = nullptr;
+};
+
+template <FieldName Name>
+Attr<Name> Attribute() {
+    return {};
+}
+
+/** @brief Attribute with its type, as Attribute("speed", BasicType::UINT64). */
+template <FieldName Name, DataType Type>
+Attr<Name, true, Type> Attribute() {
+    return {};
+}
+
+template <Operand T>
+auto toExpression(T value) {
+    if constexpr (Expression<T>) {
+        return value;
+    } else {
+        return Constant(static_cast<double>(value));
+    }
+}
+
+template <class Function, Operand Left, Operand Right>
+auto makeBinary(Left left, Right right) {
+    return Binary<Function, decltype(toExpression(left)), decltype(toExpression(right))>(toExpression(left), toExpression(right));
+}
+
+template <Operand Left, Operand Right>
+    requires(Expression<Left> || Expression<Right>)
+auto operator+(Left left, Right right) {
+    return makeBinary<std::plus<>>(left, right);
+}
+
+template <Operand Left, Operand Right>
+    requires(Expression<Left> || Expression<Right>)
+auto operator-(Left left, Right right) {
+    return makeBinary<std::minus<>>(left, right);
+}
+
+template <Operand Left, Operand Right>
+    requires(Expression<Left> || Expression<Right>)
+auto operator*(Left left, Right right) {
+    return makeBinary<std::multiplies<>>(left, right);
+}
+
+template <Operand Left, Operand Right>
+    requires(Expression<Left> || Expression<Right>)
+auto operator/(Left left, Right right) {
+    return makeBinary<std::divides<>>(left, right);
+}
+
+template <Operand Left, Operand Right>
+    requires(Expression<Left> || Expression<Right>)
+auto operator<(Left left, Right right) {
+    return makeBinary<std::less<>>(left, right);
+}
+
+template <Operand Left, Operand Right>
+    requires(Expression<Left> || Expression<Right>)
+auto operator<=(Left left, Right right) {
+    return makeBinary<std::less_equal<>>(left, right);
+}
+
+template <Operand Left, Operand Right>
+    requires(Expression<Left> || Expression<Right>)
+auto operator>(Left left, Right right) {
+    return makeBinary<std::greater<>>(left, right);
+}
+
+template <Operand Left, Operand Right>
+    requires(Expression<Left> || Expression<Right>)
+auto operator>=(Left left, Right right) {
+    return makeBinary<std::greater_equal<>>(left, right);
+}
+
+template <Operand Left, Operand Right>
+    requires(Expression<Left> || Expression<Right>)
+auto operator==(Left left, Right right) {
+    return makeBinary<std::equal_to<>>(left, right);
+}
+
+template <Operand Left, Operand Right>
+    requires(Expression<Left> || Expression<Right>)
+auto operator!=(Left left, Right right) {
+    return makeBinary<std::not_equal_to<>>(left, right);
+}
+
+template <Expression Left, Expression Right>
+auto operator&&(Left left, Right right) {
+    return Logical<true, Left, Right>(std::move(left), std::move(right));
+}
+
+template <Expression Left, Expression Right>
+auto operator||(Left left, Right right) {
+    return Logical<false, Left, Right>(std::move(left), std::move(right));
+}
+
+template <Expression Value>
+auto operator!(Value value) {
+    return Not<Value>(std::move(value));
+}
+
+template <Expression Longitude, Expression Latitude, Expression Timestamp>
+auto teintersects(Longitude longitude, Latitude latitude, Timestamp timestamp) {
+    return Geo<GeoFunction::TEIntersects, Longitude, Latitude, Timestamp>(longitude, latitude, timestamp);
+}
+
+template <Expression Longitude, Expression Latitude, Expression Timestamp>
+auto tpointatstbox(Longitude longitude, Latitude latitude, Timestamp timestamp) {
+    return Geo<GeoFunction::TPointAtSTBox, Longitude, Latitude, Timestamp>(longitude, latitude, timestamp);
+}
+
+template <Expression Longitude, Expression Latitude, Expression Timestamp>
+auto tedwithin(Longitude longitude, Latitude latitude, Timestamp timestamp, double slackMeters = 0.0) {
+    return Geo<GeoFunction::TEDWithin, Longitude, Latitude, Timestamp>(longitude, latitude, timestamp, slackMeters);
+}
+
+template <FieldName Name, Expression Value>
+struct Map {
+    static constexpr bool isMap = true;
+    static constexpr auto field = Name;
+
+    template <FieldName Field>
+    static constexpr bool reads() {
+        return Value::template reads<Field>();
+    }
+    template <FieldName Field>
+    static constexpr bool defines() {
+        return Name.view() == Field.view();
+    }
+
+    Value value;
+};
+
+template <Expression Predicate>
+struct Filter {
+    static constexpr bool isMap = false;
+
+    template <FieldName Field>
+    static constexpr bool reads() {
+        return Predicate::template reads<Field>();
+    }
+    template <FieldName>
+    static constexpr bool defines() {
+        return false;
+    }
+
+    Predicate predicate;
+};
+
+/** @brief Fields a plan writes, in order. */
+template <FieldName... Names>
+struct Fields {
+    static constexpr std::array<std::string_view, sizeof...(Names)> names{Names.view()...};
+
+    template <FieldName Field>
+    static constexpr bool contains() {
+        return ((Names.view() == Field.view()) || ...);
+    }
+};
+
+/**
+ * @brief Operator of a compiled plan: runs every tuple through the stages and appends the projected fields of
+ * those that pass all filters. Projected map fields are FLOAT64, the others keep their type.
+ */
+template <class Projection, class... Stages>
+class FusedExecutable : public ExecutableOperator {
+  public:
+    /** @throws std::invalid_argument if a field is not part of the schema or a geo predicate has no GeoContext */
+    FusedExecutable(std::tuple<Stages...> stages, const SchemaPtr& inputSchema, const GeoContext* geo, size_t capacity)
+        : ExecutableOperator(nullptr), stages(std::move(stages)) {
+        Binding binding{*inputSchema, geo, {}};
+        bindStages(binding, std::index_sequence_for<Stages...>{});
+        auto schema = std::make_shared<Schema>();
+        for (size_t i = 0; i < Projection::names.size(); ++i) {
+            const auto& name = Projection::names[i];
+            auto map = std::find(binding.mapFields.rbegin(), binding.mapFields.rend(), name);
+            if (map != binding.mapFields.rend()) {
+                outputs[i] = {static_cast<size_t>(std::distance(map, binding.mapFields.rend())) - 1, 0};
+                schema->addField(std::string(name), DataType::FLOAT64);
+            } else {
+                auto column = inputSchema->getIndex(std::string(name));
+                outputs[i] = {noSlot, column};
+                schema->addField(std::string(name), inputSchema->getField(column).type);
+            }
+        }
+        outputSchema = std::move(schema);
+        output.emplace(outputSchema, capacity);
+    }
+
+    void execute(TupleBuffer& buffer) override {
+        output->clear();
+        output->setIngestionTime(buffer.getIngestionTime());
+        prepareStages(buffer, std::index_sequence_for<Stages...>{});
+        std::array<double, std::max<size_t>(numberOfMaps(), 1)> values{};
+        for (size_t row = 0, rows = buffer.getNumberOfTuples(); row < rows; ++row) {
+            if (!run<0>(row, values.data())) {
+                continue;
+            }
+            if (output->isFull()) {
+                emit(*output);
+                output->clear();
+            }
+            auto target = output->append();
+            for (size_t i = 0; i < outputs.size(); ++i) {
+                if (outputs[i].slot != noSlot) {
+                    output->setDouble(target, i, values[outputs[i].slot]);
+                } else {
+                    output->setUInt(target, i, buffer.getUInt(row, outputs[i].column));
+                }
+            }
+        }
+        emit(*output);
+    }
+
+    static constexpr size_t numberOfMaps() { return (size_t{0} + ... + (Stages::isMap ? 1 : 0)); }
+    /** @brief Maps that are evaluated, the others are dead. */
+    static constexpr size_t numberOfLiveMaps() {
+        return []<size_t... K>(std::index_sequence<K...>) {
+            return (size_t{0} + ... + (Stage<K>::isMap && isLive<K>() ? 1 : 0));
+        }(std::index_sequence_for<Stages...>{});
+    }
+
+  private:
+    template <size_t K>
+    using Stage = std::tuple_element_t<K, std::tuple<Stages...>>;
+
+    struct Output {
+        // Map that computes the field, or noSlot for a field copied from the input column
+        size_t slot;
+        size_t column;
+    };
+
+    // Slot of the map at stage K in the values of a row
+    template <size_t K>
+    static constexpr size_t slotOf() {
+        return []<size_t... J>(std::index_sequence<J...>) {
+            return (size_t{0} + ... + (Stage<J>::isMap ? 1 : 0));
+        }(std::make_index_sequence<K>{});
+    }
+
+    // Slot of the latest map of the field before stage K, noSlot if the field is read from the input
+    template <size_t K, FieldName Field>
+    static constexpr size_t slotBefore() {
+        if constexpr (K == 0) {
+            return noSlot;
+        } else if constexpr (Stage<K - 1>::template defines<Field>()) {
+            return slotOf<K - 1>();
+        } else {
+            return slotBefore<K - 1, Field>();
+        }
+    }
+
+    /** @brief Scope of the expressions of stage K. */
+    template <size_t K>
+    struct Scope {
+        template <FieldName Field>
+        static constexpr size_t slot() {
+            return slotBefore<K, Field>();
+        }
+    };
+
+    // True if the stages from J on or the projection read the field before a map replaces it
+    template <size_t J, FieldName Field>
+    static constexpr bool isReadFrom() {
+        if constexpr (J == sizeof...(Stages)) {
+            return Projection::template contains<Field>();
+        } else if constexpr (Stage<J>::template reads<Field>()) {
+            return true;
+        } else if constexpr (Stage<J>::template defines<Field>()) {
+            return false;
+        } else {
+            return isReadFrom<J + 1, Field>();
+        }
+    }
+
+    template <size_t K>
+    static constexpr bool isLive() {
+        if constexpr (Stage<K>::isMap) {
+            return isReadFrom<K + 1, Stage<K>::field>();
+        } else {
+            return true;
+        }
+    }
+
+    template <size_t... K>
+    void bindStages(Binding& binding, std::index_sequence<K...>) {
+        (bindStage<K>(binding), ...);
+    }
+
+    template <size_t K>
+    void bindStage(Binding& binding) {
+        auto& stage = std::get<K>(stages);
+        if constexpr (!Stage<K>::isMap) {
+            stage.predicate.template bind<Scope<K>>(binding);
+        } else {
+            if constexpr (isLive<K>()) {
+                stage.value.template bind<Scope<K>>(binding);
+            }
+            binding.mapFields.push_back(Stage<K>::field.view());
+        }
+    }
+
+    template <size_t... K>
+    void prepareStages(const TupleBuffer& buffer, std::index_sequence<K...>) {
+        (prepareStage<K>(buffer), ...);
+    }
+
+    template <size_t K>
+    void prepareStage(const TupleBuffer& buffer) {
+        auto& stage = std::get<K>(stages);
+        if constexpr (!Stage<K>::isMap) {
+            stage.predicate.prepare(buffer);
+        } else if constexpr (isLive<K>()) {
+            stage.value.prepare(buffer);
+        }
+    }
+
+    // Runs the row through the stages from K on, false once a filter drops it
+    template <size_t K>
+    bool run(size_t row, double* values) const {
+        if constexpr (K == sizeof...(Stages)) {
+            return true;
+        } else {
+            const auto& stage = std::get<K>(stages);
+            if constexpr (!Stage<K>::isMap) {
+                if (stage.predicate.template evaluate<Scope<K>>(Row{row, values}) == 0.0) {
+                    return false;
+                }
+            } else if constexpr (isLive<K>()) {
+                values[slotOf<K>()] = stage.value.template evaluate<Scope<K>>(Row{row, values});
+            }
+            return run<K + 1>(row, values);
+        }
+    }
+
+    std::tuple<Stages...> stages;
+    std::array<Output, Projection::names.size()> outputs{};
+    std::optional<TupleBuffer> output;
+};
+
+/** @brief Stages with the fields to write, ready to be compiled against a schema. */
+template <class Projection, class... Stages>
+class Plan {
+  public:
+    explicit Plan(std::tuple<Stages...> stages) : stages(std::move(stages)) {}
+
+    std::unique_ptr<FusedExecutable<Projection, Stages...>> compile(const SchemaPtr& inputSchema, const GeoContext* geo,
+                                                                     size_t capacity) const {
+        return std::make_unique<FusedExecutable<Projection, Stages...>>(stages, inputSchema, geo, capacity);
+    }
+
+  private:
+    std::tuple<Stages...> stages;
+};
+
+template <class... Stages>
+class Pipeline {
+  public:
+    Pipeline() = default;
+    explicit Pipeline(std::tuple<Stages...> stages) : stages(std::move(stages)) {}
+
+    /** @brief Assigns the value to the field, as Query::map(Attribute(name) = value). */
+    template <FieldName Name, Operand Value>
+    auto map(Value value) const {
+        using Stage = Map<Name, decltype(toExpression(value))>;
+        return Pipeline<Stages..., Stage>(std::tuple_cat(stages, std::make_tuple(Stage{toExpression(value)})));
+    }
+
+    template <Expression Predicate>
+    auto filter(Predicate predicate) const {
+        using Stage = Filter<Predicate>;
+        return Pipeline<Stages..., Stage>(std::tuple_cat(stages, std::make_tuple(Stage{std::move(predicate)})));
+    }
+
+    /** @brief Ends the pipeline with the fields it writes, e.g. those the next operator reads. */
+    template <FieldName... Names>
+    Plan<Fields<Names...>, Stages...> project() const {
+        return Plan<Fields<Names...>, Stages...>(stages);
+    }
+
+  private:
+    std::tuple<Stages...> stages;
+};
+
+inline Pipeline<> from() { return {}; }
+
+}// namespace SNCB::Engine::Fused
+
+#endif// SNCB_ENGINE_FUSEDPIPELINE_HPP_
@@ -0,0 +1,109 @@
+#ifndef SNCB_ENGINE_GEOCONTEXT_HPP_
+#define SNCB_ENGINE_GEOCONTEXT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/** @brief A high-risk location from data/high_risk_areas_ordered_unix.csv. */
+struct HighRiskArea {
+    uint64_t timestamp;
+    double latitude;
+    double longitude;
+};
+
+/** @brief Spatio-temporal box of tpointatstbox, in degrees and the time unit of the stream. */
+struct STBox {
+    double minLongitude = 4.0;
+    double maxLongitude = 6.5;
+    double minLatitude = 49.5;
+    double maxLatitude = 51.5;
+    uint64_t minTime = 0;
+    uint64_t maxTime = std::numeric_limits<uint64_t>::max();
+};
+
+/**
+ * @brief Reference geometries behind the MEOS functions of the SNCB queries. The engine evaluates
+ * teintersects as "inside the disc of areaRadiusMeters around a high-risk area", tedwithin as
+ * "within withinDistanceMeters of a high-risk area" and tpointatstbox against the STBox, whose
+ * default is the Belgium box of the e2e configurations. The areas are indexed by a uniform grid, so a
+ * position far from every area is rejected by one cell lookup and the others only test nearby areas.
+ */
+class GeoContext {
+  public:
+    GeoContext() = default;
+    GeoContext(std::vector<HighRiskArea> areas, double areaRadiusMeters, double withinDistanceMeters, STBox box);
+
+    /**
+     * @brief Loads the areas from a "timestamp,latitude,longitude" CSV file with header.
+     * @throws std::runtime_error if the file cannot be read
+     */
+    static GeoContext fromCsv(const std::string& path, double areaRadiusMeters = 500.0,
+                              double withinDistanceMeters = 1000.0, STBox box = {});
+
+    bool intersectsArea(double longitude, double latitude, uint64_t timestamp) const;
+    /** @brief Within withinDistanceMeters plus slackMeters of a high-risk area. */
+    bool withinDistance(double longitude, double latitude, uint64_t timestamp, double slackMeters = 0.0) const;
+    bool atSTBox(double longitude, double latitude, uint64_t timestamp) const;
+
+    /**
+     * @brief The predicates over columns of positions, writing 1 or 0 per position to out. Candidate areas
+     * are tested with an equirectangular distance, and with haversine only near the threshold, so the
+     * results equal those of the per-position functions.
+     */
+    void intersectsArea(const double* longitudes, const double* latitudes, size_t count, double* out) const;
+    void withinDistance(const double* longitudes, const double* latitudes, size_t count, double slackMeters, double* out) const;
+    void atSTBox(const double* longitudes, const double* latitudes, const double* timestamps, size_t count, double* out) const;
+
+    const std::vector<HighRiskArea>& getAreas() const;
+    double getAreaRadiusMeters() const;
+    double getWithinDistanceMeters() const;
+    const STBox& getBox() const;
+
+    /** @brief Great-circle distance in meters. */
+    static double haversineMeters(double longitude1, double latitude1, double longitude2, double latitude2);
+
+    /** @brief Number of grid cells and area entries in them, for sizing the index. */
+    size_t getNumberOfCells() const;
+    size_t getNumberOfCellEntries() const;
+
+  private:
+    static constexpr size_t noCell = std::numeric_limits<size_t>::max();
+
+    void buildGrid();
+    size_t findCell(double longitude, double latitude) const;
+    bool anyAreaWithin(double longitude, double latitude, double meters) const;
+    bool anyAreaInCell(size_t cell, double longitude, double latitude, double meters) const;
+    void anyAreaWithin(const double* longitudes, const double* latitudes, size_t count, double meters, double* out) const;
+
+    std::vector<HighRiskArea> areas;
+    double areaRadiusMeters = 500.0;
+    double withinDistanceMeters = 1000.0;
+    STBox box;
+
+    // Grid in degrees over the bounding boxes of the areas' discs of the larger distance; a cell lists
+    // every area whose disc overlaps it, the areas of cell c are cellAreas[cellOffsets[c], cellOffsets[c + 1])
+    double gridMeters = 0;
+    double gridMinLongitude = 0;
+    double gridMinLatitude = 0;
+    double cellLongitudeDegrees = 1;
+    double cellLatitudeDegrees = 1;
+    size_t gridColumns = 0;
+    size_t gridRows = 0;
+    // Some disc crosses the antimeridian, so positions are also looked up shifted by 360 degrees
+    bool wrapsLongitude = false;
+    std::vector<uint32_t> cellOffsets;
+    std::vector<uint32_t> cellAreas;
+    // Meters per degree of longitude at each area, for the equirectangular distance, and the largest
+    // distance for which that distance is within equirectangularTolerance of haversine
+    std::vector<double> areaMetersPerLongitude;
+    double equirectangularMeters = 0;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_GEOCONTEXT_HPP_
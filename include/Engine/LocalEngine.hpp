@@ -0,0 +1,191 @@
+#ifndef SNCB_ENGINE_LOCALENGINE_HPP_
+#define SNCB_ENGINE_LOCALENGINE_HPP_
+
+#include <Engine/DataSource.hpp>
+#include <Engine/GeoContext.hpp>
+#include <Engine/Operators.hpp>
+#include <Engine/Query.hpp>
+#include <Engine/SourceCatalog.hpp>
+
+#include <Util/LatencyHistogram.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SNCB::Engine {
+
+enum class QueryStatus { Registered, Running, Stopped, Failed };
+
+/** @brief Status names as the coordinator reports them, e.g. "RUNNING". */
+std::string toString(QueryStatus status);
+
+struct QueryStatistics {
+    uint64_t inputTuples = 0;
+    uint64_t outputTuples = 0;
+    // Bytes the source stores per tuple, only for the fields the query reads
+    size_t inputTupleSize = 0;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point endTime;
+    // Nanoseconds from ingestion to the sink per result, with latency tracking; taken when the query ended
+    Util::LatencyHistogram latencies;
+
+    double getExecutionSeconds() const;
+};
+
+/**
+ * @brief Single-process stand-in for coordinator and worker: runs queries built with the Engine query
+ * API against the CSV files of the worker configuration, their columnar copies, or synthetic trains of an
+ * SncbGenerator. Queries submitted
+ * together on the same source run as one group on one thread that scans the source once. Sources are
+ * read as fast as possible unless the catalog sets a replay for them (ReplaySource); gatheringInterval
+ * pacing of the worker configuration is not applied. Sources read by joins are never paced.
+ */
+class LocalEngine {
+  public:
+    LocalEngine(SourceCatalog catalog, std::shared_ptr<const GeoContext> geo);
+    ~LocalEngine();
+
+    LocalEngine(const LocalEngine&) = delete;
+    LocalEngine& operator=(const LocalEngine&) = delete;
+
+    /**
+     * @brief Builds the query's pipeline and starts it.
+     * @throws std::invalid_argument if the query references unknown sources or fields
+     */
+    uint64_t submitQuery(const Query& query);
+
+    /**
+     * @brief Builds and starts several queries, returning their ids in order. With sharing, queries on the
+     * same source share one scan, and queries that begin with the same tumbling or sliding window (time
+     * field, size and slide) share its slices and aggregates, which fan out to each query's remaining
+     * operators. Without sharing every query runs on its own, like submitQuery.
+     * @throws std::invalid_argument if a query references unknown sources or fields
+     */
+    std::vector<uint64_t> submitQueries(const std::vector<Query>& queries, bool share = true);
+
+    QueryStatus getQueryStatus(uint64_t queryId) const;
+
+    /**
+     * @brief Stops a running query, flushing its open windows; returns false for unknown ids. Windows a
+     * query shares with other queries keep running for them and are not flushed.
+     */
+    bool stopQuery(uint64_t queryId);
+
+    /** @brief Waits until the query consumed its sources or was stopped, or the timeout passed. */
+    QueryStatus waitForQuery(uint64_t queryId, std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+    QueryStatistics getStatistics(uint64_t queryId) const;
+    std::string getError(uint64_t queryId) const;
+
+    const SourceCatalog& getCatalog() const;
+
+    /**
+     * @brief Stamps every buffer with the time it left its source, for queries submitted afterwards. Window
+     * results carry the latest stamp of their tuples and sinks record the time from it to the result, see
+     * QueryStatistics::latencies. Windows then emit a buffer per distinct stamp.
+     */
+    void setLatencyTracking(bool enabled);
+
+    /**
+     * @brief Lets at most n groups execute their pipelines at once, like the worker threads of a NES node,
+     * for queries submitted afterwards; 0 lifts the limit. Groups still read their sources concurrently.
+     */
+    void setWorkerThreads(size_t n);
+
+    /**
+     * @brief Translates a query into a chain of executable operators that ends in its sink.
+     * @param capacity tuples per buffer of the operators' output buffers
+     * @param catalog sources of the queries the query joins with, needed only if it joins
+     * @param dropDeadMaps leave out maps whose field is never read, see compileChain; off only to check that
+     */
+    static std::unique_ptr<ExecutableOperator> compile(const Query& query, const SchemaPtr& sourceSchema,
+                                                       const GeoContext* geo, size_t capacity,
+                                                       const SourceCatalog* catalog = nullptr, bool dropDeadMaps = true);
+
+    /**
+     * @brief The source fields the query reads, in source order. Fields that only reach the sink through
+     * the query are read as well, unless a projection or window drops them before.
+     * @param dropDeadMaps as for compile; without, also the fields of maps compile leaves out are read
+     */
+    static SchemaPtr getReadSchema(const Query& query, const SchemaPtr& sourceSchema, bool dropDeadMaps = true);
+
+  private:
+    struct QueryGroup;
+
+    struct RunningQuery {
+        QueryGroup* group = nullptr;
+        // Fan-out that feeds the query's branch, and the branch itself
+        FanOutExecutable* owner = nullptr;
+        const ExecutableOperator* branch = nullptr;
+        const FileSink* sink = nullptr;
+        // Only touched by the group's thread: still fed by its fan-out
+        bool attached = true;
+        std::atomic<QueryStatus> status{QueryStatus::Registered};
+        std::atomic<bool> stopRequested{false};
+        std::atomic<uint64_t> inputTuples{0};
+        std::atomic<uint64_t> outputTuples{0};
+        std::chrono::steady_clock::time_point startTime;
+        std::chrono::steady_clock::time_point endTime;
+        Util::LatencyHistogram latencies;
+        std::string error;
+    };
+
+    /** @brief Queries that read one scan of a source, each on its own branch of the group's fan-out. */
+    struct QueryGroup {
+        std::unique_ptr<FanOutExecutable> pipeline;
+        std::unique_ptr<DataSource> source;
+        SchemaPtr readSchema;
+        size_t tuplesPerBuffer = 0;
+        std::vector<RunningQuery*> members;
+        bool trackLatency = false;
+        // Shared by the groups of one setWorkerThreads limit, nullptr without one
+        std::shared_ptr<std::counting_semaphore<>> workerSlots;
+        std::thread thread;
+    };
+
+    /** @brief Compiles the queries, all on the same source, into one group and adds their branches to it. */
+    std::unique_ptr<QueryGroup> buildGroup(const std::vector<const Query*>& groupQueries,
+                                           std::vector<std::unique_ptr<RunningQuery>>& members) const;
+    /**
+     * @brief Chain of the operators from first on, ending in the sink if given; nullptr if it is empty. Maps
+     * whose field no later operator reads before a projection, a window or a map of the field that keeps its type
+     * drops it are left out.
+     */
+    static std::unique_ptr<ExecutableOperator> compileChain(const std::vector<LogicalOperator>& operators, size_t first,
+                                                            SchemaPtr schema, const SinkDescriptor* sink,
+                                                            const GeoContext* geo, size_t capacity,
+                                                            const SourceCatalog* catalog, bool dropDeadMaps = true);
+    static std::unique_ptr<ExecutableOperator> compileJoin(const JoinOperator& join, const SchemaPtr& schema,
+                                                           const GeoContext* geo, size_t capacity, const SourceCatalog* catalog);
+    static std::unique_ptr<DataSource> openSource(const SourceCatalog& catalog, const std::string& sourceName,
+                                                  const SchemaPtr& readSchema, size_t tuplesPerBuffer);
+    static const FileSink* findSink(const ExecutableOperator* branch);
+
+    void run(QueryGroup& group);
+    void detach(RunningQuery& query);
+    RunningQuery& getQuery(uint64_t queryId) const;
+
+    SourceCatalog catalog;
+    std::shared_ptr<const GeoContext> geo;
+    std::map<uint64_t, std::unique_ptr<RunningQuery>> queries;
+    std::vector<std::unique_ptr<QueryGroup>> groups;
+    mutable std::mutex mutex;
+    std::condition_variable queryFinished;
+    uint64_t nextQueryId = 1;
+    bool trackLatency = false;
+    std::shared_ptr<std::counting_semaphore<>> workerSlots;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_LOCALENGINE_HPP_
@@ -0,0 +1,370 @@
+#ifndef SNCB_ENGINE_OPERATORS_HPP_
+#define SNCB_ENGINE_OPERATORS_HPP_
+
+#include <Engine/Aggregation.hpp>
+#include <Engine/DataSource.hpp>
+#include <Engine/Expressions.hpp>
+#include <Engine/Query.hpp>
+#include <Engine/SliceArena.hpp>
+#include <Engine/SlidingAggregator.hpp>
+#include <Engine/TupleBuffer.hpp>
+#include <Engine/Windowing.hpp>
+
+#include <Util/LatencyHistogram.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/**
+ * @brief Physical operator of a push-based pipeline. Each operator processes a buffer and hands its
+ * result buffer to the next one; finish() is called once at the end of the stream to flush state.
+ */
+class ExecutableOperator {
+  public:
+    explicit ExecutableOperator(SchemaPtr outputSchema);
+    virtual ~ExecutableOperator() = default;
+
+    virtual void execute(TupleBuffer& buffer) = 0;
+    virtual void finish();
+
+    /** @brief True if execute() changes the buffer it receives instead of emitting its own. */
+    virtual bool modifiesInput() const;
+
+    void setNext(std::unique_ptr<ExecutableOperator> next);
+    ExecutableOperator* getNext() const;
+    const SchemaPtr& getOutputSchema() const;
+
+  protected:
+    void emit(TupleBuffer& buffer);
+
+    SchemaPtr outputSchema;
+    std::unique_ptr<ExecutableOperator> next;
+};
+
+/** @brief Evaluates its predicate batch-wise into a selection and gathers the selected rows. */
+class FilterExecutable : public ExecutableOperator {
+  public:
+    FilterExecutable(const ExpressionNodePtr& predicate, SchemaPtr inputSchema, const GeoContext* geo, size_t capacity);
+    void execute(TupleBuffer& buffer) override;
+
+  private:
+    CompiledExpression predicate;
+    std::vector<uint32_t> selection;
+    TupleBuffer output;
+};
+
+/** @brief Writes an expression into an existing field in place, or appends it as a new field. */
+class MapExecutable : public ExecutableOperator {
+  public:
+    MapExecutable(const std::string& field, const ExpressionNodePtr& value, const SchemaPtr& inputSchema,
+                  const GeoContext* geo, size_t capacity);
+    void execute(TupleBuffer& buffer) override;
+    bool modifiesInput() const override;
+
+  private:
+    static SchemaPtr outputSchemaOf(const std::string& field, const ExpressionNodePtr& value, const SchemaPtr& inputSchema,
+                                    const GeoContext* geo);
+    void storeBatch(const TupleBuffer& input, TupleBuffer& target, size_t inputRow, size_t targetRow, size_t count);
+
+    CompiledExpression value;
+    size_t targetField;
+    bool inPlace;
+    std::optional<TupleBuffer> output;
+};
+
+class ProjectExecutable : public ExecutableOperator {
+  public:
+    ProjectExecutable(const std::vector<std::string>& fields, const SchemaPtr& inputSchema, size_t capacity);
+    /** @brief Projects the fields and renames them to outputNames, one name per field. */
+    ProjectExecutable(const std::vector<std::string>& fields, const std::vector<std::string>& outputNames,
+                      const SchemaPtr& inputSchema, size_t capacity);
+    void execute(TupleBuffer& buffer) override;
+
+  private:
+    std::vector<size_t> sourceFields;
+    TupleBuffer output;
+};
+
+/**
+ * @brief Partial aggregation before a tumbling time window: folds the tuples of every slice into one row of
+ * partialSchema() with the slice, its latest timestamp and ingestion time, its tuples and the state of every
+ * aggregation, for the TimeWindowExecutable that combines them, as if shipped to it from next to the source.
+ * A slice stays open until the largest timestamp seen reaches its end, so out-of-order tuples still fold into
+ * its one row and floating-point sums add up in arrival order as in the window; tuples of a slice that ended are
+ * late and dropped, as the window would. Every buffer ends with a row without tuples that passes on the largest
+ * timestamp, so the windows close with the same buffer as without partials. With 500 ms slices the window
+ * receives one row per slice and one per buffer instead of every tuple.
+ */
+class SlicePreAggregationExecutable : public ExecutableOperator {
+  public:
+    // Fields of a partial row; aggregation i stores its value at ValueField + 2 * i and its count after it
+    enum PartialField : size_t { SliceField, MaxTimeField, IngestionTimeField, TuplesField, ValueField };
+
+    SlicePreAggregationExecutable(const WindowOperator& window, const SchemaPtr& inputSchema, const GeoContext* geo,
+                                  size_t capacity);
+    void execute(TupleBuffer& buffer) override;
+    void finish() override;
+
+    static SchemaPtr partialSchema(size_t numberOfAggregations);
+
+  private:
+    struct OpenSlice {
+        uint64_t maxTime = 0;
+        uint64_t ingestionTime = 0;
+        uint64_t tuples = 0;
+        std::vector<AggregateValue> values;
+    };
+
+    // Passes on the open slices that end at or before the given time, all of them without
+    void passSlices(std::optional<uint64_t> until);
+    void appendRow(uint64_t slice, const OpenSlice& partial);
+
+    size_t timeField;
+    bool floatingTime;
+    uint64_t sliceSize;
+    std::vector<AggregationFunction> aggregations;
+    // Inputs of the aggregations, none for Count
+    std::vector<std::optional<CompiledExpression>> inputs;
+    // Slices whose end the watermark has not reached, by start
+    std::map<uint64_t, OpenSlice> openSlices;
+    // The open slice of the last tuple, as consecutive tuples mostly share it
+    OpenSlice* lastSlice = nullptr;
+    uint64_t lastSliceStart = 0;
+    uint64_t watermark = 0;
+    TupleBuffer output;
+};
+
+/**
+ * @brief Tumbling and sliding event-time windows on slices: time is cut into slices of gcd(size, slide),
+ * every tuple updates only its slice, and a window is the aggregate of the slices it covers, taken from
+ * a two-stacks aggregator. Updates cost O(1) per tuple however many windows overlap. A window is emitted
+ * as (start, end, aggregates...) once the largest timestamp seen reaches its end, if it holds tuples.
+ */
+class TimeWindowExecutable : public ExecutableOperator {
+  public:
+    /**
+     * @param inputSchema schema of the tuples the window aggregates
+     * @param partialInput receive the partials of a SlicePreAggregationExecutable on these tuples instead
+     */
+    TimeWindowExecutable(const WindowOperator& window, const SchemaPtr& inputSchema, const GeoContext* geo, size_t capacity,
+                         bool partialInput = false);
+    void execute(TupleBuffer& buffer) override;
+    void finish() override;
+
+    /** @brief Allocations of the slices so far. */
+    const ArenaStatistics& getArenaStatistics() const;
+
+  private:
+    /** @brief The slice a tuple of this time updates; nullptr if the tuple is late. */
+    Partial* findSlice(uint64_t timestamp);
+    void addTuple(const TupleBuffer& buffer, size_t row, uint64_t timestamp);
+    void addPartials(const TupleBuffer& buffer);
+    void trigger(uint64_t until);
+    // Start of the first window whose end lies after the given time
+    uint64_t firstWindowEndingAfter(uint64_t timestamp) const;
+    void emitWindow(uint64_t start, const Partial& window);
+
+    size_t timeField;
+    bool floatingTime;
+    bool partialInput;
+    uint64_t size;
+    uint64_t slide;
+    uint64_t sliceSize;
+    std::vector<AggregationFunction> aggregations;
+    // Holds the slices below and the aggregates copied from them, so it is declared before them
+    SliceArena arena;
+    // Slices that no emitted window needed yet, and the slices of the next windows
+    std::map<uint64_t, Partial, std::less<>, ArenaAllocator<std::pair<const uint64_t, Partial>>> pendingSlices;
+    TwoStacksAggregator windowSlices;
+    // Start of the next window to emit, if any tuple arrived
+    std::optional<uint64_t> nextWindowStart;
+    uint64_t watermark = 0;
+    Partial windowState;
+    // Partial row being combined
+    Partial partial;
+    TupleBuffer output;
+};
+
+/**
+ * @brief Threshold window: opens with the first tuple that satisfies the predicate, aggregates while it
+ * holds and emits the aggregates when it stops holding, if the window saw at least minCount tuples. With
+ * a maximum duration, a window open that long is emitted and the next tuple opens a new one. Closed windows
+ * leave with the buffer that closed them.
+ */
+class ThresholdWindowExecutable : public ExecutableOperator {
+  public:
+    /**
+     * @param filter predicate of a filter right before the window, evaluated here so the tuples it selects
+     * are not gathered into a buffer of their own, or nullptr
+     */
+    ThresholdWindowExecutable(const WindowOperator& window, const SchemaPtr& inputSchema, const GeoContext* geo,
+                              size_t capacity, const ExpressionNodePtr& filter = nullptr);
+    void execute(TupleBuffer& buffer) override;
+    void finish() override;
+
+  private:
+    void addTuple(const TupleBuffer& buffer, size_t row);
+    void close();
+
+    std::optional<CompiledExpression> filter;
+    CompiledExpression predicate;
+    uint64_t minCount;
+    uint64_t maxDuration;
+    std::optional<size_t> timeField;
+    bool floatingTime = false;
+    std::vector<AggregationFunction> aggregations;
+    std::vector<AggregateValue> states;
+    uint64_t tuplesInWindow = 0;
+    uint64_t windowIngestionTime = 0;
+    uint64_t windowStart = 0;
+    bool open = false;
+    std::vector<uint32_t> selection;
+    TupleBuffer output;
+};
+
+/**
+ * @brief Streaming join with a slower right stream, see Query::joinLatestWithin. The right source is
+ * read on demand through the right query's operators until its timestamps pass the left tuple's, and
+ * right tuples stay in time order only while they can still match, so the state holds maxAge of the
+ * right stream plus at most one buffer read ahead.
+ */
+class LatestWithinJoinExecutable : public ExecutableOperator {
+  public:
+    /**
+     * @param rightPipeline operators of the right query, applied to the buffers of rightSource, or nullptr
+     * @param rightSchema output schema of rightPipeline, or rightReadSchema without one
+     * @throws std::invalid_argument if a join field is missing, a time field is no UINT64 or both sides share a field
+     */
+    LatestWithinJoinExecutable(const LatestWithinJoin& condition, const SchemaPtr& inputSchema,
+                               std::unique_ptr<DataSource> rightSource, SchemaPtr rightReadSchema, size_t rightTuplesPerBuffer,
+                               std::unique_ptr<ExecutableOperator> rightPipeline, const SchemaPtr& rightSchema, size_t capacity);
+    void execute(TupleBuffer& buffer) override;
+
+  private:
+    class RightSink;
+
+    struct RightTuple {
+        uint64_t timestamp;
+        double longitude;
+        double latitude;
+        std::vector<uint64_t> values;
+    };
+
+    static SchemaPtr joinSchema(const Schema& left, const Schema& right);
+    void insert(const TupleBuffer& buffer);
+    // Reads the right stream until a tuple after the timestamp arrived or it ended
+    void advance(uint64_t timestamp);
+    const RightTuple* findMatch(uint64_t timestamp, double longitude, double latitude) const;
+
+    size_t leftTime;
+    size_t leftLongitude;
+    size_t leftLatitude;
+    size_t rightTime;
+    size_t rightLongitude;
+    size_t rightLatitude;
+    double radiusMeters;
+    uint64_t maxAge;
+    std::unique_ptr<DataSource> rightSource;
+    TupleBuffer rightBuffer;
+    std::unique_ptr<ExecutableOperator> rightPipeline;
+    bool rightExhausted = false;
+    // Largest right timestamp read so far, and largest left timestamp joined
+    uint64_t rightWatermark = 0;
+    uint64_t leftWatermark = 0;
+    std::deque<RightTuple> state;
+    TupleBuffer output;
+};
+
+/**
+ * @brief Hands every buffer to several branches, e.g. the pipelines of queries that share a source scan
+ * or a window. Branches that modify their input get a copy, so all branches see the same tuples.
+ */
+class FanOutExecutable : public ExecutableOperator {
+  public:
+    FanOutExecutable(SchemaPtr schema, size_t capacity);
+
+    void execute(TupleBuffer& buffer) override;
+    void finish() override;
+
+    /** @brief Adds a branch and returns it. */
+    ExecutableOperator* addBranch(std::unique_ptr<ExecutableOperator> branch);
+    /** @brief Finishes a branch, flushing its state, and hands it back; it is not fed anymore. */
+    std::unique_ptr<ExecutableOperator> detachBranch(const ExecutableOperator* branch);
+    size_t getNumberOfBranches() const;
+
+  private:
+    std::vector<std::unique_ptr<ExecutableOperator>> branches;
+    TupleBuffer copy;
+};
+
+/** @brief Last operator of a query, writes its results to the file of the sink descriptor. */
+class FileSink : public ExecutableOperator {
+  public:
+    using ExecutableOperator::ExecutableOperator;
+
+    /** @brief Creates the sink of the descriptor's format. */
+    static std::unique_ptr<FileSink> create(const SinkDescriptor& descriptor, SchemaPtr inputSchema);
+
+    uint64_t getWrittenTuples() const;
+    /** @brief Nanoseconds from ingestion to the sink of every result whose buffer carried an ingestion time. */
+    const Util::LatencyHistogram& getLatencies() const;
+
+  protected:
+    void recordLatencies(const TupleBuffer& buffer);
+
+    uint64_t writtenTuples = 0;
+    Util::LatencyHistogram latencies;
+};
+
+/** @brief Appends the tuples it receives to a CSV file, with a header line if the file is new. */
+class CsvFileSink : public FileSink {
+  public:
+    /** @throws std::runtime_error if the file cannot be opened */
+    CsvFileSink(const SinkDescriptor& descriptor, SchemaPtr inputSchema);
+    ~CsvFileSink() override;
+
+    void execute(TupleBuffer& buffer) override;
+    void finish() override;
+
+  private:
+    std::FILE* file;
+    std::string line;
+};
+
+/**
+ * @brief Appends the tuples it receives to a BINARY_FORMAT file, see BinarySinkFormat. Tuples are
+ * collected into blocks of BlockTuples and written once WriteBytes are encoded, and at finish().
+ */
+class BinaryFileSink : public FileSink {
+  public:
+    static constexpr size_t BlockTuples = 4096;
+    static constexpr size_t WriteBytes = 1 << 20;
+
+    /** @throws std::runtime_error if the file cannot be opened or holds another schema */
+    BinaryFileSink(const SinkDescriptor& descriptor, SchemaPtr inputSchema);
+    ~BinaryFileSink() override;
+
+    void execute(TupleBuffer& buffer) override;
+    void finish() override;
+
+  private:
+    void encodePending();
+    void write();
+
+    std::FILE* file;
+    TupleBuffer pending;
+    std::string encoded;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_OPERATORS_HPP_
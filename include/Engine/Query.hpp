@@ -0,0 +1,136 @@
+#ifndef SNCB_ENGINE_QUERY_HPP_
+#define SNCB_ENGINE_QUERY_HPP_
+
+#include <Engine/Expressions.hpp>
+#include <Engine/Windowing.hpp>
+
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/**
+ * @brief File sink, created like NES' FileSinkDescriptor::create(path, "CSV_FORMAT", "APPEND"). The local
+ * engine also writes "BINARY_FORMAT", see BinarySinkFormat.
+ */
+struct SinkDescriptor {
+    std::string filePath;
+    std::string format = "CSV_FORMAT";
+    bool append = true;
+};
+using SinkDescriptorPtr = std::shared_ptr<const SinkDescriptor>;
+
+class FileSinkDescriptor {
+  public:
+    /** @throws std::invalid_argument for formats other than CSV_FORMAT/BINARY_FORMAT and modes other than APPEND/OVERWRITE */
+    static SinkDescriptorPtr create(const std::string& filePath, const std::string& format = "CSV_FORMAT",
+                                    const std::string& mode = "APPEND");
+};
+
+struct FilterOperator {
+    ExpressionNodePtr predicate;
+};
+
+struct MapOperator {
+    std::string field;
+    ExpressionNodePtr value;
+};
+
+struct ProjectOperator {
+    std::vector<std::string> fields;
+};
+
+struct WindowOperator {
+    WindowTypePtr window;
+    std::vector<WindowAggregationPtr> aggregations;
+};
+
+class Query;
+
+/** @brief Fields and bounds of Query::joinLatestWithin; the time fields must be UINT64. */
+struct LatestWithinJoin {
+    std::string leftTime = "timestamp";
+    std::string leftLongitude = "longitude";
+    std::string leftLatitude = "latitude";
+    std::string rightTime = "timestamp";
+    std::string rightLongitude = "longitude";
+    std::string rightLatitude = "latitude";
+    double radiusMeters = 0.0;
+    // Oldest right tuple a left tuple is joined with, in units of the time fields
+    uint64_t maxAge = 0;
+};
+
+struct JoinOperator {
+    std::shared_ptr<const Query> right;
+    LatestWithinJoin condition;
+};
+
+/** @brief One step of a query's operator chain, in the order the query applies them. */
+using LogicalOperator = std::variant<FilterOperator, MapOperator, ProjectOperator, WindowOperator, JoinOperator>;
+
+class WindowedQuery;
+
+/** @brief Query built with the NES query API subset the SNCB drivers use, executed by the LocalEngine. */
+class Query {
+  public:
+    static Query from(const std::string& sourceName);
+
+    Query& filter(const ExpressionItem& predicate);
+    Query& map(const FieldAssignment& assignment);
+    template<typename... Fields>
+    Query& project(const Fields&... fields) {
+        return projectFields({ExpressionItem(fields)...});
+    }
+    /** @brief project() with fields only known at run time, e.g. from parseQuery. */
+    Query& project(const std::vector<ExpressionItem>& fields);
+    WindowedQuery window(WindowTypePtr window);
+
+    /**
+     * @brief Streaming join with a slower stream, e.g. hourly weather: every tuple is extended with the
+     * fields of the most recent tuple of the right query that is at most maxAge older and lies within
+     * radiusMeters, and dropped if there is none. Both streams must arrive ordered by time; the right one
+     * is read only as far as the left one got. The right query has no sink and its field names must
+     * differ from this query's.
+     */
+    Query& joinLatestWithin(const Query& right, LatestWithinJoin condition);
+
+    Query& sink(SinkDescriptorPtr sink);
+
+    const std::string& getSourceName() const;
+    const std::vector<LogicalOperator>& getOperators() const;
+    const SinkDescriptorPtr& getSink() const;
+
+  private:
+    friend class WindowedQuery;
+    explicit Query(std::string sourceName);
+    Query& projectFields(const std::vector<ExpressionItem>& fields);
+
+    std::string sourceName;
+    std::vector<LogicalOperator> operators;
+    SinkDescriptorPtr sinkDescriptor;
+};
+
+/** @brief Query whose last step is a window that still needs its aggregations. */
+class WindowedQuery {
+  public:
+    WindowedQuery(Query query, WindowTypePtr window);
+
+    template<typename... Aggregations>
+    Query apply(Aggregations... aggregations) {
+        return applyAggregations({std::move(aggregations)...});
+    }
+    /** @brief apply() with aggregations only known at run time, e.g. from parseQuery. */
+    Query apply(std::vector<WindowAggregationPtr> aggregations);
+
+  private:
+    Query applyAggregations(std::vector<WindowAggregationPtr> aggregations);
+
+    Query query;
+    WindowTypePtr window;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_QUERY_HPP_
@@ -0,0 +1,21 @@
+#ifndef SNCB_ENGINE_QUERYPARSER_HPP_
+#define SNCB_ENGINE_QUERYPARSER_HPP_
+
+#include <Engine/Query.hpp>
+
+#include <string>
+
+namespace SNCB::Engine {
+
+/**
+ * @brief Builds a query from its source text in the NES C++ query API, e.g. the `query` entries of the e2e
+ * configurations: Query::from(...) followed by filter, map, project, window(...).apply(...) and sink calls,
+ * with the expressions, windows and aggregations the Engine query API supports. NullOutputSinkDescriptor
+ * and PrintSinkDescriptor become CSV sinks to /dev/null, so results are still formatted but not kept.
+ * @throws std::invalid_argument with the offset of the first token that cannot be parsed
+ */
+Query parseQuery(const std::string& text);
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_QUERYPARSER_HPP_
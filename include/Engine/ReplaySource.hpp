@@ -0,0 +1,64 @@
+#ifndef SNCB_ENGINE_REPLAYSOURCE_HPP_
+#define SNCB_ENGINE_REPLAYSOURCE_HPP_
+
+#include <Engine/DataSource.hpp>
+#include <Engine/SourceCatalog.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+
+namespace SNCB::Engine {
+
+/**
+ * @brief Replays another source for load tests: at a target rate, with event time compressed by a
+ * speedup, or both (the later deadline wins), and with every tuple multiplied into several trains.
+ * A buffer holds the tuples due within BatchWindow of its first one and is released at the deadline of
+ * its last, waiting on a timerfd until SpinWindow before it and spinning for the rest. A consumer that
+ * cannot keep up makes the source fall behind schedule; it then produces without waiting, so the
+ * measured tuples/s fall below the target.
+ */
+class ReplaySource : public DataSource {
+  public:
+    static constexpr std::chrono::microseconds BatchWindow{1000};
+    static constexpr std::chrono::microseconds SpinWindow{100};
+
+    /**
+     * @param schema fields of the source's buffers; id, latitude and longitude are changed in copies if present
+     * @throws std::invalid_argument if a speedup is set and the schema lacks the time field, or a buffer
+     * cannot hold all copies of a tuple
+     * @throws std::runtime_error if no timer can be created
+     */
+    ReplaySource(std::unique_ptr<DataSource> source, SchemaPtr schema, size_t tuplesPerBuffer, ReplayConfig config);
+    ~ReplaySource() override;
+
+    /** @brief Fills the buffer, an owning buffer of the source's schema, and waits until it is due. */
+    bool fillBuffer(TupleBuffer& buffer) override;
+    uint64_t getProducedTuples() const override;
+
+  private:
+    // Time after the start at which the tuple at this row of the input is due, as the first of its copies
+    std::chrono::nanoseconds deadlineOf(size_t inputRow, uint64_t produced) const;
+    void waitUntil(std::chrono::steady_clock::time_point deadline) const;
+    void multiply(TupleBuffer& buffer, size_t count);
+
+    std::unique_ptr<DataSource> source;
+    ReplayConfig config;
+    TupleBuffer input;
+    size_t row = 0;
+    std::optional<size_t> timeField;
+    std::optional<size_t> idField;
+    std::optional<size_t> latitudeField;
+    std::optional<size_t> longitudeField;
+    std::optional<uint64_t> firstTimestamp;
+    std::optional<std::chrono::steady_clock::time_point> start;
+    std::mt19937_64 random;
+    int timer = -1;
+    uint64_t producedTuples = 0;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_REPLAYSOURCE_HPP_
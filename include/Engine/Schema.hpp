@@ -0,0 +1,69 @@
+#ifndef SNCB_ENGINE_SCHEMA_HPP_
+#define SNCB_ENGINE_SCHEMA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/** @brief Physical types of the SNCB sources. Every value occupies one 8 byte slot. */
+enum class DataType { UINT64, FLOAT64, BOOLEAN };
+
+/** @brief NES spelling of the types, so query definitions read the same as for the coordinator. */
+namespace BasicType {
+constexpr DataType UINT64 = DataType::UINT64;
+constexpr DataType FLOAT64 = DataType::FLOAT64;
+constexpr DataType BOOLEAN = DataType::BOOLEAN;
+}// namespace BasicType
+
+/** @throws std::invalid_argument for names other than UINT64, FLOAT64 and BOOLEAN */
+DataType parseDataType(const std::string& name);
+std::string toString(DataType type);
+
+/** @brief Code of a type in the binary file formats: 0 UINT64, 1 FLOAT64, 2 BOOLEAN. */
+uint8_t toTypeCode(DataType type);
+/** @brief Type of a code, none for unknown codes. */
+std::optional<DataType> fromTypeCode(uint8_t code);
+
+struct Field {
+    std::string name;
+    DataType type;
+};
+
+class Schema;
+using SchemaPtr = std::shared_ptr<const Schema>;
+
+/** @brief Ordered list of named, typed fields of a stream. */
+class Schema {
+  public:
+    Schema() = default;
+    explicit Schema(std::vector<Field> fields);
+
+    Schema& addField(const std::string& name, DataType type);
+
+    size_t size() const;
+    const Field& getField(size_t index) const;
+    const std::vector<Field>& getFields() const;
+
+    /** @throws std::invalid_argument if the schema has no such field */
+    size_t getIndex(const std::string& name) const;
+    std::optional<size_t> findIndex(const std::string& name) const;
+    bool contains(const std::string& name) const;
+
+    /** @brief Bytes of one tuple, one 8 byte slot per field. */
+    size_t getTupleSize() const;
+
+    /** @brief Comma separated "name:TYPE" list for log output. */
+    std::string toString() const;
+
+  private:
+    std::vector<Field> fields;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_SCHEMA_HPP_
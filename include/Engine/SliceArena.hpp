@@ -0,0 +1,108 @@
+#ifndef SNCB_ENGINE_SLICEARENA_HPP_
+#define SNCB_ENGINE_SLICEARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace SNCB::Engine {
+
+struct ArenaStatistics {
+    // Records handed out, and how many of them were released ones handed out again
+    uint64_t allocations = 0;
+    uint64_t reuses = 0;
+    uint64_t liveRecords = 0;
+    uint64_t peakLiveRecords = 0;
+    // Slabs taken from the heap, the only heap allocations of the arena, and their bytes
+    uint64_t slabs = 0;
+    uint64_t reservedBytes = 0;
+};
+
+/**
+ * @brief Slab allocator for the records a window keeps per slice: its aggregate values, the node of its
+ * pending slice and the entries of its two-stacks aggregator. Every record size gets its own pool that cuts
+ * slabs of SlabBytes into records; a released record goes on the free list of its pool and is handed out
+ * again before the slab is cut further. Once the window holds its largest number of slices, slices that the
+ * watermark retires supply the records of the new ones, so the heap is no longer called and the memory of
+ * the window stays flat however long the stream runs. Slabs are returned to the heap with the arena.
+ */
+class SliceArena {
+  public:
+    static constexpr size_t SlabBytes = 16 * 1024;
+
+    SliceArena() = default;
+    SliceArena(const SliceArena&) = delete;
+    SliceArena& operator=(const SliceArena&) = delete;
+
+    void* allocate(size_t bytes);
+    /** @brief Puts a record back on the free list; bytes must be the size it was allocated with. */
+    void release(void* record, size_t bytes);
+
+    const ArenaStatistics& getStatistics() const;
+
+  private:
+    struct FreeRecord {
+        FreeRecord* next;
+    };
+
+    struct Pool {
+        size_t recordSize;
+        FreeRecord* freeList = nullptr;
+        // Part of the last slab not cut into records yet
+        std::byte* cursor = nullptr;
+        std::byte* end = nullptr;
+    };
+
+    Pool& poolOf(size_t bytes);
+
+    // Few sizes per window, so a linear search beats any map
+    std::vector<Pool> pools;
+    std::vector<std::unique_ptr<std::byte[]>> slabs;
+    ArenaStatistics statistics;
+};
+
+/**
+ * @brief Allocator for standard containers on a SliceArena, or on the heap without one. Copies and moves of
+ * a container take its arena along, so a slice copied into the two-stacks aggregator stays in the arena.
+ */
+template<typename T>
+class ArenaAllocator {
+  public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() = default;
+    explicit ArenaAllocator(SliceArena* arena) : arena(arena) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.getArena()) {}
+
+    T* allocate(size_t n) {
+        return arena != nullptr ? static_cast<T*>(arena->allocate(n * sizeof(T))) : std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* pointer, size_t n) {
+        if (arena != nullptr) {
+            arena->release(pointer, n * sizeof(T));
+        } else {
+            std::allocator<T>().deallocate(pointer, n);
+        }
+    }
+
+    SliceArena* getArena() const { return arena; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return arena == other.getArena();
+    }
+
+  private:
+    SliceArena* arena = nullptr;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_SLICEARENA_HPP_
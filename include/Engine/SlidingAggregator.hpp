@@ -0,0 +1,75 @@
+#ifndef SNCB_ENGINE_SLIDINGAGGREGATOR_HPP_
+#define SNCB_ENGINE_SLIDINGAGGREGATOR_HPP_
+
+#include <Engine/Aggregation.hpp>
+#include <Engine/SliceArena.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/** @brief Aggregates of the tuples of one slice, or of a run of consecutive slices. */
+struct Partial {
+    uint64_t tuples = 0;
+    // Latest ingestion time of the tuples, see TupleBuffer::getIngestionTime
+    uint64_t ingestionTime = 0;
+    std::vector<AggregateValue, ArenaAllocator<AggregateValue>> values;
+};
+
+/**
+ * @brief FIFO of slices that yields the aggregate over all queued slices in amortised O(1) per push and
+ * evict, also for aggregations without an inverse such as Min and Max. Two stacks: the front stack keeps
+ * for every slice the aggregate of it and all slices behind it up to the back stack, the back stack
+ * keeps only its running aggregate. When the front stack runs empty, the back stack is flipped over.
+ * With an arena, the queued slices and their aggregates live in it.
+ */
+class TwoStacksAggregator {
+  public:
+    explicit TwoStacksAggregator(const std::vector<AggregationFunction>& functions, SliceArena* arena = nullptr);
+
+    /** @brief Partial without tuples, the neutral element of combine, in the arena if any. */
+    Partial identity() const;
+    void combine(Partial& state, const Partial& other) const;
+
+    /** @brief Appends a slice; its start must be larger than all queued starts. */
+    void push(uint64_t start, const Partial& slice);
+    /** @brief Removes the slices that start before the given time. */
+    void evictBefore(uint64_t start);
+
+    /**
+     * @brief Slice of the given start for an out-of-order tuple, inserted if it was not queued. The stacks are
+     * recomputed once before the next query, O(number of slices), however many slices were changed until then.
+     */
+    Partial& findOrInsert(uint64_t start);
+
+    /** @brief Aggregate over all queued slices, written into result to reuse its storage. */
+    void query(Partial& result);
+
+    bool isEmpty() const;
+    /** @brief Start of the last queued slice; the queue must not be empty. */
+    uint64_t getLastStart() const;
+
+  private:
+    struct Entry {
+        uint64_t start;
+        Partial slice;
+        // Aggregate of this slice and all later ones of the front stack, valid for the first split entries
+        Partial suffix;
+    };
+
+    void flip();
+
+    const std::vector<AggregationFunction>& functions;
+    SliceArena* arena;
+    std::deque<Entry, ArenaAllocator<Entry>> entries;
+    size_t split = 0;
+    Partial back;
+    // Slices were changed in place since the last flip, so the suffixes and back are stale
+    bool stale = false;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_SLIDINGAGGREGATOR_HPP_
@@ -0,0 +1,88 @@
+#ifndef SNCB_ENGINE_SNCBGENERATOR_HPP_
+#define SNCB_ENGINE_SNCBGENERATOR_HPP_
+
+#include <Engine/DataSource.hpp>
+#include <Engine/SourceCatalog.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/**
+ * @brief Deterministic source of synthetic SNCB train data with the fields of the sncb schema. Every train
+ * drives a continuous path inside the configured box, reflecting at its edges, and alternates between
+ * accelerating, cruising and braking to a stop with a dwell. The brake cylinder pressure PCFA follows the
+ * braking, the brake pipe pressure PCFF falls with it; CFA spikes raise PCFA for a few samples while PCFF
+ * stays flat, and alarm bursts set Code1 or Code2. Rows are ordered by timestamp, then by train, so all
+ * trains report at every sampleInterval. Each train draws from its own random stream seeded from the seed
+ * and its index, so the rows do not depend on the number of threads or the buffer sizes. Values are
+ * rounded to the precision of the recorded data (two decimals for pressures, five for positions).
+ */
+class SncbGenerator : public DataSource {
+  public:
+    /** @brief All fields the generator produces, the sncb schema of coordinator.yaml. */
+    static SchemaPtr getSchema();
+
+    /**
+     * @brief Reads the bounds of a `type: SNCB` logical source of an e2e configuration (minSpeed, maxSpeed,
+     * min/max longitude and latitude); bounds the file does not set keep their defaults.
+     * @throws std::invalid_argument if the file has no such source or its bounds are empty
+     */
+    static SncbGeneratorConfig readE2EConfig(const std::string& path, const std::string& sourceName = "sncb");
+
+    /**
+     * @param schema fields of the produced buffers, any subset of getSchema()
+     * @throws std::invalid_argument for unknown fields, no trains or empty bounds
+     */
+    SncbGenerator(SncbGeneratorConfig config, SchemaPtr schema);
+
+    /** @brief Fills the buffer, an owning buffer of the generator's schema, with the next rows. */
+    bool fillBuffer(TupleBuffer& buffer) override;
+    uint64_t getProducedTuples() const override;
+    uint64_t getTotalTuples() const;
+
+  private:
+    enum Field { Timestamp, Id, Vbat, PCFA, PCFF, PCF1, PCF2, T1, T2, Code1, Code2, Speed, Latitude, Longitude, FieldCount };
+
+    struct Train {
+        uint64_t random = 0;
+        double latitude = 0.0;
+        double longitude = 0.0;
+        // Direction of travel in radians, clockwise from north
+        double heading = 0.0;
+        double speed = 0.0;
+        double targetSpeed = 0.0;
+        // Applied braking between 0 and 1
+        double brake = 0.0;
+        // Slowly drifting offsets of the auxiliary pressures
+        std::array<double, 4> drift{};
+        uint64_t dwellSamples = 0;
+        uint64_t spikeSamples = 0;
+        double spikeBar = 0.0;
+        uint64_t alarmSamples = 0;
+        uint64_t code1 = 0;
+        uint64_t code2 = 0;
+        bool stopping = false;
+    };
+
+    /** @brief Advances the trains [firstTrain, lastTrain) through the rows [begin, end) and writes them. */
+    void generate(size_t firstTrain, size_t lastTrain, uint64_t begin, uint64_t end, const std::array<uint64_t*, FieldCount>& columns);
+    void advance(Train& train, uint64_t index, uint64_t step, uint64_t* const* columns, size_t row);
+
+    SncbGeneratorConfig config;
+    // Column of each field in the buffers, FieldCount if the schema lacks it
+    std::array<size_t, FieldCount> slots;
+    std::vector<Train> trains;
+    double sampleSeconds;
+    size_t threads;
+    uint64_t totalTuples;
+    uint64_t producedTuples = 0;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_SNCBGENERATOR_HPP_
@@ -0,0 +1,33 @@
+#ifndef SNCB_ENGINE_SNCBQUERIES_HPP_
+#define SNCB_ENGINE_SNCBQUERIES_HPP_
+
+#include <Engine/Query.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/** @brief A query of one of the coordinator clients, rebuilt with the Engine query API. */
+struct LocalQueryDefinition {
+    // Client executable that submits this query to a coordinator, e.g. Query4
+    std::string client;
+    // Query name and default sink, the same as in the client
+    std::string name;
+    std::string defaultSinkPath;
+    std::function<Query(const std::string& sinkPath)> build;
+};
+
+/** @brief The query shapes of all Query* clients, in the order of the clients. */
+const std::vector<LocalQueryDefinition>& getSncbQueries();
+
+/**
+ * @brief Queries whose client or query name equals the selector (case-insensitive), or all for "all".
+ * @throws std::invalid_argument if nothing matches
+ */
+std::vector<LocalQueryDefinition> findSncbQueries(const std::string& selector);
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_SNCBQUERIES_HPP_
@@ -0,0 +1,113 @@
+#ifndef SNCB_ENGINE_SOURCECATALOG_HPP_
+#define SNCB_ENGINE_SOURCECATALOG_HPP_
+
+#include <Engine/Schema.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/** @brief Load-test replay of a source, see ReplaySource. */
+struct ReplayConfig {
+    // Tuples per second, 0 for no rate limit
+    double eventsPerSecond = 0.0;
+    // Replays event time this many times faster than recorded, 0 ignores event time
+    double speedup = 0.0;
+    std::string timeField = "timestamp";
+    // Units of the time field per second, 1000 for milliseconds
+    double timeUnitsPerSecond = 1000.0;
+    // Every tuple is replayed as this many trains; copy k gets id + k * idOffset and a jittered position
+    size_t copies = 1;
+    uint64_t idOffset = 1000000;
+    double gpsJitterMeters = 0.0;
+    uint64_t seed = 1;
+};
+
+/** @brief Synthetic SNCB trains, see SncbGenerator; bounds as in the `type: SNCB` sources of the e2e configs. */
+struct SncbGeneratorConfig {
+    uint64_t trains = 100;
+    uint64_t samplesPerTrain = 3600;
+    // Train ids are firstId, firstId + 1, ...
+    uint64_t firstId = 1;
+    // Timestamp of the first sample and time between two samples of a train, in units of the time field
+    uint64_t startTimestamp = 1719784681000;
+    uint64_t sampleInterval = 1000;
+    double timeUnitsPerSecond = 1000.0;
+    double minSpeed = 0.0;
+    double maxSpeed = 120.0;
+    double minLongitude = 4.0;
+    double maxLongitude = 6.5;
+    double minLatitude = 49.5;
+    double maxLatitude = 51.5;
+    // Probability per sample that a CFA pressure spike or an alarm code burst starts
+    double cfaSpikeProbability = 0.002;
+    double alarmProbability = 0.001;
+    uint64_t seed = 1;
+    // Threads that generate a buffer, 0 for one per core
+    size_t threads = 0;
+};
+
+/** @brief CSV_SOURCE entry of worker.yaml. */
+struct PhysicalSourceConfig {
+    std::string logicalSourceName;
+    std::string physicalSourceName;
+    std::string filePath;
+    bool skipHeader = true;
+    char delimiter = ',';
+    // 0 derives the tuples per buffer from the buffer size, as NES does
+    size_t tuplesPerBuffer = 0;
+    uint64_t gatheringIntervalMs = 0;
+    // Columnar copy of the CSV file, see ColumnarFile; replayed instead of the CSV file if set
+    std::string columnarFilePath;
+    // Paced and multiplied replay instead of reading as fast as possible
+    std::optional<ReplayConfig> replay;
+    // Synthetic trains generated in memory instead of reading the CSV file
+    std::optional<SncbGeneratorConfig> generator;
+};
+
+/** @brief Logical source schemas of coordinator.yaml and the physical CSV sources of worker.yaml. */
+class SourceCatalog {
+  public:
+    /**
+     * @brief Reads both configuration files. Source files that do not exist under their configured,
+     * usually absolute path are looked up by file name in dataDirectory.
+     * @throws std::runtime_error or std::invalid_argument on unreadable or unsupported configuration
+     */
+    static SourceCatalog fromYaml(const std::string& coordinatorConfig, const std::string& workerConfig,
+                                  const std::string& dataDirectory = "data");
+
+    void addLogicalSource(const std::string& name, Schema schema);
+    void addPhysicalSource(PhysicalSourceConfig config);
+
+    /** @throws std::invalid_argument if the source is unknown */
+    SchemaPtr getSchema(const std::string& logicalSourceName) const;
+    /** @throws std::invalid_argument if no physical source serves the logical source */
+    const PhysicalSourceConfig& getPhysicalSource(const std::string& logicalSourceName) const;
+
+    std::vector<std::string> getLogicalSourceNames() const;
+
+    /** @throws std::invalid_argument if no physical source serves the logical source */
+    void setColumnarFile(const std::string& logicalSourceName, const std::string& path);
+    /** @throws std::invalid_argument if no physical source serves the logical source */
+    void setReplay(const std::string& logicalSourceName, const ReplayConfig& replay);
+    /** @throws std::invalid_argument if no physical source serves the logical source */
+    void setGenerator(const std::string& logicalSourceName, const SncbGeneratorConfig& generator);
+
+    /** @brief Buffer size in bytes used to derive tuples per buffer, bufferSizeInBytes of the NES configs. */
+    void setBufferSizeInBytes(size_t bytes);
+    size_t getTuplesPerBuffer(const std::string& logicalSourceName) const;
+
+  private:
+    std::map<std::string, SchemaPtr> schemas;
+    std::map<std::string, PhysicalSourceConfig> physicalSources;
+    size_t bufferSizeInBytes = 4096;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_SOURCECATALOG_HPP_
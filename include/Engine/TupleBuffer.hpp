@@ -0,0 +1,96 @@
+#ifndef SNCB_ENGINE_TUPLEBUFFER_HPP_
+#define SNCB_ENGINE_TUPLEBUFFER_HPP_
+
+#include <Engine/Schema.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SNCB::Engine {
+
+/**
+ * @brief Fixed capacity batch of tuples in a columnar layout, the unit operators pass to each other.
+ * Every field is one contiguous column of 8 byte slots: UINT64 and BOOLEAN values directly, FLOAT64
+ * values by bit pattern. Operators that read two fields of a wide tuple touch only those two columns.
+ */
+class TupleBuffer {
+  public:
+    TupleBuffer(SchemaPtr schema, size_t capacity);
+
+    /**
+     * @brief A full buffer over columns it does not own, one per field of the schema with numberOfTuples
+     * slots each, e.g. in a memory-mapped file. The columns must outlive the buffer and its copies.
+     */
+    TupleBuffer(SchemaPtr schema, std::vector<uint64_t*> columns, size_t numberOfTuples);
+
+    TupleBuffer(const TupleBuffer& other);
+    TupleBuffer(TupleBuffer&& other) noexcept = default;
+    TupleBuffer& operator=(const TupleBuffer& other);
+    TupleBuffer& operator=(TupleBuffer&& other) noexcept = default;
+
+    const SchemaPtr& getSchema() const;
+    size_t getNumberOfTuples() const;
+    size_t getCapacity() const;
+    bool isFull() const;
+    bool isEmpty() const;
+
+    /**
+     * @brief Steady clock time in nanoseconds at which the latest of the buffer's tuples left its source, 0
+     * if latencies are not tracked. Operators pass it on, so sinks can measure the latency of their results.
+     */
+    uint64_t getIngestionTime() const { return ingestionTime; }
+    void setIngestionTime(uint64_t time) { ingestionTime = time; }
+
+    /** @brief Appends a zeroed tuple and returns its index; the buffer must not be full. */
+    size_t append();
+    void setNumberOfTuples(size_t numberOfTuples);
+    void clear();
+
+    uint64_t* getColumn(size_t field) { return columns[field]; }
+    const uint64_t* getColumn(size_t field) const { return columns[field]; }
+    double* getDoubleColumn(size_t field) { return reinterpret_cast<double*>(getColumn(field)); }
+    const double* getDoubleColumn(size_t field) const { return reinterpret_cast<const double*>(getColumn(field)); }
+
+    uint64_t getUInt(size_t row, size_t field) const { return getColumn(field)[row]; }
+    double getDouble(size_t row, size_t field) const { return std::bit_cast<double>(getColumn(field)[row]); }
+    void setUInt(size_t row, size_t field, uint64_t value) { getColumn(field)[row] = value; }
+    void setDouble(size_t row, size_t field, double value) { getColumn(field)[row] = std::bit_cast<uint64_t>(value); }
+
+    /** @brief Value of a field of any type as double, the representation expressions compute with. */
+    double getAsDouble(size_t row, size_t field) const {
+        return types[field] == DataType::FLOAT64 ? getDouble(row, field) : static_cast<double>(getUInt(row, field));
+    }
+    /** @brief Stores a computed value in the representation of the field's type. */
+    void setFromDouble(size_t row, size_t field, double value) {
+        if (types[field] == DataType::FLOAT64) {
+            setDouble(row, field, value);
+        } else {
+            setUInt(row, field, value <= 0.0 ? 0 : static_cast<uint64_t>(value));
+        }
+    }
+
+    /**
+     * @brief Appends the given rows of a buffer, column by column, and returns the number of rows that fit.
+     * Fields are matched by position; fields beyond the source's are left unset for the caller to fill.
+     */
+    size_t appendRows(const TupleBuffer& source, const uint32_t* rows, size_t count);
+    /** @brief Appends rows [begin, begin + count) of a buffer, like appendRows. */
+    size_t appendRange(const TupleBuffer& source, size_t begin, size_t count);
+
+  private:
+    SchemaPtr schema;
+    std::vector<DataType> types;
+    size_t width;
+    size_t capacity;
+    size_t numberOfTuples = 0;
+    uint64_t ingestionTime = 0;
+    // Owned storage, empty for a buffer over external columns; columns point into it or to the external ones
+    std::vector<uint64_t> slots;
+    std::vector<uint64_t*> columns;
+};
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_TUPLEBUFFER_HPP_
@@ -0,0 +1,45 @@
+#ifndef SNCB_ENGINE_VECTORKERNELS_HPP_
+#define SNCB_ENGINE_VECTORKERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Branch-free kernels over column batches, the building blocks of batched expression evaluation.
+ * They use AVX2 on x86 and NEON on AArch64 when the compiler targets them, scalar loops otherwise.
+ * Truth values are 1.0 and 0.0, like the results of scalar expression evaluation.
+ */
+namespace SNCB::Engine::Kernels {
+
+enum class Comparison { Less, LessEquals, Greater, GreaterEquals, Equals, NotEquals };
+
+/** @brief "AVX2", "NEON" or "scalar", whichever the kernels were compiled for. */
+const char* getInstructionSet();
+
+void fill(double value, double* out, size_t count);
+void toDouble(const uint64_t* in, double* out, size_t count);
+/** @brief Converts to UINT64 the way TupleBuffer::setFromDouble does: values <= 0 become 0. */
+void toUInt(const double* in, uint64_t* out, size_t count);
+
+void add(const double* left, const double* right, double* out, size_t count);
+void sub(const double* left, const double* right, double* out, size_t count);
+void mul(const double* left, const double* right, double* out, size_t count);
+void div(const double* left, const double* right, double* out, size_t count);
+void compare(Comparison comparison, const double* left, const double* right, double* out, size_t count);
+
+void logicalAnd(const double* left, const double* right, double* out, size_t count);
+void logicalOr(const double* left, const double* right, double* out, size_t count);
+void logicalNot(const double* in, double* out, size_t count);
+
+/** @brief Sets bit i of the bitmap (64 rows per word) iff value i is not 0. */
+void toBitmap(const double* values, size_t count, uint64_t* bitmap);
+
+/**
+ * @brief Writes offset + i for every set bit i of the bitmap.
+ * @return the number of row indices written
+ */
+size_t toSelection(const uint64_t* bitmap, size_t count, uint32_t offset, uint32_t* selection);
+
+}// namespace SNCB::Engine::Kernels
+
+#endif// SNCB_ENGINE_VECTORKERNELS_HPP_
@@ -0,0 +1,95 @@
+#ifndef SNCB_ENGINE_WINDOWING_HPP_
+#define SNCB_ENGINE_WINDOWING_HPP_
+
+#include <Engine/Expressions.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace SNCB::Engine {
+
+/** @brief Window length in milliseconds of event time. */
+struct TimeMeasure {
+    uint64_t milliseconds;
+};
+
+TimeMeasure Milliseconds(uint64_t milliseconds);
+TimeMeasure Seconds(uint64_t seconds);
+TimeMeasure Minutes(uint64_t minutes);
+
+/** @brief The field that carries event time, in milliseconds. */
+struct TimeCharacteristic {
+    std::string fieldName;
+};
+
+TimeCharacteristic EventTime(const ExpressionItem& field);
+
+enum class WindowKind { Tumbling, Sliding, Threshold };
+
+struct WindowType;
+using WindowTypePtr = std::shared_ptr<const WindowType>;
+
+/** @brief Window definition; tumbling windows are sliding windows whose slide equals their size. */
+struct WindowType {
+    WindowKind kind = WindowKind::Tumbling;
+    TimeCharacteristic time;
+    uint64_t size = 0;
+    uint64_t slide = 0;
+    // Threshold windows: open while the predicate holds, emitted if they saw at least minCount tuples
+    ExpressionNodePtr predicate;
+    uint64_t minCount = 0;
+    // Threshold windows with a time field: emitted and reopened once open for maxDuration ms, 0 for no limit
+    uint64_t maxDuration = 0;
+};
+
+class TumblingWindow {
+  public:
+    static WindowTypePtr of(TimeCharacteristic time, TimeMeasure size);
+};
+
+class SlidingWindow {
+  public:
+    static WindowTypePtr of(TimeCharacteristic time, TimeMeasure size, TimeMeasure slide);
+};
+
+class ThresholdWindow {
+  public:
+    static WindowTypePtr of(const ExpressionItem& predicate);
+    static WindowTypePtr of(const ExpressionItem& predicate, uint64_t minCount);
+    /** @brief Window that is emitted when the predicate stops holding or when it was open for maxDuration. */
+    static WindowTypePtr of(const ExpressionItem& predicate, uint64_t minCount, TimeCharacteristic time, TimeMeasure maxDuration);
+};
+
+enum class AggregationKind { Min, Max, Sum, Avg, Count };
+
+class WindowAggregation;
+using WindowAggregationPtr = std::shared_ptr<WindowAggregation>;
+
+/** @brief Aggregation of a window; the result is named after the input field unless renamed with as(). */
+class WindowAggregation {
+  public:
+    WindowAggregation(AggregationKind kind, ExpressionNodePtr onField);
+
+    /** @brief Renames the aggregation result, as in Min(Attribute("a"))->as(Attribute("a_min")). */
+    WindowAggregationPtr as(const ExpressionItem& field) const;
+
+    AggregationKind getKind() const;
+    const ExpressionNodePtr& getOnField() const;
+    const std::string& getAsField() const;
+
+  private:
+    AggregationKind kind;
+    ExpressionNodePtr onField;
+    std::string asField;
+};
+
+WindowAggregationPtr Min(const ExpressionItem& field);
+WindowAggregationPtr Max(const ExpressionItem& field);
+WindowAggregationPtr Sum(const ExpressionItem& field);
+WindowAggregationPtr Avg(const ExpressionItem& field);
+WindowAggregationPtr Count();
+
+}// namespace SNCB::Engine
+
+#endif// SNCB_ENGINE_WINDOWING_HPP_
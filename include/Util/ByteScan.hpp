@@ -0,0 +1,26 @@
+#ifndef SNCB_UTIL_BYTESCAN_HPP_
+#define SNCB_UTIL_BYTESCAN_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SNCB::Util {
+
+/**
+ * @brief Counts the occurrences of a byte in a block, 16 or 32 bytes per step with SSE2, AVX2 or NEON
+ * and a scalar loop for the tail and for other targets.
+ */
+uint64_t countByte(const char* data, size_t size, char byte);
+
+inline uint64_t countNewlines(const char* data, size_t size) { return countByte(data, size, '\n'); }
+
+/**
+ * @brief Writes the offsets of every delimiter and newline in a block to positions, in order, with the
+ * same instruction sets as countByte; positions must hold size entries.
+ * @return the number of offsets written
+ */
+size_t indexStructurals(const char* data, size_t size, char delimiter, uint32_t* positions);
+
+}// namespace SNCB::Util
+
+#endif// SNCB_UTIL_BYTESCAN_HPP_
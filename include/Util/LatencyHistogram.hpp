@@ -0,0 +1,50 @@
+#ifndef SNCB_UTIL_LATENCYHISTOGRAM_HPP_
+#define SNCB_UTIL_LATENCYHISTOGRAM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SNCB::Util {
+
+/**
+ * @brief Histogram of non-negative integer values, e.g. latencies in nanoseconds, with log-linear buckets:
+ * every power of two is split into SubBuckets equal buckets, so a percentile is within 1/SubBuckets
+ * (about 3 %) of the exact value at a fixed size of about 15 KiB, whatever the range of the values.
+ */
+class LatencyHistogram {
+  public:
+    static constexpr unsigned SubBucketBits = 5;
+    static constexpr uint64_t SubBuckets = uint64_t{1} << SubBucketBits;
+
+    LatencyHistogram();
+
+    void record(uint64_t value, uint64_t count = 1);
+    /** @brief Adds the values recorded by another histogram. */
+    void merge(const LatencyHistogram& other);
+
+    uint64_t getCount() const;
+    uint64_t getMin() const;
+    uint64_t getMax() const;
+    double getMean() const;
+
+    /**
+     * @brief Value below or at which percent (in [0, 100]) of the recorded values lie: the upper bound of
+     * their bucket, at most the maximum; 0 without values.
+     */
+    uint64_t getPercentile(double percent) const;
+
+  private:
+    static size_t bucketOf(uint64_t value);
+    static uint64_t upperBoundOf(size_t bucket);
+
+    std::vector<uint64_t> counts;
+    uint64_t count = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    double sum = 0.0;
+};
+
+}// namespace SNCB::Util
+
+#endif// SNCB_UTIL_LATENCYHISTOGRAM_HPP_
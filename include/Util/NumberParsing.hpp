@@ -0,0 +1,23 @@
+#ifndef SNCB_UTIL_NUMBERPARSING_HPP_
+#define SNCB_UTIL_NUMBERPARSING_HPP_
+
+#include <cstdint>
+
+namespace SNCB::Util {
+
+/**
+ * @brief The value strtoull(field, nullptr, 10) reads from the field [begin, end). Plain digit runs are
+ * parsed inline, anything else (signs, spaces, more than 19 digits) by strtoull itself.
+ */
+uint64_t parseUInt64(const char* begin, const char* end);
+
+/**
+ * @brief The value strtod reads from the field [begin, end). Decimal numbers with up to 19 significant
+ * digits and an exponent within 10^22 are one exact multiplication or division, which rounds like
+ * strtod; anything else is handed to strtod.
+ */
+double parseDouble(const char* begin, const char* end);
+
+}// namespace SNCB::Util
+
+#endif// SNCB_UTIL_NUMBERPARSING_HPP_
@@ -0,0 +1,53 @@
+#ifndef SNCB_UTIL_YAMLLITE_HPP_
+#define SNCB_UTIL_YAMLLITE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SNCB::Util {
+
+/**
+ * @brief Minimal YAML reader for the coordinator, worker and e2e configuration files of this repository.
+ * Supports block maps, block lists (also of maps), plain and quoted scalars and comments; flow
+ * collections, anchors and multi-line scalars are not supported.
+ */
+class YamlNode {
+  public:
+    enum class Kind { Null, Scalar, Map, List };
+
+    /** @throws std::runtime_error if the file cannot be read or is not supported YAML */
+    static YamlNode parseFile(const std::string& path);
+    static YamlNode parse(const std::string& text);
+
+    Kind getKind() const;
+    bool isNull() const;
+
+    /** @brief Value of a map key, a null node if this is not a map or the key is missing. */
+    const YamlNode& operator[](const std::string& key) const;
+    bool has(const std::string& key) const;
+
+    /** @brief Items of a list, empty for other kinds. */
+    const std::vector<YamlNode>& items() const;
+    /** @brief Entries of a map in file order, empty for other kinds. */
+    const std::vector<std::pair<std::string, YamlNode>>& entries() const;
+
+    std::string asString(const std::string& fallback = "") const;
+    /** @throws std::invalid_argument if the scalar is not a number */
+    uint64_t asUInt(uint64_t fallback = 0) const;
+    double asDouble(double fallback = 0.0) const;
+    bool asBool(bool fallback = false) const;
+
+  private:
+    friend class YamlParser;
+
+    Kind kind = Kind::Null;
+    std::string scalar;
+    std::vector<std::pair<std::string, YamlNode>> map;
+    std::vector<YamlNode> list;
+};
+
+}// namespace SNCB::Util
+
+#endif// SNCB_UTIL_YAMLLITE_HPP_
@@ -0,0 +1,345 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Engine/GeoContext.hpp>
+#include <Engine/LocalEngine.hpp>
+#include <Engine/SncbGenerator.hpp>
+#include <Engine/SncbQueries.hpp>
+#include <Engine/SourceCatalog.hpp>
+#include <Engine/VectorKernels.hpp>
+
+using namespace SNCB::Engine;
+namespace fs = std::filesystem;
+
+struct LocalQueryOptions {
+    std::vector<std::string> queries;
+    std::string coordinatorConfig = "config/coordinator.yaml";
+    std::string workerConfig = "config/worker.yaml";
+    std::string dataDirectory = "data";
+    // Logical source and columnar file replayed instead of its CSV file
+    std::vector<std::pair<std::string, std::string>> columnarFiles;
+    std::string areasFile = "data/high_risk_areas_ordered_unix.csv";
+    double areaRadiusMeters = 500.0;
+    double withinDistanceMeters = 1000.0;
+    size_t bufferSizeInBytes = 4096;
+    std::string sinkPath;
+    std::string outputDirectory;
+    std::string sinkFormat = "CSV_FORMAT";
+    // 0 runs every query until its sources are exhausted
+    int durationSeconds = 0;
+    bool list = false;
+    // Run every query on its own scan and windows, as separate clients would
+    bool noSharing = false;
+    // Measure the time from ingestion to the sink of every result
+    bool latency = false;
+    // Sources replayed with the pacing and multiplication of replay; workerRate takes the rate from worker.yaml
+    std::vector<std::string> replaySources;
+    ReplayConfig replay;
+    bool workerRate = false;
+    bool replayOptions = false;
+    // Sources generated in memory by SncbGenerator with the bounds of generatorConfig
+    std::vector<std::string> generatedSources;
+    std::string generatorConfig = "config/sncb_query6_e2e.yaml";
+    SncbGeneratorConfig generator;
+    bool generatorOptions = false;
+    bool seedSet = false;
+    bool timeUnitSet = false;
+};
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " --query name [--query name ...] [options]\n"
+              << "Runs SNCB queries in-process against the CSV sources of the worker configuration.\n"
+              << "  --query name               client (Query1, Query4, ...), query name (query1, weather, ...) or all\n"
+              << "  --list                     print the available queries\n"
+              << "  --coordinator-config path  logical source schemas (default config/coordinator.yaml)\n"
+              << "  --worker-config path       physical CSV sources (default config/worker.yaml)\n"
+              << "  --data-dir dir             look up source files missing at their configured path here (default data)\n"
+              << "  --columnar source=path     replay a columnar file written by CsvToColumnar instead of the source's CSV\n"
+              << "  --areas path               high-risk areas CSV (default data/high_risk_areas_ordered_unix.csv)\n"
+              << "  --area-radius meters       radius of a high-risk area for teintersects (default 500)\n"
+              << "  --within-distance meters   distance of tedwithin (default 1000)\n"
+              << "  --buffer-size bytes        tuple buffer size when a source sets no tuples per buffer (default 4096)\n"
+              << "  --sink path                sink file of a single query\n"
+              << "  --output-dir dir           directory for the default sink files\n"
+              << "  --sink-format format       CSV_FORMAT or BINARY_FORMAT; default sink files of BINARY_FORMAT end in .bin\n"
+              << "  --no-sharing               do not share scans and windows between the queries\n"
+              << "  --latency                  report p50/p95/p99/max latency from ingestion to the sink per query\n"
+              << "  --replay source            pace and multiply a source for load tests, repeatable, with:\n"
+              << "    --rate n|worker          tuples per second, worker: numberOfTuplesToProducePerBuffer per\n"
+              << "                             gatheringInterval of worker.yaml (default 0: unlimited)\n"
+              << "    --speedup factor         replay event time this many times faster (default 0: ignore event time)\n"
+              << "    --time-unit ms|s         unit of the timestamp field for --speedup and of generated timestamps (default ms)\n"
+              << "    --copies n               replay every tuple as n trains, ids offset by 1000000 (default 1)\n"
+              << "    --gps-jitter meters      random offset of the copies' latitude and longitude (default 0)\n"
+              << "    --seed n                 seed of the jitter and the generator (default 1)\n"
+              << "  --generate source          generate a source's rows as synthetic SNCB trains instead of reading it, with:\n"
+              << "    --generator-config path  e2e configuration with the bounds (default config/sncb_query6_e2e.yaml)\n"
+              << "    --trains n               trains reporting at every sample (default 100)\n"
+              << "    --samples n              samples per train, one per second of event time (default 3600)\n"
+              << "    --generator-threads n    threads generating a buffer (default: one per core)\n"
+              << "  --duration seconds         stop queries still running after this time (default: run to the end)"
+              << std::endl;
+}
+
+static double parsePositive(const std::string& flag, const std::string& value) {
+    try {
+        size_t consumed = 0;
+        double parsed = std::stod(value, &consumed);
+        if (consumed == value.size() && parsed >= 0) {
+            return parsed;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument(flag + " expects a non-negative number, got '" + value + "'");
+}
+
+static LocalQueryOptions parseOptions(int argc, char** argv) {
+    LocalQueryOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--list") {
+            options.list = true;
+            continue;
+        }
+        if (flag == "--no-sharing") {
+            options.noSharing = true;
+            continue;
+        }
+        if (flag == "--latency") {
+            options.latency = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + flag);
+        }
+        std::string value = argv[++i];
+        if (flag == "--query") {
+            options.queries.push_back(value);
+        } else if (flag == "--coordinator-config") {
+            options.coordinatorConfig = value;
+        } else if (flag == "--worker-config") {
+            options.workerConfig = value;
+        } else if (flag == "--data-dir") {
+            options.dataDirectory = value;
+        } else if (flag == "--columnar") {
+            auto separator = value.find('=');
+            if (separator == std::string::npos || separator == 0) {
+                throw std::invalid_argument("--columnar expects source=path, got '" + value + "'");
+            }
+            options.columnarFiles.emplace_back(value.substr(0, separator), value.substr(separator + 1));
+        } else if (flag == "--areas") {
+            options.areasFile = value;
+        } else if (flag == "--area-radius") {
+            options.areaRadiusMeters = parsePositive(flag, value);
+        } else if (flag == "--within-distance") {
+            options.withinDistanceMeters = parsePositive(flag, value);
+        } else if (flag == "--buffer-size") {
+            options.bufferSizeInBytes = static_cast<size_t>(parsePositive(flag, value));
+        } else if (flag == "--sink") {
+            options.sinkPath = value;
+        } else if (flag == "--output-dir") {
+            options.outputDirectory = value;
+        } else if (flag == "--sink-format") {
+            if (value != "CSV_FORMAT" && value != "BINARY_FORMAT") {
+                throw std::invalid_argument("--sink-format expects CSV_FORMAT or BINARY_FORMAT, got '" + value + "'");
+            }
+            options.sinkFormat = value;
+        } else if (flag == "--replay") {
+            options.replaySources.push_back(value);
+        } else if (flag == "--rate") {
+            options.workerRate = value == "worker";
+            options.replay.eventsPerSecond = options.workerRate ? 0.0 : parsePositive(flag, value);
+            options.replayOptions = true;
+        } else if (flag == "--speedup") {
+            options.replay.speedup = parsePositive(flag, value);
+            options.replayOptions = true;
+        } else if (flag == "--time-unit") {
+            if (value != "ms" && value != "s") {
+                throw std::invalid_argument("--time-unit expects ms or s, got '" + value + "'");
+            }
+            options.replay.timeUnitsPerSecond = value == "ms" ? 1000.0 : 1.0;
+            options.timeUnitSet = true;
+        } else if (flag == "--copies") {
+            options.replay.copies = static_cast<size_t>(parsePositive(flag, value));
+            options.replayOptions = true;
+        } else if (flag == "--gps-jitter") {
+            options.replay.gpsJitterMeters = parsePositive(flag, value);
+            options.replayOptions = true;
+        } else if (flag == "--seed") {
+            options.replay.seed = static_cast<uint64_t>(parsePositive(flag, value));
+            options.generator.seed = options.replay.seed;
+            options.seedSet = true;
+        } else if (flag == "--generate") {
+            options.generatedSources.push_back(value);
+        } else if (flag == "--generator-config") {
+            options.generatorConfig = value;
+            options.generatorOptions = true;
+        } else if (flag == "--trains") {
+            options.generator.trains = static_cast<uint64_t>(parsePositive(flag, value));
+            options.generatorOptions = true;
+        } else if (flag == "--samples") {
+            options.generator.samplesPerTrain = static_cast<uint64_t>(parsePositive(flag, value));
+            options.generatorOptions = true;
+        } else if (flag == "--generator-threads") {
+            options.generator.threads = static_cast<size_t>(parsePositive(flag, value));
+            options.generatorOptions = true;
+        } else if (flag == "--duration") {
+            options.durationSeconds = static_cast<int>(parsePositive(flag, value));
+        } else {
+            throw std::invalid_argument("unknown option " + flag);
+        }
+    }
+    if (options.replayOptions && options.replaySources.empty()) {
+        throw std::invalid_argument("--rate, --speedup, --copies and --gps-jitter need --replay source");
+    }
+    if (options.generatorOptions && options.generatedSources.empty()) {
+        throw std::invalid_argument("--generator-config, --trains, --samples and --generator-threads need --generate source");
+    }
+    if ((options.seedSet || options.timeUnitSet) && options.replaySources.empty() && options.generatedSources.empty()) {
+        throw std::invalid_argument("--seed and --time-unit need --replay source or --generate source");
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+    }
+
+    try {
+        auto options = parseOptions(argc, argv);
+        if (options.list) {
+            for (const auto& query : getSncbQueries()) {
+                std::cout << std::left << std::setw(26) << query.client << std::setw(26) << query.name << query.defaultSinkPath
+                          << std::endl;
+            }
+            return 0;
+        }
+        if (options.queries.empty()) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        std::vector<LocalQueryDefinition> definitions;
+        for (const auto& selector : options.queries) {
+            auto matches = findSncbQueries(selector);
+            definitions.insert(definitions.end(), matches.begin(), matches.end());
+        }
+        if (!options.sinkPath.empty() && definitions.size() != 1) {
+            throw std::invalid_argument("--sink needs exactly one query, use --output-dir for several");
+        }
+
+        auto catalog = SourceCatalog::fromYaml(options.coordinatorConfig, options.workerConfig, options.dataDirectory);
+        catalog.setBufferSizeInBytes(options.bufferSizeInBytes);
+        for (const auto& [source, path] : options.columnarFiles) {
+            catalog.setColumnarFile(source, path);
+        }
+        for (const auto& source : options.generatedSources) {
+            auto generator = SncbGenerator::readE2EConfig(options.generatorConfig, source);
+            generator.trains = options.generator.trains;
+            generator.samplesPerTrain = options.generator.samplesPerTrain;
+            generator.threads = options.generator.threads;
+            generator.seed = options.generator.seed;
+            if (options.replay.timeUnitsPerSecond == 1.0) {
+                generator.timeUnitsPerSecond = 1.0;
+                generator.startTimestamp /= 1000;
+                generator.sampleInterval = 1;
+            }
+            catalog.setGenerator(source, generator);
+            std::cout << "Generating " << source << ": " << generator.trains << " trains x " << generator.samplesPerTrain
+                      << " samples within " << options.generatorConfig << std::endl;
+        }
+        for (const auto& source : options.replaySources) {
+            auto replay = options.replay;
+            if (options.workerRate) {
+                const auto& config = catalog.getPhysicalSource(source);
+                if (config.tuplesPerBuffer == 0 || config.gatheringIntervalMs == 0) {
+                    throw std::invalid_argument("--rate worker needs numberOfTuplesToProducePerBuffer and gatheringInterval for " + source);
+                }
+                replay.eventsPerSecond = static_cast<double>(config.tuplesPerBuffer) * 1000.0 / static_cast<double>(config.gatheringIntervalMs);
+            }
+            catalog.setReplay(source, replay);
+            std::cout << "Replaying " << source << " at " << (replay.eventsPerSecond > 0 ? std::to_string(replay.eventsPerSecond) : "unlimited")
+                      << " tuples/s, speedup " << replay.speedup << ", " << replay.copies << " copies" << std::endl;
+        }
+        auto geo = std::make_shared<const GeoContext>(
+            GeoContext::fromCsv(options.areasFile, options.areaRadiusMeters, options.withinDistanceMeters));
+        LocalEngine engine(std::move(catalog), geo);
+        engine.setLatencyTracking(options.latency);
+
+        if (!options.outputDirectory.empty()) {
+            fs::create_directories(options.outputDirectory);
+        }
+        std::vector<Query> queries;
+        for (const auto& definition : definitions) {
+            auto sinkPath = options.sinkPath;
+            if (sinkPath.empty()) {
+                sinkPath = options.outputDirectory.empty()
+                    ? definition.defaultSinkPath
+                    : (fs::path(options.outputDirectory) / definition.defaultSinkPath).string();
+                if (options.sinkFormat == "BINARY_FORMAT") {
+                    sinkPath = fs::path(sinkPath).replace_extension(".bin").string();
+                }
+            }
+            queries.push_back(definition.build(sinkPath));
+            if (options.sinkFormat != "CSV_FORMAT") {
+                const auto& sink = *queries.back().getSink();
+                queries.back().sink(FileSinkDescriptor::create(sink.filePath, options.sinkFormat, sink.append ? "APPEND" : "OVERWRITE"));
+            }
+            std::cout << "Started " << definition.name << " -> " << sinkPath << std::endl;
+        }
+        auto queryIds = engine.submitQueries(queries, !options.noSharing);
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(options.durationSeconds);
+        for (auto queryId : queryIds) {
+            if (options.durationSeconds > 0) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+                engine.waitForQuery(queryId, std::max(remaining, std::chrono::milliseconds(0)));
+            } else {
+                engine.waitForQuery(queryId);
+            }
+            engine.stopQuery(queryId);
+        }
+
+        bool success = true;
+        std::cout << "\n=== Local Execution Results (" << Kernels::getInstructionSet() << " kernels) ===" << std::endl;
+        for (size_t i = 0; i < queryIds.size(); ++i) {
+            auto status = engine.getQueryStatus(queryIds[i]);
+            auto statistics = engine.getStatistics(queryIds[i]);
+            double seconds = statistics.getExecutionSeconds();
+            std::cout << definitions[i].name << ": " << toString(status) << ", " << statistics.inputTuples << " input tuples ("
+                      << statistics.inputTupleSize << " B each), "
+                      << statistics.outputTuples << " results in " << std::fixed << std::setprecision(3) << seconds
+                      << " s (" << std::setprecision(0) << (seconds > 0 ? statistics.inputTuples / seconds : 0.0)
+                      << " tuples/s)" << std::endl;
+            if (options.latency) {
+                const auto& latencies = statistics.latencies;
+                auto milliseconds = [](uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1e6; };
+                std::cout << std::setprecision(3) << "  latency p50 " << milliseconds(latencies.getPercentile(50)) << " ms, p95 "
+                          << milliseconds(latencies.getPercentile(95)) << " ms, p99 " << milliseconds(latencies.getPercentile(99))
+                          << " ms, max " << milliseconds(latencies.getMax()) << " ms over " << latencies.getCount() << " results"
+                          << std::endl;
+            }
+            if (status == QueryStatus::Failed) {
+                std::cerr << "  " << engine.getError(queryIds[i]) << std::endl;
+                success = false;
+            }
+        }
+        return success ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,9 +1,4 @@
-#include <concepts>
-#include <iostream>
-#include <memory>
 #include <string>
-#include <chrono>
-#include <thread>
 
 // Include NebulaStream headers
 #include <API/QueryAPI.hpp>
@@ -11,85 +6,27 @@
 #include <API/WindowedQuery.hpp>
 #include <API/Windowing.hpp>
 #include <Operators/LogicalOperators/Windows/LogicalWindowDescriptor.hpp>
+#include <Operators/LogicalOperators/Sinks/FileSinkDescriptor.hpp>
 #include <Types/SlidingWindow.hpp>
 #include <Types/WindowType.hpp>
-#include <Util/TimeMeasurement.hpp>
-#include <Client/ClientException.hpp>
-#include <Client/QueryConfig.hpp>
-#include <Client/RemoteClient.hpp>
-#include <Operators/LogicalOperators/Sinks/FileSinkDescriptor.hpp>
 
-using namespace std;
-using namespace NES;
-using namespace NES::Client;
-using namespace NES::Optimizer;
+#include <Driver/QueryRunner.hpp>
 
-int main() {
-    try {
-        const std::string coordinatorIp = "192.168.0.238";
-        const int coordinatorPort = 8081;
-        
-        std::cout << "Connecting to NebulaStream server at " << coordinatorIp << ":" << coordinatorPort << "..." << std::endl;
-        
-        // Create a client to test connection to the NebulaStream server
-        auto client = std::make_shared<RemoteClient>(coordinatorIp, coordinatorPort, std::chrono::seconds(20), true);
-        bool connected = client->testConnection();
-        
-        std::cout << "Connection test: " << (connected ? "successful" : "failed") << std::endl;
-        
-        if (connected) {
-            std::cout << "Successfully connected to NebulaStream server!" << std::endl;
-            
-            // Get existing logical sources - should now include sncb from coordinator.yaml
-            std::cout << "Available logical sources:" << std::endl;
-            std::string sources = client->getLogicalSources();
-            std::cout << sources << std::endl;
+using namespace NES;
+using SNCB::Driver::QueryDefinition;
+using SNCB::Driver::RunConfig;
 
-            
-            // Create a query using the logical source defined in the coordinator config
-            const std::string sourceName = "sncb";
-            std::cout << "Creating query for source: '" << sourceName << "'..." << std::endl;
+int main(int argc, char** argv) {
+    QueryDefinition query{"QueryTest", "query_output.csv", [](const std::string& sinkPath) {
+        // Use a file sink to write results to a local file
+        return Query::from("sncb")
+            .filter(Attribute("speed") > 100)
+            .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+    }};
 
-            // Use a file sink to write results to a local file
-            Query query = Query::from(sourceName)
-                    .filter(Attribute("speed") > 100)
-                    .sink(FileSinkDescriptor::create("query_output.csv", "CSV_FORMAT", "APPEND"));
-            
-            std::cout << "Query created successfully." << std::endl;
-            
-            // Configure query execution
-            QueryConfig queryConfig;
-            queryConfig.setPlacementType(PlacementStrategy::BottomUp);
-            
-            // Submit the query
-            std::cout << "Submitting query..." << std::endl;
-            QueryId queryId = client->submitQuery(query, queryConfig);
-            std::cout << "Query submitted with ID: " << queryId << std::endl;
-            
-            // Wait for the query to process some data
-            std::cout << "Waiting for query to process data (10 seconds)..." << std::endl;
-            std::this_thread::sleep_for(std::chrono::seconds(10));
-            
-            // Check query status
-            std::string status = client->getQueryStatus(queryId);
-            std::cout << "Query status: " << status << std::endl;
-            
-            // Stop the query
-            std::cout << "Stopping query..." << std::endl;
-            auto stopResult = client->stopQuery(queryId);
-            std::cout << "Query stopped, result: " << (stopResult ? "success" : "failed") << std::endl;
-            
-        } else {
-            std::cerr << "Failed to connect to NebulaStream server." << std::endl;
-            return 1;
-        }
-        
-        return 0;
-    } catch (const ClientException& e) {
-        std::cerr << "Client Exception: " << e.what() << std::endl;
-        return 1;
-    } catch (const std::exception& e) {
-        std::cerr << "Error: " << e.what() << std::endl;
-        return 1;
-    }
-}
\ No newline at end of file
+    RunConfig defaults;
+    defaults.duration = std::chrono::seconds(10);
+    defaults.placement = Optimizer::PlacementStrategy::BottomUp;
+    defaults.listLogicalSources = true;
+    return SNCB::Driver::runMain(argc, argv, {query}, defaults);
+}
@@ -1,8 +1,4 @@
-#include <iostream>
-#include <memory>
 #include <string>
-#include <chrono>
-#include <thread>
 
 // Include NebulaStream headers
 #include <API/QueryAPI.hpp>
@@ -10,112 +6,26 @@
 #include <API/WindowedQuery.hpp>
 #include <API/Windowing.hpp>
 #include <Operators/LogicalOperators/Windows/LogicalWindowDescriptor.hpp>
+#include <Operators/LogicalOperators/Sinks/FileSinkDescriptor.hpp>
 #include <Types/SlidingWindow.hpp>
 #include <Types/WindowType.hpp>
-#include <Util/TimeMeasurement.hpp>
-#include <Client/ClientException.hpp>
-#include <Client/QueryConfig.hpp>
-#include <Client/RemoteClient.hpp>
 
+#include <Driver/QueryRunner.hpp>
 
-using namespace std;
 using namespace NES;
-
-int main() {
-    try {
-        const std::string coordinatorIp = "127.0.0.1";
-        const int coordinatorPort = 8081;
-        
-        std::cout << "Connecting to NebulaStream server at " << coordinatorIp << ":" << coordinatorPort << "..." << std::endl;
-        
-        // Create a client to test connection to the NebulaStream server
-        auto client = std::make_shared<Client::RemoteClient>(coordinatorIp, coordinatorPort, std::chrono::seconds(20), true);
-        bool connected = client->testConnection();
-        
-        std::cout << "Connection test: " << (connected ? "successful" : "failed") << std::endl;
-        
-        if (connected) {
-            std::cout << "Successfully connected to NebulaStream server!" << std::endl;
-            
-            // Get existing logical sources - should now include sncb from coordinator.yaml
-            // std::cout << "Available logical sources:" << std::endl;
-            // std::string sources = client->getLogicalSources();
-            // std::cout << sources << std::endl;
-
-            
-            // Create a query using the logical source defined in the coordinator config
-            const std::string sourceName = "sncb";
-            std::cout << "Creating query for source: '" << sourceName << "'..." << std::endl;
-            // Query query = Query::from(sourceName)
-            //         .filter(
-            //         teintersects(Attribute("longitude", BasicType::FLOAT64),
-            //             Attribute("latitude", BasicType::FLOAT64),
-            //             Attribute("timestamp", BasicType::UINT64)) == 1
-            //         && 
-            //         (Attribute("Code1") != 0 || Attribute("Code2") != 0))
-            //         .window(SlidingWindow::of(EventTime(Attribute("timestamp", BasicType::UINT64)), 
-            //                             Seconds(30), Seconds(30)))
-            //         .apply(Avg(Attribute("speed")))
-            //         .sink(FileSinkDescriptor::create("query1.csv", "CSV_FORMAT", "APPEND"));
-
-
-            auto ThresholExpression = teintersects(Attribute("longitude", BasicType::FLOAT64),
-                                            Attribute("latitude", BasicType::FLOAT64),
-                                            Attribute("timestamp", BasicType::UINT64)) == 1;
-
-            Query query = Query::from(sourceName)
-                    .filter((Attribute("Code1") != 0 || Attribute("Code2") != 0))
-                    .window(ThresholdWindow::of(teintersects(Attribute("longitude", BasicType::FLOAT64),
-                                    Attribute("latitude", BasicType::FLOAT64),
-                                    Attribute("timestamp", BasicType::UINT64)) == 1))
-                    .apply(Sum(Attribute("speed", BasicType::UINT64)))
-                    .sink(FileSinkDescriptor::create("query1.csv", "CSV_FORMAT", "APPEND"));
-;
-
-            std::cout << "Query created successfully." << std::endl;
-            
-            // Configure query execution
-            Client::QueryConfig queryConfig;
-            queryConfig.setPlacementType(Optimizer::PlacementStrategy::TopDown);
-            
-            // Start measuring execution time
-            auto startTime = std::chrono::high_resolution_clock::now();
-            
-            // Submit the query
-            std::cout << "Submitting query..." << std::endl;
-            QueryId queryId = client->submitQuery(query, queryConfig);
-            std::cout << "Query submitted with ID: " << queryId << std::endl;
-            
-            // Wait for the query to process some data
-            std::cout << "Waiting for query to process data (20 seconds)..." << std::endl;
-            std::this_thread::sleep_for(std::chrono::seconds(20));
-
-            // Check query status
-            std::string status = client->getQueryStatus(queryId);
-            std::cout << "Query status: " << status << std::endl;
-            
-            // Stop the query
-            std::cout << "Stopping query..." << std::endl;
-            auto stopResult = client->stopQuery(queryId);
-            
-            // Stop measuring execution time
-            auto endTime = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-            
-            std::cout << "Query stopped, result: " << (stopResult ? "success" : "failed") << std::endl;
-            std::cout << "Query execution time: " << duration.count() << " milliseconds" << std::endl;
-            
-        } else {
-            std::cerr << "Failed to connect to NebulaStream server." << std::endl;
-            return 1;
-        }
-        
-        return 0;
-    } catch (const Client::ClientException& e) {
-        std::cerr << "Client Exception: " << e.what() << std::endl;
-        return 1;
-    } catch (const std::exception& e) {
-        std::cerr << "Error: " << e.what() << std::endl;
-        return 1;
-    }
-}
\ No newline at end of file
+using SNCB::Driver::QueryDefinition;
+
+int main(int argc, char** argv) {
+    QueryDefinition query1{"query1", "query1.csv", [](const std::string& sinkPath) {
+        // Sum the speed of alarm records while the train is inside a high-risk area
+        return Query::from("sncb")
+            .filter((Attribute("Code1") != 0 || Attribute("Code2") != 0))
+            .window(ThresholdWindow::of(teintersects(Attribute("longitude", BasicType::FLOAT64),
+                                                     Attribute("latitude", BasicType::FLOAT64),
+                                                     Attribute("timestamp", BasicType::UINT64)) == 1))
+            .apply(Sum(Attribute("speed", BasicType::UINT64)))
+            .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+    }};
+
+    return SNCB::Driver::runMain(argc, argv, {query1});
+}
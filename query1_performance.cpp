@@ -7,6 +7,7 @@
 #include <vector>
 #include <atomic>
 #include <iomanip>
+#include <optional>
 
 // Include NebulaStream headers (based on working query1.cpp)
 #include <API/QueryAPI.hpp>
@@ -17,9 +18,9 @@
 #include <Types/SlidingWindow.hpp>
 #include <Types/WindowType.hpp>
 #include <Util/TimeMeasurement.hpp>
-#include <Client/ClientException.hpp>
-#include <Client/QueryConfig.hpp>
-#include <Client/RemoteClient.hpp>
+#include <Operators/LogicalOperators/Sinks/FileSinkDescriptor.hpp>
+
+#include <Driver/QueryRunner.hpp>
 
 using namespace std;
 using namespace NES;
@@ -30,31 +31,27 @@ struct PerformanceMetrics {
     uint64_t totalTuples = 0;
     uint64_t totalResults = 0;
     double throughputTuplesPerSecond = 0.0;
-    double latencyMs = 0.0;
+    // Submission to first result in the sink, measured with --lifecycle completion only. The coordinator does
+    // not expose ingestion times, so per-result latency is measured by LocalQuery --latency instead.
+    std::optional<double> timeToFirstResultMs;
     double processingTimeMs = 0.0;
     bool querySuccess = false;
+    std::string outputFile;
 };
 
 class Query1PerformanceBenchmark {
 private:
-    std::shared_ptr<Client::RemoteClient> client;
-    const std::string coordinatorIp;
-    const int coordinatorPort;
+    SNCB::Driver::QueryRunner runner;
     const std::string sourceName;
     
 public:
-    Query1PerformanceBenchmark(const std::string& ip = "127.0.0.1", 
-                               int port = 8081, 
-                               const std::string& source = "sncb") 
-        : coordinatorIp(ip), coordinatorPort(port), sourceName(source) {}
+    explicit Query1PerformanceBenchmark(SNCB::Driver::RunConfig config, const std::string& source = "sncb")
+        : runner(std::move(config)), sourceName(source) {}
     
     bool connectToCoordinator() {
         try {
             std::cout << "\n=== SNCB Query1 Performance Benchmark ===" << std::endl;
-            std::cout << "Connecting to NebulaStream coordinator at " << coordinatorIp << ":" << coordinatorPort << std::endl;
-            
-            client = std::make_shared<Client::RemoteClient>(coordinatorIp, coordinatorPort, std::chrono::seconds(30), true);
-            bool connected = client->testConnection();
+            bool connected = runner.connect();
             
             if (connected) {
                 std::cout << "✓ Successfully connected to NebulaStream coordinator!" << std::endl;
@@ -69,7 +66,7 @@ public:
         }
     }
     
-    Query createGeospatialQuery() {
+    SNCB::Driver::QueryDefinition createGeospatialQuery() {
         std::cout << "\nCreating geospatial query with:" << std::endl;
         std::cout << "  - Source: " << sourceName << std::endl;
         std::cout << "  - Filter: (Code1 != 0 || Code2 != 0)" << std::endl;
@@ -77,69 +74,43 @@ public:
         std::cout << "  - Aggregation: Sum(speed)" << std::endl;
         
         // Your actual geospatial query with ThresholdWindow and teintersects
-        Query query = Query::from(sourceName)
-                .filter((Attribute("Code1") != 0 || Attribute("Code2") != 0))
-                .window(ThresholdWindow::of(teintersects(Attribute("longitude", BasicType::FLOAT64),
-                                Attribute("latitude", BasicType::FLOAT64),
-                                Attribute("timestamp", BasicType::UINT64)) == 1))
-                .apply(Sum(Attribute("speed", BasicType::UINT64)))
-                .sink(FileSinkDescriptor::create("query1_performance_results.csv", "CSV_FORMAT", "APPEND"));
-        
-        return query;
+        return {"query1_performance", "query1_performance_results.csv", [source = sourceName](const std::string& sinkPath) {
+                    return Query::from(source)
+                        .filter((Attribute("Code1") != 0 || Attribute("Code2") != 0))
+                        .window(ThresholdWindow::of(teintersects(Attribute("longitude", BasicType::FLOAT64),
+                                                                 Attribute("latitude", BasicType::FLOAT64),
+                                                                 Attribute("timestamp", BasicType::UINT64)) == 1))
+                        .apply(Sum(Attribute("speed", BasicType::UINT64)))
+                        .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+                }};
     }
     
-    PerformanceMetrics runPerformanceTest(int durationSeconds = 60) {
+    PerformanceMetrics runPerformanceTest() {
         PerformanceMetrics metrics;
         
         try {
-            // Create the actual geospatial query
-            Query query = createGeospatialQuery();
-            
-            // Configure query execution
-            Client::QueryConfig queryConfig;
-            queryConfig.setPlacementType(Optimizer::PlacementStrategy::TopDown);
-            
             std::cout << "\n=== Starting Performance Test ===" << std::endl;
-            std::cout << "Test duration: " << durationSeconds << " seconds" << std::endl;
+            std::cout << "Test duration: " << runner.getConfig().duration.count() << " seconds" << std::endl;
             
             // Record start time
             metrics.startTime = std::chrono::high_resolution_clock::now();
             
-            // Submit the query
-            std::cout << "Submitting geospatial query..." << std::endl;
-            QueryId queryId = client->submitQuery(query, queryConfig);
-            std::cout << "✓ Query submitted with ID: " << queryId << std::endl;
-            
-            // Monitor query during execution
-            std::cout << "\nMonitoring query execution..." << std::endl;
-            std::cout << "Time(s) | Status" << std::endl;
-            std::cout << "--------|--------" << std::endl;
-            
-            for (int i = 0; i < durationSeconds; i += 5) {
-                std::this_thread::sleep_for(std::chrono::seconds(5));
-                
-                try {
-                    std::string status = client->getQueryStatus(queryId);
-                    std::cout << std::setw(7) << (i+5) << " | " << status << std::endl;
-                } catch (const std::exception& e) {
-                    std::cout << std::setw(7) << (i+5) << " | ERROR: " << e.what() << std::endl;
-                }
-            }
-            
-            // Record processing time before stopping
-            auto processingEndTime = std::chrono::high_resolution_clock::now();
-            metrics.processingTimeMs = std::chrono::duration<double, std::milli>(processingEndTime - metrics.startTime).count();
-            
-            // Stop the query
-            std::cout << "\nStopping query..." << std::endl;
-            bool stopResult = client->stopQuery(queryId);
+            // Submit, monitor and stop the query
+            auto definition = createGeospatialQuery();
+            metrics.outputFile = runner.resolveSinkPath(definition, 1);
+            SNCB::Driver::RunResult result = runner.run(definition);
             
             // Record end time
             metrics.endTime = std::chrono::high_resolution_clock::now();
+            metrics.processingTimeMs = static_cast<double>(result.executionTime.count());
+            metrics.querySuccess = result.success();
+            // Records the query appended to its sink, counted incrementally by the runner
+            metrics.totalResults = result.totalResults();
+            if (!result.queries.empty() && result.queries.front().timeToFirstResult) {
+                metrics.timeToFirstResultMs = static_cast<double>(result.queries.front().timeToFirstResult->count());
+            }
             
-            metrics.querySuccess = stopResult;
-            
-            if (stopResult) {
+            if (metrics.querySuccess) {
                 std::cout << "✓ Query stopped successfully" << std::endl;
             } else {
                 std::cout << "✗ Failed to stop query properly" << std::endl;
@@ -158,33 +129,10 @@ public:
         auto totalDuration = std::chrono::duration<double>(metrics.endTime - metrics.startTime);
         double totalTimeSeconds = totalDuration.count();
         
-        // Try to get tuple count from output file
-        metrics.totalResults = countResultTuples("query1_performance_results.csv");
-        
         // Calculate throughput (results per second)
         if (totalTimeSeconds > 0) {
             metrics.throughputTuplesPerSecond = metrics.totalResults / totalTimeSeconds;
         }
-        
-        // Latency is processing time
-        metrics.latencyMs = metrics.processingTimeMs;
-    }
-    
-    uint64_t countResultTuples(const std::string& filename) {
-        std::ifstream file(filename);
-        uint64_t count = 0;
-        std::string line;
-        
-        if (file.is_open()) {
-            while (std::getline(file, line)) {
-                if (!line.empty() && line.find(',') != std::string::npos) {
-                    count++;
-                }
-            }
-            file.close();
-        }
-        
-        return count;
     }
     
     void printResults(const PerformanceMetrics& metrics) {
@@ -193,7 +141,12 @@ public:
         std::cout << "Processing Time: " << std::fixed << std::setprecision(2) << metrics.processingTimeMs << " ms" << std::endl;
         std::cout << "Total Results: " << metrics.totalResults << " tuples" << std::endl;
         std::cout << "Throughput: " << std::fixed << std::setprecision(2) << metrics.throughputTuplesPerSecond << " results/second" << std::endl;
-        std::cout << "Average Latency: " << std::fixed << std::setprecision(2) << metrics.latencyMs << " ms" << std::endl;
+        if (metrics.timeToFirstResultMs) {
+            std::cout << "Time to First Result: " << std::fixed << std::setprecision(2) << *metrics.timeToFirstResultMs << " ms" << std::endl;
+        } else {
+            std::cout << "Time to First Result: not measured (run with --lifecycle completion)" << std::endl;
+        }
+        std::cout << "Per-result latency: see LocalQuery --query Query1 --latency" << std::endl;
         
         // Additional metrics
         auto totalDuration = std::chrono::duration<double>(metrics.endTime - metrics.startTime);
@@ -204,7 +157,7 @@ public:
         std::cout << "Filter: (Code1 != 0 || Code2 != 0)" << std::endl;
         std::cout << "Window: ThresholdWindow with teintersects geospatial function" << std::endl;
         std::cout << "Aggregation: Sum(speed)" << std::endl;
-        std::cout << "Output: query1_performance_results.csv" << std::endl;
+        std::cout << "Output: " << metrics.outputFile << std::endl;
     }
     
     void saveResultsToFile(const PerformanceMetrics& metrics, const std::string& filename = "query1_benchmark_summary.csv") {
@@ -214,7 +167,7 @@ public:
             // Write header if file is empty
             file.seekp(0, std::ios::end);
             if (file.tellp() == 0) {
-                file << "timestamp,query_success,processing_time_ms,total_results,throughput_results_per_sec,latency_ms,source,filter,window,aggregation\n";
+                file << "timestamp,query_success,processing_time_ms,total_results,throughput_results_per_sec,time_to_first_result_ms,source,filter,window,aggregation\n";
             }
             
             // Write results
@@ -226,7 +179,7 @@ public:
                  << std::fixed << std::setprecision(2) << metrics.processingTimeMs << ","
                  << metrics.totalResults << ","
                  << std::fixed << std::setprecision(2) << metrics.throughputTuplesPerSecond << ","
-                 << std::fixed << std::setprecision(2) << metrics.latencyMs << ","
+                 << (metrics.timeToFirstResultMs ? std::to_string(*metrics.timeToFirstResultMs) : "") << ","
                  << sourceName << ","
                  << "\"(Code1 != 0 || Code2 != 0)\"" << ","
                  << "\"ThresholdWindow(teintersects)\"" << ","
@@ -240,18 +193,23 @@ public:
     }
 };
 
-int main() {
+int main(int argc, char** argv) {
     try {
+        SNCB::Driver::RunConfig defaults;
+        defaults.clientTimeout = std::chrono::seconds(30);
+        defaults.duration = std::chrono::seconds(60);
+        defaults.statusInterval = std::chrono::seconds(5);
+
         // Create benchmark instance
-        Query1PerformanceBenchmark benchmark;
+        Query1PerformanceBenchmark benchmark(SNCB::Driver::RunConfig::fromArgs(argc, argv, defaults));
         
         // Connect to coordinator
         if (!benchmark.connectToCoordinator()) {
             return 1;
         }
         
-        // Run performance test (60 seconds)
-        PerformanceMetrics metrics = benchmark.runPerformanceTest(60);
+        // Run performance test
+        PerformanceMetrics metrics = benchmark.runPerformanceTest();
         
         // Calculate final metrics
         benchmark.calculateMetrics(metrics);
@@ -268,4 +226,4 @@ int main() {
         std::cerr << "Benchmark error: " << e.what() << std::endl;
         return 1;
     }
-} 
\ No newline at end of file
+}
@@ -7,187 +7,348 @@
 #include <vector>
 #include <sstream>
 #include <cstdlib>
-#include <sys/wait.h>
+#include <iomanip>
+#include <optional>
+#include <atomic>
 #include <unistd.h>
+#include <stdexcept>
+
+#include <Bench/ChildProcess.hpp>
+#include <Bench/ResourceSampler.hpp>
+#include <Bench/SinkTailReader.hpp>
+#include <Bench/Statistics.hpp>
 
 using namespace std;
 namespace fs = std::filesystem;
 
+struct BenchmarkOptions {
+    // Query driver that is started once per iteration, plus arguments passed through unchanged
+    std::string driver = "./Query1";
+    std::vector<std::string> driverArgs;
+    // Optional commands for a coordinator and worker that live for the whole benchmark
+    std::string coordinatorCommand;
+    std::string workerCommand;
+    int startupDelaySeconds = 5;
+    int warmupIterations = 1;
+    int iterations = 5;
+    int durationSeconds = 60;
+    // "fixed" runs every iteration for durationSeconds, "completion" lets the driver end it early
+    std::string lifecycle = "fixed";
+    int sampleIntervalMs = 1000;
+    std::string outputFile = "query1.csv";
+    std::string resultsFile = "query1_benchmark_results.csv";
+    std::string logFile = "query1_benchmark.log";
+    // Resource sampling of harness, driver, coordinator and worker; 0 disables it
+    int resourceIntervalMs = 10;
+    bool perThread = false;
+    pid_t workerPid = 0;
+    std::string samplesFile = "query1_benchmark_samples.csv";
+    bool showSample = false;
+};
+
 struct BenchmarkMetrics {
     std::chrono::high_resolution_clock::time_point startTime;
     std::chrono::high_resolution_clock::time_point endTime;
+    int iteration = 0;
+    bool warmup = false;
     size_t totalResults = 0;
     size_t initialFileSize = 0;
     size_t finalFileSize = 0;
     double throughputResultsPerSecond = 0.0;
     double totalDurationSeconds = 0.0;
+    double timeToFirstResultSeconds = -1.0;
+    int exitCode = -1;
+    SNCB::Bench::ResourceSummary driverResources;
+    SNCB::Bench::ResourceSummary workerResources;
     bool querySuccess = false;
     std::string outputFile;
 };
 
+// Processes whose peak and mean resources get columns in the results CSV
+static const std::vector<std::string> summarizedProcesses = {"driver", "worker"};
+
+static std::string resultsHeader() {
+    std::string header = "timestamp,iteration,lifecycle,query_success,duration_seconds,time_to_first_result_seconds,"
+                         "data_generated_bytes,total_results,throughput_results_per_sec";
+    for (const auto& process : summarizedProcesses) {
+        for (const auto* column : {"max_rss_kb", "avg_rss_kb", "cpu_seconds", "avg_cpu_percent", "max_cpu_percent",
+                                   "avg_read_kb_per_sec", "max_read_kb_per_sec", "avg_write_kb_per_sec",
+                                   "max_write_kb_per_sec"}) {
+            header += "," + process + "_" + column;
+        }
+    }
+    return header + ",query_type";
+}
+
+static void writeResources(std::ostream& out, const SNCB::Bench::ResourceSummary& resources) {
+    out << ',' << resources.maxRssKb << ',' << resources.averageRssKb << ',' << resources.cpuSeconds << ','
+        << resources.averageCpuPercent << ',' << resources.maxCpuPercent << ',' << resources.averageReadKbPerSecond << ','
+        << resources.maxReadKbPerSecond << ',' << resources.averageWriteKbPerSecond << ',' << resources.maxWriteKbPerSecond;
+}
+
 class Query1SimpleBenchmark {
 private:
-    const std::string outputFile = "query1.csv";
-    const std::string resultsFile = "query1_benchmark_results.csv";
-    
+    BenchmarkOptions options;
+    std::optional<SNCB::Bench::ChildProcess> coordinator;
+    std::optional<SNCB::Bench::ChildProcess> worker;
+    std::ofstream samplesOut;
+
+    std::vector<std::string> driverCommand() const {
+        std::vector<std::string> command{options.driver,
+                                         "--sink", options.outputFile,
+                                         "--duration", std::to_string(options.durationSeconds),
+                                         "--lifecycle", options.lifecycle};
+        command.insert(command.end(), options.driverArgs.begin(), options.driverArgs.end());
+        return command;
+    }
+
 public:
-    BenchmarkMetrics runBenchmark(int durationSeconds = 60) {
-        BenchmarkMetrics metrics;
-        metrics.outputFile = outputFile;
-        
-        std::cout << "\n=== SNCB Query1 Simple Performance Benchmark ===" << std::endl;
-        std::cout << "Monitoring Query1 output file: " << outputFile << std::endl;
-        std::cout << "Benchmark duration: " << durationSeconds << " seconds" << std::endl;
-        
-        // Check if output file exists and get initial size
-        if (fs::exists(outputFile)) {
-            metrics.initialFileSize = fs::file_size(outputFile);
-            std::cout << "Initial output file size: " << metrics.initialFileSize << " bytes" << std::endl;
-        } else {
-            std::cout << "Output file doesn't exist yet - will be created by Query1" << std::endl;
-            metrics.initialFileSize = 0;
+    explicit Query1SimpleBenchmark(BenchmarkOptions options) : options(std::move(options)) {}
+
+    void startInfrastructure() {
+        if (options.coordinatorCommand.empty() && options.workerCommand.empty()) {
+            return;
         }
-        
-        // Record start time
-        metrics.startTime = std::chrono::high_resolution_clock::now();
-        
-        std::cout << "\n=== Instructions ===" << std::endl;
-        std::cout << "1. Start your coordinator: ./nebulaQueryAPI/coordinator.yaml" << std::endl;
-        std::cout << "2. Start your worker: ./nebulaQueryAPI/worker.yaml" << std::endl;
-        std::cout << "3. Run Query1: ./query1" << std::endl;
-        std::cout << "4. This benchmark will monitor the output file for " << durationSeconds << " seconds" << std::endl;
-        std::cout << "\nPress ENTER when your Query1 is running..." << std::endl;
-        std::cin.get();
-        
-        // Monitor the query execution
-        std::cout << "\n=== Monitoring Query1 Execution ===" << std::endl;
+        if (!options.coordinatorCommand.empty()) {
+            std::cout << "Starting coordinator: " << options.coordinatorCommand << std::endl;
+            coordinator = SNCB::Bench::ChildProcess::spawnShell(options.coordinatorCommand, options.logFile);
+            std::this_thread::sleep_for(std::chrono::seconds(options.startupDelaySeconds));
+        }
+        if (!options.workerCommand.empty()) {
+            std::cout << "Starting worker: " << options.workerCommand << std::endl;
+            worker = SNCB::Bench::ChildProcess::spawnShell(options.workerCommand, options.logFile);
+            std::this_thread::sleep_for(std::chrono::seconds(options.startupDelaySeconds));
+        }
+        if ((coordinator && !coordinator->isRunning()) || (worker && !worker->isRunning())) {
+            throw std::runtime_error("coordinator or worker exited during startup, see " + options.logFile);
+        }
+    }
+
+    void stopInfrastructure() {
+        // Worker first, so it does not spend the shutdown reconnecting to a stopped coordinator
+        worker.reset();
+        coordinator.reset();
+    }
+
+    BenchmarkMetrics runIteration(int iteration, bool warmup) {
+        BenchmarkMetrics metrics;
+        metrics.iteration = iteration;
+        metrics.warmup = warmup;
+        metrics.outputFile = options.outputFile;
+
+        // The file sink appends, so every iteration starts from an empty sink
+        std::error_code error;
+        fs::remove(options.outputFile, error);
+        SNCB::Bench::SinkTailReader sinkReader(options.outputFile, 0, true);
+        std::atomic<uint64_t> sinkRecords{0};
+
+        std::cout << "\n=== " << (warmup ? "Warmup" : "Iteration") << " " << iteration << " ===" << std::endl;
         std::cout << "Time(s) | File Size (bytes) | New Results | Cumulative Results" << std::endl;
         std::cout << "--------|-------------------|-------------|-------------------" << std::endl;
-        
-        size_t previousResults = 0;
-        
-        for (int i = 0; i < durationSeconds; i += 5) {
-            std::this_thread::sleep_for(std::chrono::seconds(5));
-            
-            size_t currentFileSize = 0;
-            size_t currentResults = 0;
-            
-            if (fs::exists(outputFile)) {
-                currentFileSize = fs::file_size(outputFile);
-                currentResults = countResultLines(outputFile);
+
+        metrics.startTime = std::chrono::high_resolution_clock::now();
+        auto driver = SNCB::Bench::ChildProcess::spawn(driverCommand(), options.logFile);
+
+        std::optional<SNCB::Bench::ResourceSampler> sampler;
+        if (options.resourceIntervalMs > 0) {
+            sampler.emplace(std::chrono::milliseconds(options.resourceIntervalMs), options.perThread);
+            sampler->watch(::getpid(), "harness");
+            sampler->watch(driver.getPid(), "driver");
+            if (coordinator) {
+                sampler->watch(coordinator->getPid(), "coordinator");
+            }
+            if (worker) {
+                sampler->watch(worker->getPid(), "worker");
+            } else if (options.workerPid > 0) {
+                sampler->watch(options.workerPid, "worker");
             }
-            
-            size_t newResults = currentResults - previousResults;
-            previousResults = currentResults;
-            
-            std::cout << std::setw(7) << (i+5) << " | " 
-                      << std::setw(17) << currentFileSize << " | "
+            sampler->setProgressProbe([&sinkRecords] { return sinkRecords.load(std::memory_order_relaxed); });
+            sampler->start();
+        }
+
+        // The driver stops the query after the duration; the deadline only catches a hanging driver
+        auto deadline = metrics.startTime + std::chrono::seconds(options.durationSeconds * 2 + 30);
+        auto interval = std::chrono::milliseconds(options.sampleIntervalMs);
+        std::optional<int> exitCode;
+        while (!(exitCode = driver.wait(interval))) {
+            auto now = std::chrono::high_resolution_clock::now();
+            size_t newResults = sinkReader.poll();
+            sinkRecords.store(sinkReader.getRecords(), std::memory_order_relaxed);
+            if (newResults > 0 && metrics.timeToFirstResultSeconds < 0) {
+                metrics.timeToFirstResultSeconds = std::chrono::duration<double>(now - metrics.startTime).count();
+            }
+            std::cout << std::setw(7) << std::fixed << std::setprecision(1)
+                      << std::chrono::duration<double>(now - metrics.startTime).count() << " | "
+                      << std::setw(17) << sinkReader.getOffset() << " | "
                       << std::setw(11) << newResults << " | "
-                      << std::setw(17) << currentResults << std::endl;
+                      << std::setw(17) << sinkReader.getRecords() << std::endl;
+            if (now >= deadline) {
+                std::cerr << "Driver did not finish in time, terminating it" << std::endl;
+                exitCode = driver.terminate();
+                break;
+            }
         }
-        
-        // Record end time and final measurements
         metrics.endTime = std::chrono::high_resolution_clock::now();
-        
-        if (fs::exists(outputFile)) {
-            metrics.finalFileSize = fs::file_size(outputFile);
-            metrics.totalResults = countResultLines(outputFile);
-            metrics.querySuccess = true;
-        } else {
-            metrics.querySuccess = false;
+        metrics.exitCode = exitCode.value_or(-1);
+
+        if (sinkReader.poll() > 0 && metrics.timeToFirstResultSeconds < 0) {
+            metrics.timeToFirstResultSeconds = std::chrono::duration<double>(metrics.endTime - metrics.startTime).count();
         }
-        
+        metrics.finalFileSize = sinkReader.getOffset();
+        metrics.totalResults = sinkReader.getRecords();
+        sinkRecords.store(metrics.totalResults, std::memory_order_relaxed);
+        if (sampler) {
+            sampler->stop();
+            recordResources(*sampler, metrics);
+        }
+        metrics.querySuccess = metrics.exitCode == 0 && fs::exists(options.outputFile);
+        calculateMetrics(metrics);
         return metrics;
     }
-    
-    size_t countResultLines(const std::string& filename) {
-        std::ifstream file(filename);
-        size_t count = 0;
-        std::string line;
-        
-        if (file.is_open()) {
-            while (std::getline(file, line)) {
-                // Skip empty lines and potential headers
-                if (!line.empty() && line.find(',') != std::string::npos) {
-                    count++;
-                }
+
+    void recordResources(const SNCB::Bench::ResourceSampler& sampler, BenchmarkMetrics& metrics) {
+        metrics.driverResources = sampler.getSummary("driver");
+        metrics.workerResources = sampler.getSummary("worker");
+
+        // The results CSV gets peak and mean per iteration; one row per sample, with the sink records at that time next to the resource counters
+        if (!samplesOut.is_open()) {
+            samplesOut.open(options.samplesFile, std::ios::app);
+            samplesOut.seekp(0, std::ios::end);
+            if (samplesOut.tellp() == 0) {
+                SNCB::Bench::ResourceSampler::writeCsvHeader(samplesOut);
             }
-            file.close();
         }
-        
-        return count;
+        std::string run = (metrics.warmup ? "warmup" : "iteration") + std::to_string(metrics.iteration);
+        sampler.writeCsv(samplesOut, run);
+        samplesOut.flush();
+    }
+
+    std::vector<BenchmarkMetrics> runBenchmark() {
+        std::cout << "\n=== SNCB Query1 Simple Performance Benchmark ===" << std::endl;
+        std::cout << "Driver: " << options.driver << " (" << options.lifecycle << ", " << options.durationSeconds
+                  << " seconds)" << std::endl;
+        std::cout << "Warmup iterations: " << options.warmupIterations << ", measured iterations: " << options.iterations
+                  << std::endl;
+
+        std::vector<BenchmarkMetrics> runs;
+        for (int i = 1; i <= options.warmupIterations; ++i) {
+            runIteration(i, true);
+        }
+        for (int i = 1; i <= options.iterations; ++i) {
+            runs.push_back(runIteration(i, false));
+            printResults(runs.back());
+        }
+        return runs;
     }
-    
+
     void calculateMetrics(BenchmarkMetrics& metrics) {
         auto duration = std::chrono::duration<double>(metrics.endTime - metrics.startTime);
         metrics.totalDurationSeconds = duration.count();
-        
+
         if (metrics.totalDurationSeconds > 0) {
             metrics.throughputResultsPerSecond = metrics.totalResults / metrics.totalDurationSeconds;
         }
     }
-    
+
     void printResults(const BenchmarkMetrics& metrics) {
-        std::cout << "\n=== SNCB Query1 Performance Results ===" << std::endl;
-        std::cout << "Query Success: " << (metrics.querySuccess ? "YES" : "NO") << std::endl;
+        std::cout << "\n=== SNCB Query1 Performance Results (iteration " << metrics.iteration << ") ===" << std::endl;
+        std::cout << "Query Success: " << (metrics.querySuccess ? "YES" : "NO") << " (exit code " << metrics.exitCode << ")" << std::endl;
         std::cout << "Total Duration: " << std::fixed << std::setprecision(2) << metrics.totalDurationSeconds << " seconds" << std::endl;
-        std::cout << "Initial File Size: " << metrics.initialFileSize << " bytes" << std::endl;
-        std::cout << "Final File Size: " << metrics.finalFileSize << " bytes" << std::endl;
         std::cout << "Data Generated: " << (metrics.finalFileSize - metrics.initialFileSize) << " bytes" << std::endl;
         std::cout << "Total Results: " << metrics.totalResults << " tuples" << std::endl;
+        std::cout << "Time To First Result: " << std::fixed << std::setprecision(2) << metrics.timeToFirstResultSeconds << " seconds" << std::endl;
         std::cout << "Throughput: " << std::fixed << std::setprecision(2) << metrics.throughputResultsPerSecond << " results/second" << std::endl;
-        
+        if (options.resourceIntervalMs > 0) {
+            const auto& driver = metrics.driverResources;
+            const auto& worker = metrics.workerResources;
+            std::cout << "Driver Max/Avg Memory: " << std::fixed << std::setprecision(2) << driver.maxRssKb / 1024.0 << " / "
+                      << driver.averageRssKb / 1024.0 << " MB" << std::endl;
+            std::cout << "Driver Avg/Max CPU: " << driver.averageCpuPercent << " / " << driver.maxCpuPercent << " %" << std::endl;
+            if (worker.maxRssKb > 0) {
+                std::cout << "Worker Max/Avg Memory: " << worker.maxRssKb / 1024.0 << " / " << worker.averageRssKb / 1024.0 << " MB" << std::endl;
+                std::cout << "Worker CPU Time: " << worker.cpuSeconds << " seconds (avg/max " << worker.averageCpuPercent << " / "
+                          << worker.maxCpuPercent << " %)" << std::endl;
+                std::cout << "Worker Avg Read/Write: " << worker.averageReadKbPerSecond << " / " << worker.averageWriteKbPerSecond
+                          << " KiB/s" << std::endl;
+            }
+        }
+    }
+
+    void printSummary(const std::vector<BenchmarkMetrics>& runs) {
+        std::vector<double> throughputs;
+        std::vector<double> durations;
+        size_t failures = 0;
+        for (const auto& run : runs) {
+            throughputs.push_back(run.throughputResultsPerSecond);
+            durations.push_back(run.totalDurationSeconds);
+            failures += run.querySuccess ? 0 : 1;
+        }
+        auto throughput = SNCB::Bench::summarize(throughputs);
+        auto duration = SNCB::Bench::summarize(durations);
+
+        std::cout << "\n=== SNCB Query1 Benchmark Summary (" << runs.size() << " iterations, " << failures << " failed) ===" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Throughput median: " << throughput.median << " results/second" << std::endl;
+        std::cout << "Throughput p95:    " << throughput.p95 << " results/second" << std::endl;
+        std::cout << "Throughput stddev: " << throughput.stddev << " results/second" << std::endl;
+        std::cout << "Throughput min/max: " << throughput.min << " / " << throughput.max << " results/second" << std::endl;
+        std::cout << "Duration median:   " << duration.median << " seconds" << std::endl;
+
         std::cout << "\n=== Query Details ===" << std::endl;
         std::cout << "Source: sncb (real SNCB data)" << std::endl;
         std::cout << "Filter: (Code1 != 0 || Code2 != 0)" << std::endl;
         std::cout << "Window: ThresholdWindow with teintersects geospatial function" << std::endl;
         std::cout << "Aggregation: Sum(speed)" << std::endl;
-        std::cout << "Output File: " << metrics.outputFile << std::endl;
+        std::cout << "Output File: " << options.outputFile << std::endl;
     }
-    
-    void saveResults(const BenchmarkMetrics& metrics) {
-        std::ofstream file(resultsFile, std::ios::app);
-        
+
+    void saveResults(const std::vector<BenchmarkMetrics>& runs) {
+        std::ofstream file(options.resultsFile, std::ios::app);
+
         if (file.is_open()) {
             // Write header if file is empty
             file.seekp(0, std::ios::end);
             if (file.tellp() == 0) {
-                file << "timestamp,query_success,duration_seconds,initial_file_size,final_file_size,data_generated_bytes,total_results,throughput_results_per_sec,query_type\n";
+                file << resultsHeader() << "\n";
             }
-            
-            // Write results
+
             auto now = std::chrono::system_clock::now();
             auto time_t = std::chrono::system_clock::to_time_t(now);
-            
-            file << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S") << ","
-                 << (metrics.querySuccess ? "true" : "false") << ","
-                 << std::fixed << std::setprecision(2) << metrics.totalDurationSeconds << ","
-                 << metrics.initialFileSize << ","
-                 << metrics.finalFileSize << ","
-                 << (metrics.finalFileSize - metrics.initialFileSize) << ","
-                 << metrics.totalResults << ","
-                 << std::fixed << std::setprecision(2) << metrics.throughputResultsPerSecond << ","
-                 << "\"SNCB Query1 Geospatial (ThresholdWindow + teintersects)\"" << std::endl;
-            
+
+            for (const auto& metrics : runs) {
+                file << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S") << ","
+                     << metrics.iteration << ","
+                     << options.lifecycle << ","
+                     << (metrics.querySuccess ? "true" : "false") << ","
+                     << std::fixed << std::setprecision(2) << metrics.totalDurationSeconds << ","
+                     << metrics.timeToFirstResultSeconds << ","
+                     << (metrics.finalFileSize - metrics.initialFileSize) << ","
+                     << metrics.totalResults << ","
+                     << std::fixed << std::setprecision(2) << metrics.throughputResultsPerSecond;
+                writeResources(file, metrics.driverResources);
+                writeResources(file, metrics.workerResources);
+                file << ",\"SNCB Query1 Geospatial (ThresholdWindow + teintersects)\"" << std::endl;
+            }
+
             file.close();
-            std::cout << "\n✓ Results saved to " << resultsFile << std::endl;
+            std::cout << "\n✓ Results saved to " << options.resultsFile << std::endl;
         } else {
-            std::cerr << "✗ Failed to save results to " << resultsFile << std::endl;
+            std::cerr << "✗ Failed to save results to " << options.resultsFile << std::endl;
         }
     }
-    
+
     void showSampleResults(const std::string& filename, int maxLines = 10) {
         if (!fs::exists(filename)) {
             std::cout << "\n⚠️  Output file not found: " << filename << std::endl;
             return;
         }
-        
+
         std::ifstream file(filename);
         std::string line;
         int lineCount = 0;
-        
+
         std::cout << "\n=== Sample Query Results (first " << maxLines << " lines) ===" << std::endl;
-        
+
         if (file.is_open()) {
             while (std::getline(file, line) && lineCount < maxLines) {
                 if (!line.empty()) {
@@ -196,7 +357,7 @@ public:
                 }
             }
             file.close();
-            
+
             if (lineCount == 0) {
                 std::cout << "(No results found in output file)" << std::endl;
             }
@@ -204,32 +365,140 @@ public:
     }
 };
 
-int main() {
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options] [-- driver arguments]\n"
+              << "  --driver path            query driver started per iteration (default ./Query1)\n"
+              << "  --coordinator-cmd cmd    start a coordinator for the whole benchmark\n"
+              << "  --worker-cmd cmd         start a worker for the whole benchmark\n"
+              << "  --startup-delay seconds  wait after starting coordinator and worker (default 5)\n"
+              << "  --warmup n               unmeasured iterations (default 1)\n"
+              << "  --iterations k           measured iterations (default 5)\n"
+              << "  --duration seconds       query duration per iteration (default 60)\n"
+              << "  --lifecycle fixed|completion\n"
+              << "  --sample-interval-ms ms  sink sampling interval (default 1000)\n"
+              << "  --sink path              sink file of the driver (default query1.csv)\n"
+              << "  --results path           results CSV (default query1_benchmark_results.csv)\n"
+              << "  --log path               log of all started processes (default query1_benchmark.log)\n"
+              << "  --resource-interval-ms ms  /proc sampling interval, 0 disables it (default 10)\n"
+              << "  --per-thread             also sample CPU time and context switches of every thread\n"
+              << "  --worker-pid pid         sample an already running worker\n"
+              << "  --samples path           resource samples CSV (default query1_benchmark_samples.csv)\n"
+              << "  --show-sample            print the first lines of the last sink\n"
+              << "Arguments after -- are passed to the driver, e.g. -- --coordinator 192.168.0.238:8081" << std::endl;
+}
+
+static int parseCount(const std::string& flag, const std::string& value, int minimum) {
     try {
-        Query1SimpleBenchmark benchmark;
-        
-        // Run the benchmark (60 seconds)
-        BenchmarkMetrics metrics = benchmark.runBenchmark(60);
-        
-        // Calculate final metrics
-        benchmark.calculateMetrics(metrics);
-        
-        // Print results
-        benchmark.printResults(metrics);
-        
-        // Show sample output
-        benchmark.showSampleResults(metrics.outputFile);
-        
-        // Save results
-        benchmark.saveResults(metrics);
-        
+        size_t consumed = 0;
+        int parsed = std::stoi(value, &consumed);
+        if (consumed == value.size() && parsed >= minimum) {
+            return parsed;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument(flag + " expects an integer >= " + std::to_string(minimum) + ", got '" + value + "'");
+}
+
+static BenchmarkOptions parseOptions(int argc, char** argv) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--") {
+            options.driverArgs.assign(argv + i + 1, argv + argc);
+            break;
+        }
+        if (flag == "--show-sample") {
+            options.showSample = true;
+            continue;
+        }
+        if (flag == "--per-thread") {
+            options.perThread = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + flag);
+        }
+        std::string value = argv[++i];
+        if (flag == "--driver") {
+            options.driver = value;
+        } else if (flag == "--coordinator-cmd") {
+            options.coordinatorCommand = value;
+        } else if (flag == "--worker-cmd") {
+            options.workerCommand = value;
+        } else if (flag == "--startup-delay") {
+            options.startupDelaySeconds = parseCount(flag, value, 0);
+        } else if (flag == "--warmup") {
+            options.warmupIterations = parseCount(flag, value, 0);
+        } else if (flag == "--iterations") {
+            options.iterations = parseCount(flag, value, 1);
+        } else if (flag == "--duration") {
+            options.durationSeconds = parseCount(flag, value, 1);
+        } else if (flag == "--lifecycle") {
+            if (value != "fixed" && value != "completion") {
+                throw std::invalid_argument("--lifecycle expects fixed or completion, got '" + value + "'");
+            }
+            options.lifecycle = value;
+        } else if (flag == "--sample-interval-ms") {
+            options.sampleIntervalMs = parseCount(flag, value, 1);
+        } else if (flag == "--resource-interval-ms") {
+            options.resourceIntervalMs = parseCount(flag, value, 0);
+        } else if (flag == "--worker-pid") {
+            options.workerPid = parseCount(flag, value, 1);
+        } else if (flag == "--samples") {
+            options.samplesFile = value;
+        } else if (flag == "--sink") {
+            options.outputFile = value;
+        } else if (flag == "--results") {
+            options.resultsFile = value;
+        } else if (flag == "--log") {
+            options.logFile = value;
+        } else {
+            throw std::invalid_argument("unknown option " + flag);
+        }
+    }
+    // Rows are appended, so an existing results file must have the same columns
+    std::ifstream existing(options.resultsFile);
+    std::string header;
+    if (std::getline(existing, header) && header != resultsHeader()) {
+        throw std::invalid_argument(options.resultsFile + " has other columns; pass another --results path");
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc && std::string(argv[i]) != "--"; ++i) {
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+    }
+
+    try {
+        BenchmarkOptions options = parseOptions(argc, argv);
+        Query1SimpleBenchmark benchmark(options);
+
+        benchmark.startInfrastructure();
+        std::vector<BenchmarkMetrics> runs = benchmark.runBenchmark();
+        benchmark.stopInfrastructure();
+
+        // Print and save the statistics over all measured iterations
+        benchmark.printSummary(runs);
+        if (options.showSample) {
+            benchmark.showSampleResults(options.outputFile);
+        }
+        benchmark.saveResults(runs);
+
         std::cout << "\n=== Benchmark Complete ===" << std::endl;
-        std::cout << "Use this data to compare against other queries or optimizations!" << std::endl;
-        
-        return metrics.querySuccess ? 0 : 1;
-        
+
+        for (const auto& run : runs) {
+            if (!run.querySuccess) {
+                return 1;
+            }
+        }
+        return 0;
+
     } catch (const std::exception& e) {
         std::cerr << "Benchmark error: " << e.what() << std::endl;
         return 1;
     }
-} 
\ No newline at end of file
+}
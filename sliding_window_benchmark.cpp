@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <Bench/Statistics.hpp>
+#include <Engine/Operators.hpp>
+#include <Engine/Query.hpp>
+
+using namespace SNCB::Engine;
+
+struct WindowConfig {
+    uint64_t sizeMs;
+    uint64_t slideMs;
+};
+
+struct SlidingBenchmarkOptions {
+    // Defaults: the windows of query6/querytrysamewindow and of queryCFA
+    std::vector<WindowConfig> windows;
+    size_t tuples = 1000000;
+    uint64_t intervalMs = 100;
+    size_t tuplesPerBuffer = 1024;
+    int repetitions = 5;
+};
+
+/** @brief End of the pipeline that only counts the windows it receives. */
+class CountingSink : public ExecutableOperator {
+  public:
+    explicit CountingSink(SchemaPtr schema) : ExecutableOperator(std::move(schema)) {}
+    void execute(TupleBuffer& buffer) override { windows += buffer.getNumberOfTuples(); }
+    uint64_t windows = 0;
+};
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "Measures the sliding window operator on nrok5-like tuples held in memory, with Min and Max of\n"
+              << "PCFA_bar and PCFF_bar as in query6, and what its slices took from their arena.\n"
+              << "  --window size_ms/slide_ms  window to measure, repeatable (default 10000/10 and 10000/1000)\n"
+              << "  --tuples n                 tuples per run (default 1000000)\n"
+              << "  --interval-ms n            timestamp distance of consecutive tuples (default 100)\n"
+              << "  --buffer-tuples n          tuples per buffer (default 1024)\n"
+              << "  --repetitions n            measured runs per window (default 5)" << std::endl;
+}
+
+static uint64_t parseNumber(const std::string& flag, const std::string& value) {
+    try {
+        size_t consumed = 0;
+        auto parsed = std::stoull(value, &consumed);
+        if (consumed == value.size() && parsed > 0) {
+            return parsed;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument(flag + " expects a positive integer, got '" + value + "'");
+}
+
+static SlidingBenchmarkOptions parseOptions(int argc, char** argv) {
+    SlidingBenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + flag);
+        }
+        std::string value = argv[++i];
+        if (flag == "--window") {
+            auto separator = value.find('/');
+            if (separator == std::string::npos) {
+                throw std::invalid_argument("--window expects size_ms/slide_ms, got '" + value + "'");
+            }
+            options.windows.push_back({parseNumber(flag, value.substr(0, separator)), parseNumber(flag, value.substr(separator + 1))});
+        } else if (flag == "--tuples") {
+            options.tuples = parseNumber(flag, value);
+        } else if (flag == "--interval-ms") {
+            options.intervalMs = parseNumber(flag, value);
+        } else if (flag == "--buffer-tuples") {
+            options.tuplesPerBuffer = parseNumber(flag, value);
+        } else if (flag == "--repetitions") {
+            options.repetitions = static_cast<int>(parseNumber(flag, value));
+        } else {
+            throw std::invalid_argument("unknown option " + flag);
+        }
+    }
+    if (options.windows.empty()) {
+        options.windows = {{10000, 10}, {10000, 1000}};
+    }
+    return options;
+}
+
+static std::vector<TupleBuffer> generateInput(const SlidingBenchmarkOptions& options, const SchemaPtr& schema) {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> pcfa(4.0, 5.0);
+    std::uniform_real_distribution<double> pcff(5.0, 5.3);
+    std::vector<TupleBuffer> buffers;
+    uint64_t timestamp = 1719784681000;
+    for (size_t tuple = 0; tuple < options.tuples; ++tuple, timestamp += options.intervalMs) {
+        if (buffers.empty() || buffers.back().isFull()) {
+            buffers.emplace_back(schema, options.tuplesPerBuffer);
+        }
+        auto& buffer = buffers.back();
+        auto row = buffer.append();
+        buffer.setUInt(row, 0, timestamp);
+        buffer.setDouble(row, 1, pcfa(random));
+        buffer.setDouble(row, 2, pcff(random));
+    }
+    return buffers;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+    }
+
+    try {
+        auto options = parseOptions(argc, argv);
+        auto schema = std::make_shared<Schema>();
+        schema->addField("timestamp", DataType::UINT64).addField("PCFA_bar", DataType::FLOAT64).addField("PCFF_bar", DataType::FLOAT64);
+        auto input = generateInput(options, schema);
+
+        std::cout << "=== Sliding Window Benchmark: " << options.tuples << " tuples, one every " << options.intervalMs
+                  << " ms ===" << std::endl;
+        for (const auto& config : options.windows) {
+            WindowOperator window;
+            window.window = SlidingWindow::of(EventTime(Attribute("timestamp")), Milliseconds(config.sizeMs),
+                                              Milliseconds(config.slideMs));
+            window.aggregations = {Min(Attribute("PCFA_bar"))->as(Attribute("PCFA_min_value")),
+                                   Max(Attribute("PCFA_bar"))->as(Attribute("PCFA_max_value")),
+                                   Min(Attribute("PCFF_bar"))->as(Attribute("PCFF_min_value")),
+                                   Max(Attribute("PCFF_bar"))->as(Attribute("PCFF_max_value"))};
+
+            std::vector<double> nanosPerTuple;
+            uint64_t windows = 0;
+            ArenaStatistics arena;
+            // The first run warms caches and the allocator and is not measured
+            for (int run = 0; run <= options.repetitions; ++run) {
+                TimeWindowExecutable windowOperator(window, schema, nullptr, options.tuplesPerBuffer);
+                windowOperator.setNext(std::make_unique<CountingSink>(windowOperator.getOutputSchema()));
+                auto start = std::chrono::steady_clock::now();
+                for (auto& buffer : input) {
+                    windowOperator.execute(buffer);
+                }
+                windowOperator.finish();
+                auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                if (run > 0) {
+                    nanosPerTuple.push_back(elapsed / static_cast<double>(options.tuples));
+                }
+                windows = static_cast<CountingSink*>(windowOperator.getNext())->windows;
+                arena = windowOperator.getArenaStatistics();
+            }
+
+            auto summary = SNCB::Bench::summarize(nanosPerTuple);
+            std::cout << std::fixed << std::setprecision(1) << config.sizeMs << " ms / " << config.slideMs
+                      << " ms: " << config.sizeMs / config.slideMs << " overlapping windows, " << windows
+                      << " windows emitted, median " << summary.median << " ns/tuple (p95 " << summary.p95 << ", stddev "
+                      << summary.stddev << "), " << summary.median * static_cast<double>(options.tuples) / static_cast<double>(windows)
+                      << " ns/window, " << std::setprecision(0) << 1e9 / summary.median << " tuples/s" << std::endl;
+            std::cout << std::setprecision(1) << "  slice arena: " << arena.allocations << " allocations, "
+                      << 100.0 * static_cast<double>(arena.reuses) / static_cast<double>(std::max(arena.allocations, uint64_t{1}))
+                      << " % reused, peak " << arena.peakLiveRecords << " live records in " << arena.slabs << " slabs of "
+                      << arena.reservedBytes / 1024 << " KiB" << std::endl;
+        }
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,137 @@
+#include <Bench/ChildProcess.hpp>
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+namespace SNCB::Bench {
+
+namespace {
+
+int decodeStatus(int status) {
+    if (WIFEXITED(status)) {
+        return WEXITSTATUS(status);
+    }
+    if (WIFSIGNALED(status)) {
+        return 128 + WTERMSIG(status);
+    }
+    return -1;
+}
+
+}// namespace
+
+ChildProcess ChildProcess::spawn(const std::vector<std::string>& argv, const std::string& logFile) {
+    if (argv.empty()) {
+        throw std::invalid_argument("ChildProcess::spawn needs at least the program name");
+    }
+    // Build the exec arguments before forking, the child must not allocate
+    std::vector<char*> arguments;
+    for (const auto& argument : argv) {
+        arguments.push_back(const_cast<char*>(argument.c_str()));
+    }
+    arguments.push_back(nullptr);
+
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        throw std::runtime_error("fork failed: " + std::string(std::strerror(errno)));
+    }
+    if (pid == 0) {
+        // Own process group, so terminate() also reaches whatever the child starts itself
+        ::setpgid(0, 0);
+        if (!logFile.empty()) {
+            int fd = ::open(logFile.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+            if (fd >= 0) {
+                ::dup2(fd, STDOUT_FILENO);
+                ::dup2(fd, STDERR_FILENO);
+                ::close(fd);
+            }
+        }
+        ::execvp(arguments[0], arguments.data());
+        _exit(127);
+    }
+    return ChildProcess(pid);
+}
+
+ChildProcess ChildProcess::spawnShell(const std::string& command, const std::string& logFile) {
+    return spawn({"/bin/sh", "-c", "exec " + command}, logFile);
+}
+
+ChildProcess::ChildProcess(pid_t pid) : pid(pid) {}
+
+ChildProcess::~ChildProcess() {
+    if (pid > 0 && !exitCode) {
+        terminate();
+    }
+}
+
+ChildProcess::ChildProcess(ChildProcess&& other) noexcept
+    : pid(std::exchange(other.pid, -1)), exitCode(std::move(other.exitCode)) {}
+
+ChildProcess& ChildProcess::operator=(ChildProcess&& other) noexcept {
+    if (this != &other) {
+        if (pid > 0 && !exitCode) {
+            terminate();
+        }
+        pid = std::exchange(other.pid, -1);
+        exitCode = std::move(other.exitCode);
+    }
+    return *this;
+}
+
+std::optional<int> ChildProcess::wait(std::optional<std::chrono::milliseconds> timeout) {
+    if (exitCode || pid <= 0) {
+        return exitCode;
+    }
+    int status = 0;
+    if (!timeout) {
+        while (::waitpid(pid, &status, 0) < 0) {
+            if (errno != EINTR) {
+                return std::nullopt;
+            }
+        }
+        exitCode = decodeStatus(status);
+        return exitCode;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + *timeout;
+    while (true) {
+        pid_t result = ::waitpid(pid, &status, WNOHANG);
+        if (result == pid) {
+            exitCode = decodeStatus(status);
+            return exitCode;
+        }
+        if (result < 0 && errno != EINTR) {
+            return std::nullopt;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return std::nullopt;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+int ChildProcess::terminate(std::chrono::milliseconds grace) {
+    if (exitCode || pid <= 0) {
+        return exitCode.value_or(-1);
+    }
+    ::kill(-pid, SIGTERM);
+    ::kill(pid, SIGTERM);
+    if (auto code = wait(grace)) {
+        return *code;
+    }
+    ::kill(-pid, SIGKILL);
+    ::kill(pid, SIGKILL);
+    return wait().value_or(-1);
+}
+
+bool ChildProcess::isRunning() { return pid > 0 && !wait(std::chrono::milliseconds(0)); }
+
+pid_t ChildProcess::getPid() const { return pid; }
+
+}// namespace SNCB::Bench
@@ -0,0 +1,135 @@
+#include <Bench/E2EConfig.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+
+namespace SNCB::Bench {
+
+std::vector<std::string> splitSweepValues(const std::string& value) {
+    std::vector<std::string> items;
+    size_t begin = 0;
+    while (true) {
+        auto end = value.find(',', begin);
+        auto item = value.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+        auto first = item.find_first_not_of(" \t");
+        auto last = item.find_last_not_of(" \t");
+        items.push_back(first == std::string::npos ? "" : item.substr(first, last - first + 1));
+        if (end == std::string::npos) {
+            return items;
+        }
+        begin = end + 1;
+    }
+}
+
+bool isSweepNumber(const std::string& value) {
+    if (value.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    std::strtod(value.c_str(), &end);
+    return end == value.c_str() + value.size();
+}
+
+bool SweepPoint::has(const std::string& name) const {
+    for (const auto& [parameter, value] : values) {
+        if (parameter == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t SweepPoint::getUInt(const std::string& name, uint64_t fallback) const {
+    for (const auto& [parameter, value] : values) {
+        if (parameter == name) {
+            return std::strtoull(value.c_str(), nullptr, 10);
+        }
+    }
+    return fallback;
+}
+
+double SweepPoint::getDouble(const std::string& name, double fallback) const {
+    for (const auto& [parameter, value] : values) {
+        if (parameter == name) {
+            return std::strtod(value.c_str(), nullptr);
+        }
+    }
+    return fallback;
+}
+
+E2EConfig E2EConfig::load(const std::string& path) {
+    E2EConfig config;
+    config.path = path;
+    config.root = Util::YamlNode::parseFile(path);
+    config.benchmarkName = config.root["benchmarkName"].asString(std::filesystem::path(path).stem().string());
+    if (config.root.has("query")) {
+        config.queries.push_back(config.root["query"].asString());
+    }
+    for (const auto& item : config.root["querySet"].items()) {
+        config.queries.push_back(item["query"].asString());
+    }
+    if (config.queries.empty()) {
+        throw std::invalid_argument(path + " has neither a query nor a querySet");
+    }
+    for (const auto& [name, value] : config.root.entries()) {
+        if (value.getKind() != Util::YamlNode::Kind::Scalar) {
+            continue;
+        }
+        auto values = splitSweepValues(value.asString());
+        bool numeric = true;
+        for (const auto& item : values) {
+            numeric &= isSweepNumber(item);
+        }
+        if (numeric) {
+            config.parameters.push_back({name, std::move(values)});
+        }
+    }
+    return config;
+}
+
+const std::string& E2EConfig::getPath() const { return path; }
+
+const std::string& E2EConfig::getBenchmarkName() const { return benchmarkName; }
+
+const std::vector<std::string>& E2EConfig::getQueries() const { return queries; }
+
+const Util::YamlNode& E2EConfig::getRoot() const { return root; }
+
+const std::vector<SweepParameter>& E2EConfig::getParameters() const { return parameters; }
+
+void E2EConfig::setParameter(const std::string& name, const std::vector<std::string>& values) {
+    if (values.empty()) {
+        throw std::invalid_argument("Parameter " + name + " needs at least one value");
+    }
+    for (const auto& value : values) {
+        if (!isSweepNumber(value)) {
+            throw std::invalid_argument("Parameter " + name + " expects numbers, got '" + value + "'");
+        }
+    }
+    for (auto& parameter : parameters) {
+        if (parameter.name == name) {
+            parameter.values = values;
+            return;
+        }
+    }
+    parameters.push_back({name, values});
+}
+
+std::vector<SweepPoint> E2EConfig::expand() const {
+    std::vector<SweepPoint> points(1);
+    for (const auto& parameter : parameters) {
+        std::vector<SweepPoint> expanded;
+        expanded.reserve(points.size() * parameter.values.size());
+        for (const auto& point : points) {
+            for (const auto& value : parameter.values) {
+                expanded.push_back(point);
+                expanded.back().values.emplace_back(parameter.name, value);
+            }
+        }
+        points = std::move(expanded);
+    }
+    return points;
+}
+
+}// namespace SNCB::Bench
@@ -0,0 +1,258 @@
+#include <Bench/ResourceSampler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <string_view>
+#include <unistd.h>
+#include <utility>
+
+namespace SNCB::Bench {
+
+namespace {
+
+using Buffer = std::array<char, 4096>;
+
+/** @brief Reads a small /proc file with a single read call, which procfs serves atomically. */
+std::string_view readProcFile(const std::string& path, Buffer& buffer) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return {};
+    }
+    auto bytesRead = ::read(fd, buffer.data(), buffer.size() - 1);
+    ::close(fd);
+    if (bytesRead <= 0) {
+        return {};
+    }
+    buffer[static_cast<size_t>(bytesRead)] = '\0';
+    return {buffer.data(), static_cast<size_t>(bytesRead)};
+}
+
+/** @brief Value of a "key: value" line of /proc/<pid>/status or /proc/<pid>/io, 0 if missing. */
+uint64_t keyValue(std::string_view content, std::string_view key) {
+    size_t position = 0;
+    while (position < content.size()) {
+        auto lineEnd = content.find('\n', position);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = content.size();
+        }
+        auto line = content.substr(position, lineEnd - position);
+        if (line.size() > key.size() && line.substr(0, key.size()) == key && line[key.size()] == ':') {
+            return std::strtoull(line.data() + key.size() + 1, nullptr, 10);
+        }
+        position = lineEnd + 1;
+    }
+    return 0;
+}
+
+const uint64_t clockTicksPerSecond = static_cast<uint64_t>(::sysconf(_SC_CLK_TCK));
+
+}// namespace
+
+ResourceSampler::ResourceSampler(std::chrono::microseconds interval, bool perThread)
+    : interval(interval), perThread(perThread) {}
+
+ResourceSampler::~ResourceSampler() { stop(); }
+
+void ResourceSampler::watch(pid_t pid, std::string process) { targets.push_back({pid, std::move(process)}); }
+
+void ResourceSampler::setProgressProbe(std::function<uint64_t()> probe) { progressProbe = std::move(probe); }
+
+void ResourceSampler::start() {
+    if (thread.joinable()) {
+        return;
+    }
+    stopping = false;
+    startTime = std::chrono::steady_clock::now();
+    thread = std::thread([this] { run(); });
+}
+
+void ResourceSampler::stop() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    stopRequested.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void ResourceSampler::run() {
+    // Sample on a fixed grid so a slow tick does not shift all following ones
+    auto next = startTime;
+    std::unique_lock lock(mutex);
+    while (true) {
+        lock.unlock();
+        sampleAll(std::chrono::steady_clock::now());
+        lock.lock();
+        next += interval;
+        auto now = std::chrono::steady_clock::now();
+        if (next < now) {
+            next = now;
+        }
+        if (stopRequested.wait_until(lock, next, [this] { return stopping; })) {
+            lock.unlock();
+            sampleAll(std::chrono::steady_clock::now());
+            return;
+        }
+    }
+}
+
+void ResourceSampler::sampleAll(std::chrono::steady_clock::time_point now) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - startTime);
+    uint64_t progress = progressProbe ? progressProbe() : 0;
+
+    for (const auto& target : targets) {
+        ResourceSample processSample;
+        if (!sample(target.pid, 0, processSample)) {
+            continue;
+        }
+        processSample.elapsed = elapsed;
+        processSample.process = target.process;
+        processSample.progress = progress;
+        samples.push_back(std::move(processSample));
+
+        if (!perThread) {
+            continue;
+        }
+        std::string taskDirectory = "/proc/" + std::to_string(target.pid) + "/task";
+        DIR* directory = ::opendir(taskDirectory.c_str());
+        if (directory == nullptr) {
+            continue;
+        }
+        while (auto* entry = ::readdir(directory)) {
+            if (entry->d_name[0] == '.') {
+                continue;
+            }
+            ResourceSample threadSample;
+            auto tid = static_cast<pid_t>(std::strtol(entry->d_name, nullptr, 10));
+            if (!sample(target.pid, tid, threadSample)) {
+                continue;
+            }
+            threadSample.elapsed = elapsed;
+            threadSample.process = target.process;
+            threadSample.progress = progress;
+            samples.push_back(std::move(threadSample));
+        }
+        ::closedir(directory);
+    }
+}
+
+bool ResourceSampler::sample(pid_t pid, pid_t tid, ResourceSample& sample) {
+    std::string base = "/proc/" + std::to_string(pid);
+    if (tid != 0) {
+        base += "/task/" + std::to_string(tid);
+    }
+    sample.pid = pid;
+    sample.tid = tid;
+
+    Buffer buffer;
+    auto stat = readProcFile(base + "/stat", buffer);
+    // The command name is in parentheses and may itself contain spaces and parentheses
+    auto nameStart = stat.find('(');
+    auto nameEnd = stat.rfind(')');
+    if (nameStart == std::string_view::npos || nameEnd == std::string_view::npos || nameEnd < nameStart) {
+        return false;
+    }
+    sample.threadName = std::string(stat.substr(nameStart + 1, nameEnd - nameStart - 1));
+
+    // Fields after the name, starting with field 3 (state), see proc(5)
+    std::array<uint64_t, 22> fields{};
+    const char* cursor = stat.data() + nameEnd + 2;
+    for (size_t field = 0; field < fields.size() && *cursor != '\0'; ++field) {
+        fields[field] = field == 0 ? 0 : std::strtoull(cursor, nullptr, 10);
+        cursor = std::strchr(cursor, ' ');
+        if (cursor == nullptr) {
+            break;
+        }
+        ++cursor;
+    }
+    sample.minorFaults = fields[10 - 3];
+    sample.majorFaults = fields[12 - 3];
+    sample.userCpuUs = fields[14 - 3] * 1000000 / clockTicksPerSecond;
+    sample.systemCpuUs = fields[15 - 3] * 1000000 / clockTicksPerSecond;
+    sample.threads = fields[20 - 3];
+
+    auto status = readProcFile(base + "/status", buffer);
+    sample.rssKb = keyValue(status, "VmRSS");
+    sample.voluntaryContextSwitches = keyValue(status, "voluntary_ctxt_switches");
+    sample.involuntaryContextSwitches = keyValue(status, "nonvoluntary_ctxt_switches");
+
+    // Only readable for own processes, other counters stay meaningful without it
+    auto io = readProcFile(base + "/io", buffer);
+    sample.readChars = keyValue(io, "rchar");
+    sample.writeChars = keyValue(io, "wchar");
+    sample.readBytes = keyValue(io, "read_bytes");
+    sample.writeBytes = keyValue(io, "write_bytes");
+    return true;
+}
+
+const std::vector<ResourceSample>& ResourceSampler::getSamples() const { return samples; }
+
+ResourceSummary ResourceSampler::getSummary(const std::string& process) const {
+    ResourceSummary summary;
+    const ResourceSample* first = nullptr;
+    // Start of the span the next peak is measured over
+    const ResourceSample* spanStart = nullptr;
+    const ResourceSample* previous = nullptr;
+    double totalRssKb = 0.0;
+    size_t count = 0;
+    for (const auto& sample : samples) {
+        if (sample.tid != 0 || sample.process != process) {
+            continue;
+        }
+        summary.maxRssKb = std::max(summary.maxRssKb, sample.rssKb);
+        totalRssKb += static_cast<double>(sample.rssKb);
+        ++count;
+        if (first == nullptr) {
+            first = &sample;
+            spanStart = &sample;
+        } else if (sample.elapsed - spanStart->elapsed >= PeakSpan) {
+            double seconds = std::chrono::duration<double>(sample.elapsed - spanStart->elapsed).count();
+            auto cpuUs = (sample.userCpuUs + sample.systemCpuUs) - (spanStart->userCpuUs + spanStart->systemCpuUs);
+            summary.maxCpuPercent = std::max(summary.maxCpuPercent, static_cast<double>(cpuUs) / 1e4 / seconds);
+            summary.maxReadKbPerSecond =
+                std::max(summary.maxReadKbPerSecond, static_cast<double>(sample.readChars - spanStart->readChars) / 1024.0 / seconds);
+            summary.maxWriteKbPerSecond =
+                std::max(summary.maxWriteKbPerSecond, static_cast<double>(sample.writeChars - spanStart->writeChars) / 1024.0 / seconds);
+            spanStart = &sample;
+        }
+        previous = &sample;
+    }
+    if (first == nullptr) {
+        return summary;
+    }
+    summary.averageRssKb = totalRssKb / static_cast<double>(count);
+    auto cpuUs = (previous->userCpuUs + previous->systemCpuUs) - (first->userCpuUs + first->systemCpuUs);
+    summary.cpuSeconds = static_cast<double>(cpuUs) / 1e6;
+    if (previous->elapsed > first->elapsed) {
+        double seconds = std::chrono::duration<double>(previous->elapsed - first->elapsed).count();
+        summary.averageCpuPercent = summary.cpuSeconds * 100.0 / seconds;
+        summary.averageReadKbPerSecond = static_cast<double>(previous->readChars - first->readChars) / 1024.0 / seconds;
+        summary.averageWriteKbPerSecond = static_cast<double>(previous->writeChars - first->writeChars) / 1024.0 / seconds;
+    }
+    return summary;
+}
+
+void ResourceSampler::writeCsvHeader(std::ostream& out) {
+    out << "run,elapsed_us,process,pid,tid,thread_name,rss_kb,minor_faults,major_faults,voluntary_ctx_switches,"
+           "involuntary_ctx_switches,user_cpu_us,system_cpu_us,threads,read_chars,write_chars,read_bytes,write_bytes,"
+           "progress\n";
+}
+
+void ResourceSampler::writeCsv(std::ostream& out, const std::string& run) const {
+    for (const auto& sample : samples) {
+        out << run << ',' << sample.elapsed.count() << ',' << sample.process << ',' << sample.pid << ',' << sample.tid
+            << ",\"" << sample.threadName << "\"," << sample.rssKb << ',' << sample.minorFaults << ','
+            << sample.majorFaults << ',' << sample.voluntaryContextSwitches << ','
+            << sample.involuntaryContextSwitches << ',' << sample.userCpuUs << ',' << sample.systemCpuUs << ','
+            << sample.threads << ',' << sample.readChars << ',' << sample.writeChars << ',' << sample.readBytes << ','
+            << sample.writeBytes << ',' << sample.progress << '\n';
+    }
+}
+
+}// namespace SNCB::Bench
@@ -0,0 +1,114 @@
+#include <Bench/SinkTailReader.hpp>
+
+#include <Util/ByteScan.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace SNCB::Bench {
+
+SinkTailReader::SinkTailReader(std::string path, uint64_t startOffset, bool skipHeader, size_t blockSize)
+    : path(std::move(path)), offset(startOffset), skipHeader(skipHeader), headerPending(skipHeader && startOffset == 0),
+      block(blockSize) {}
+
+SinkTailReader::~SinkTailReader() { close(); }
+
+SinkTailReader::SinkTailReader(SinkTailReader&& other) noexcept
+    : path(std::move(other.path)), fd(std::exchange(other.fd, -1)), offset(other.offset), records(other.records),
+      skipHeader(other.skipHeader), headerPending(other.headerPending), block(std::move(other.block)) {}
+
+SinkTailReader& SinkTailReader::operator=(SinkTailReader&& other) noexcept {
+    if (this != &other) {
+        close();
+        path = std::move(other.path);
+        fd = std::exchange(other.fd, -1);
+        offset = other.offset;
+        records = other.records;
+        skipHeader = other.skipHeader;
+        headerPending = other.headerPending;
+        block = std::move(other.block);
+    }
+    return *this;
+}
+
+SinkTailReader SinkTailReader::fromEnd(std::string path, bool skipHeader) {
+    struct stat fileStat {};
+    uint64_t size = ::stat(path.c_str(), &fileStat) == 0 ? static_cast<uint64_t>(fileStat.st_size) : 0;
+    return SinkTailReader(std::move(path), size, skipHeader);
+}
+
+bool SinkTailReader::open() {
+    fd = ::open(path.c_str(), O_RDONLY);
+    return fd >= 0;
+}
+
+void SinkTailReader::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+uint64_t SinkTailReader::poll() {
+    if (fd < 0 && !open()) {
+        return 0;
+    }
+
+    // A sink that was deleted and created again is a different inode behind the same path
+    struct stat pathStat {};
+    struct stat openStat {};
+    if (::stat(path.c_str(), &pathStat) != 0 || ::fstat(fd, &openStat) != 0) {
+        return 0;
+    }
+    if (pathStat.st_ino != openStat.st_ino || pathStat.st_dev != openStat.st_dev) {
+        close();
+        if (!open()) {
+            return 0;
+        }
+        offset = 0;
+        headerPending = skipHeader;
+    }
+
+    auto size = static_cast<uint64_t>(pathStat.st_size);
+    if (size < offset) {
+        offset = 0;
+        headerPending = skipHeader;
+    }
+
+    uint64_t newRecords = 0;
+    while (offset < size) {
+        auto toRead = static_cast<size_t>(std::min<uint64_t>(block.size(), size - offset));
+        auto bytesRead = ::pread(fd, block.data(), toRead, static_cast<off_t>(offset));
+        if (bytesRead <= 0) {
+            break;
+        }
+        const char* data = block.data();
+        auto length = static_cast<size_t>(bytesRead);
+        offset += length;
+
+        if (headerPending) {
+            auto* headerEnd = static_cast<const char*>(std::memchr(data, '\n', length));
+            if (headerEnd == nullptr) {
+                continue;
+            }
+            headerPending = false;
+            length -= static_cast<size_t>(headerEnd + 1 - data);
+            data = headerEnd + 1;
+        }
+        newRecords += Util::countNewlines(data, length);
+    }
+    records += newRecords;
+    return newRecords;
+}
+
+uint64_t SinkTailReader::getRecords() const { return records; }
+
+uint64_t SinkTailReader::getOffset() const { return offset; }
+
+const std::string& SinkTailReader::getPath() const { return path; }
+
+}// namespace SNCB::Bench
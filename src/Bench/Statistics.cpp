@@ -0,0 +1,42 @@
+#include <Bench/Statistics.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace SNCB::Bench {
+
+double percentile(const std::vector<double>& sortedValues, double percent) {
+    if (sortedValues.empty()) {
+        return 0.0;
+    }
+    double rank = std::clamp(percent, 0.0, 100.0) / 100.0 * static_cast<double>(sortedValues.size() - 1);
+    auto lower = static_cast<size_t>(std::floor(rank));
+    auto upper = static_cast<size_t>(std::ceil(rank));
+    double weight = rank - static_cast<double>(lower);
+    return sortedValues[lower] + (sortedValues[upper] - sortedValues[lower]) * weight;
+}
+
+Summary summarize(std::vector<double> values) {
+    Summary summary;
+    summary.count = values.size();
+    if (values.empty()) {
+        return summary;
+    }
+    std::sort(values.begin(), values.end());
+    summary.min = values.front();
+    summary.max = values.back();
+    summary.mean = std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+    summary.median = percentile(values, 50.0);
+    summary.p95 = percentile(values, 95.0);
+    if (values.size() > 1) {
+        double squares = 0.0;
+        for (double value : values) {
+            squares += (value - summary.mean) * (value - summary.mean);
+        }
+        summary.stddev = std::sqrt(squares / static_cast<double>(values.size() - 1));
+    }
+    return summary;
+}
+
+}// namespace SNCB::Bench
@@ -0,0 +1,184 @@
+#include <Driver/QueryLifecycle.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+namespace SNCB::Driver {
+
+namespace {
+
+// Returns the string value of "key" in a flat JSON document, or an empty string
+std::string extractJsonString(const std::string& json, const std::string& key) {
+    auto keyPosition = json.find("\"" + key + "\"");
+    if (keyPosition == std::string::npos) {
+        return {};
+    }
+    auto colon = json.find(':', keyPosition + key.size() + 2);
+    if (colon == std::string::npos) {
+        return {};
+    }
+    auto open = json.find('"', colon);
+    if (open == std::string::npos) {
+        return {};
+    }
+    auto close = json.find('"', open + 1);
+    return close == std::string::npos ? std::string{} : json.substr(open + 1, close - open - 1);
+}
+
+std::string trim(const std::string& value) {
+    auto begin = std::find_if_not(value.begin(), value.end(), [](unsigned char c) { return std::isspace(c); });
+    auto end = std::find_if_not(value.rbegin(), value.rend(), [](unsigned char c) { return std::isspace(c); }).base();
+    return begin < end ? std::string(begin, end) : std::string{};
+}
+
+}// namespace
+
+LifecycleMode parseLifecycleMode(const std::string& name) {
+    if (name == "fixed") {
+        return LifecycleMode::FixedDuration;
+    }
+    if (name == "completion") {
+        return LifecycleMode::Completion;
+    }
+    throw std::invalid_argument("Unsupported lifecycle mode: '" + name + "' (expected fixed or completion)");
+}
+
+std::string toString(LifecycleMode mode) { return mode == LifecycleMode::Completion ? "completion" : "fixed"; }
+
+QueryState parseQueryState(const std::string& statusResponse) {
+    std::string status = extractJsonString(statusResponse, "queryStatus");
+    if (status.empty()) {
+        status = extractJsonString(statusResponse, "status");
+    }
+    if (status.empty()) {
+        status = trim(statusResponse);
+    }
+
+    if (status == "RUNNING" || status == "DEPLOYED" || status == "MARKED_FOR_HARD_STOP" || status == "MARKED_FOR_SOFT_STOP"
+        || status == "SOFT_STOP_TRIGGERED" || status == "MIGRATING" || status == "RESTARTING") {
+        return QueryState::Running;
+    }
+    if (status == "REGISTERED" || status == "OPTIMIZING" || status == "MARKED_FOR_DEPLOYMENT"
+        || status == "MARKED_FOR_REDEPLOYMENT") {
+        return QueryState::Pending;
+    }
+    if (status == "STOPPED" || status == "SOFT_STOP_COMPLETED") {
+        return QueryState::Stopped;
+    }
+    if (status == "FAILED" || status == "MARKED_FOR_FAILURE") {
+        return QueryState::Failed;
+    }
+    return QueryState::Unknown;
+}
+
+bool isTerminal(QueryState state) { return state == QueryState::Stopped || state == QueryState::Failed; }
+
+std::string toString(QueryState state) {
+    switch (state) {
+        case QueryState::Pending: return "PENDING";
+        case QueryState::Running: return "RUNNING";
+        case QueryState::Stopped: return "STOPPED";
+        case QueryState::Failed: return "FAILED";
+        case QueryState::Unknown: break;
+    }
+    return "UNKNOWN";
+}
+
+std::string toString(CompletionReason reason) {
+    switch (reason) {
+        case CompletionReason::Terminal: return "terminal state";
+        case CompletionReason::SinkIdle: return "sink idle";
+        case CompletionReason::Timeout: break;
+    }
+    return "timeout";
+}
+
+std::optional<std::chrono::milliseconds> QueryProgress::timeToDrain() const {
+    if (!timeToFirstResult || !timeOfLastResult) {
+        return std::nullopt;
+    }
+    return *timeOfLastResult - *timeToFirstResult;
+}
+
+uint64_t sinkFileSize(const std::string& sinkPath) {
+    std::error_code error;
+    auto size = std::filesystem::file_size(sinkPath, error);
+    return error ? 0 : static_cast<uint64_t>(size);
+}
+
+CompletionMonitor::CompletionMonitor(CompletionSettings settings, std::vector<std::string> sinkPaths)
+    : settings(settings), sinkPaths(std::move(sinkPaths)), submissionTime(std::chrono::steady_clock::now()) {
+    progress.resize(this->sinkPaths.size());
+    for (size_t i = 0; i < this->sinkPaths.size(); ++i) {
+        progress[i].initialSinkBytes = sinkFileSize(this->sinkPaths[i]);
+        progress[i].sinkBytes = progress[i].initialSinkBytes;
+    }
+}
+
+CompletionReport CompletionMonitor::waitForCompletion(const StatusProvider& statusOf) {
+    using namespace std::chrono;
+    // Sink sizes are a local stat and are checked every tick; the status is a REST round trip to the
+    // coordinator and backs off while it does not change
+    auto tick = settings.initialPollInterval;
+    auto statusInterval = settings.initialPollInterval;
+    auto nextStatusPoll = steady_clock::now();
+    auto idleLimit = settings.idleInterval * settings.idleIntervals;
+    std::optional<steady_clock::time_point> lastGrowth;
+
+    while (true) {
+        auto now = steady_clock::now();
+        auto elapsed = duration_cast<milliseconds>(now - submissionTime);
+
+        for (size_t i = 0; i < progress.size(); ++i) {
+            auto& query = progress[i];
+            auto bytes = sinkFileSize(sinkPaths[i]);
+            if (bytes > query.sinkBytes) {
+                if (!query.timeToFirstResult) {
+                    query.timeToFirstResult = elapsed;
+                }
+                query.timeOfLastResult = elapsed;
+                lastGrowth = now;
+            }
+            query.sinkBytes = bytes;
+        }
+
+        bool allTerminal = false;
+        if (now >= nextStatusPoll) {
+            bool changed = false;
+            allTerminal = !progress.empty();
+            for (size_t i = 0; i < progress.size(); ++i) {
+                QueryState state;
+                try {
+                    state = parseQueryState(statusOf(i));
+                } catch (const std::exception&) {
+                    state = QueryState::Unknown;
+                }
+                changed |= state != progress[i].state;
+                progress[i].state = state;
+                allTerminal &= isTerminal(state);
+            }
+            statusInterval = changed ? settings.initialPollInterval : std::min(statusInterval * 2, settings.maxPollInterval);
+            nextStatusPoll = now + statusInterval;
+        }
+
+        CompletionReport report;
+        report.elapsed = elapsed;
+        if (allTerminal) {
+            report.reason = CompletionReason::Terminal;
+        } else if (lastGrowth && now - *lastGrowth >= idleLimit) {
+            report.reason = CompletionReason::SinkIdle;
+        } else if (elapsed >= settings.timeout) {
+            report.reason = CompletionReason::Timeout;
+        } else {
+            std::this_thread::sleep_for(std::min(tick, settings.timeout - elapsed));
+            continue;
+        }
+        report.queries = progress;
+        return report;
+    }
+}
+
+}// namespace SNCB::Driver
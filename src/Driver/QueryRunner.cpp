@@ -0,0 +1,322 @@
+#include <Driver/QueryRunner.hpp>
+
+#include <Bench/SinkTailReader.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include <Client/ClientException.hpp>
+#include <Client/QueryConfig.hpp>
+
+namespace SNCB::Driver {
+
+namespace {
+
+std::vector<QueryDefinition> expandCopies(const std::vector<QueryDefinition>& definitions, uint32_t copies) {
+    if (copies <= 1) {
+        return definitions;
+    }
+    std::vector<QueryDefinition> expanded;
+    for (const auto& definition : definitions) {
+        std::filesystem::path sinkPath(definition.defaultSinkPath);
+        for (uint32_t copy = 0; copy < copies; ++copy) {
+            auto copySink = sinkPath.parent_path()
+                / (sinkPath.stem().string() + "_" + std::to_string(copy) + sinkPath.extension().string());
+            expanded.push_back({definition.name + "#" + std::to_string(copy), copySink.string(), definition.build});
+        }
+    }
+    return expanded;
+}
+
+std::chrono::milliseconds millisecondsSince(std::chrono::high_resolution_clock::time_point startTime) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - startTime);
+}
+
+}// namespace
+
+double QueryRunResult::throughput() const {
+    auto activeTime = std::chrono::duration<double>(stoppedAt - submittedAt).count();
+    return activeTime > 0 ? static_cast<double>(results) / activeTime : 0.0;
+}
+
+bool RunResult::success() const {
+    for (const auto& query : queries) {
+        if (!query.stopped) {
+            return false;
+        }
+    }
+    return !queries.empty();
+}
+
+uint64_t RunResult::totalResults() const {
+    uint64_t total = 0;
+    for (const auto& query : queries) {
+        total += query.results;
+    }
+    return total;
+}
+
+double RunResult::aggregateThroughput() const {
+    if (queries.empty()) {
+        return 0.0;
+    }
+    auto firstSubmission = queries.front().submittedAt;
+    auto lastStop = queries.front().stoppedAt;
+    for (const auto& query : queries) {
+        firstSubmission = std::min(firstSubmission, query.submittedAt);
+        lastStop = std::max(lastStop, query.stoppedAt);
+    }
+    auto activeTime = std::chrono::duration<double>(lastStop - firstSubmission).count();
+    return activeTime > 0 ? static_cast<double>(totalResults()) / activeTime : 0.0;
+}
+
+QueryRunner::QueryRunner(RunConfig config) : config(std::move(config)) {}
+
+bool QueryRunner::connect() {
+    std::cout << "Connecting to NebulaStream server at " << config.coordinatorHost << ":" << config.coordinatorPort << "..."
+              << std::endl;
+    client = std::make_shared<NES::Client::RemoteClient>(config.coordinatorHost,
+                                                         config.coordinatorPort,
+                                                         config.clientTimeout,
+                                                         true);
+    bool connected = client->testConnection();
+    std::cout << "Connection test: " << (connected ? "successful" : "failed") << std::endl;
+    if (!connected) {
+        client.reset();
+        return false;
+    }
+
+    if (config.listLogicalSources) {
+        std::cout << "Available logical sources:" << std::endl;
+        std::cout << client->getLogicalSources() << std::endl;
+    }
+
+    if (config.parallelism > 1) {
+        workerClients.clear();
+        for (uint32_t worker = 0; worker < config.parallelism; ++worker) {
+            workerClients.push_back(std::make_shared<NES::Client::RemoteClient>(config.coordinatorHost,
+                                                                                config.coordinatorPort,
+                                                                                config.clientTimeout,
+                                                                                false));
+        }
+        pool = std::make_unique<WorkerPool>(config.parallelism);
+    }
+    return true;
+}
+
+std::string QueryRunner::resolveSinkPath(const QueryDefinition& definition, size_t numberOfDefinitions) const {
+    if (!config.sinkPath.empty() && numberOfDefinitions == 1) {
+        return config.sinkPath;
+    }
+    if (config.outputDirectory.empty()) {
+        return definition.defaultSinkPath;
+    }
+    return (std::filesystem::path(config.outputDirectory) / definition.defaultSinkPath).string();
+}
+
+RunResult QueryRunner::run(const QueryDefinition& definition) { return run(std::vector<QueryDefinition>{definition}); }
+
+RunResult QueryRunner::run(const std::vector<QueryDefinition>& requestedDefinitions) {
+    if (!client) {
+        throw std::logic_error("QueryRunner::run called before a successful connect()");
+    }
+    auto definitions = expandCopies(requestedDefinitions, config.copies);
+    if (!config.sinkPath.empty() && definitions.size() > 1) {
+        std::cerr << "Ignoring --sink for a driver with " << definitions.size() << " queries, use --output-dir instead"
+                  << std::endl;
+    }
+
+    NES::Client::QueryConfig queryConfig;
+    queryConfig.setPlacementType(config.placement);
+
+    RunResult result;
+    std::vector<NES::Query> queries;
+    std::vector<uint64_t> initialSinkBytes;
+    for (const auto& definition : definitions) {
+        QueryRunResult queryResult;
+        queryResult.name = definition.name;
+        queryResult.sinkPath = resolveSinkPath(definition, definitions.size());
+        std::cout << "Creating query '" << queryResult.name << "' writing to " << queryResult.sinkPath << "..." << std::endl;
+        queries.push_back(definition.build(queryResult.sinkPath));
+        initialSinkBytes.push_back(sinkFileSize(queryResult.sinkPath));
+        result.queries.push_back(std::move(queryResult));
+    }
+    std::cout << "Query created successfully." << std::endl;
+
+    // The monitor records the sink sizes before submission so that appended output is told apart
+    std::optional<CompletionMonitor> monitor;
+    if (config.lifecycle == LifecycleMode::Completion) {
+        std::vector<std::string> sinkPaths;
+        for (const auto& query : result.queries) {
+            sinkPaths.push_back(query.sinkPath);
+        }
+        monitor.emplace(config.completionSettings(), std::move(sinkPaths));
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Stop whatever was already submitted if a submission fails, so no query is left running
+    try {
+        std::cout << "Submitting " << queries.size() << (queries.size() == 1 ? " query" : " queries")
+                  << (pool ? " on " + std::to_string(pool->size()) + " workers" : std::string{}) << "..." << std::endl;
+        forEachQuery(queries.size(), [&](size_t index, NES::Client::RemoteClient& workerClient) {
+            result.queries[index].queryId = workerClient.submitQuery(queries[index], queryConfig);
+            result.queries[index].submittedAt = millisecondsSince(startTime);
+        });
+        result.submissionTime = millisecondsSince(startTime);
+        for (const auto& query : result.queries) {
+            std::cout << "Query '" << query.name << "' submitted with ID: " << query.queryId << std::endl;
+        }
+
+        if (monitor) {
+            waitForCompletion(*monitor, result);
+        } else {
+            waitForDuration(result.queries);
+        }
+    } catch (...) {
+        stopSubmitted(result, startTime);
+        throw;
+    }
+
+    auto stopStart = std::chrono::high_resolution_clock::now();
+    forEachQuery(result.queries.size(), [&](size_t index, NES::Client::RemoteClient& workerClient) {
+        auto& query = result.queries[index];
+        query.finalStatus = workerClient.getQueryStatus(query.queryId);
+        auto state = parseQueryState(query.finalStatus);
+        if (monitor && isTerminal(state)) {
+            query.stopped = state == QueryState::Stopped;
+        } else {
+            query.stopped = workerClient.stopQuery(query.queryId);
+        }
+        query.stoppedAt = millisecondsSince(startTime);
+    });
+    result.stopTime = millisecondsSince(stopStart);
+    for (auto& query : result.queries) {
+        std::cout << "Query " << query.queryId << " status: " << query.finalStatus << std::endl;
+        std::cout << "Query " << query.queryId << " stopped, result: " << (query.stopped ? "success" : "failed") << std::endl;
+    }
+
+    result.executionTime = millisecondsSince(startTime);
+    std::cout << "Query execution time: " << result.executionTime.count() << " milliseconds" << std::endl;
+
+    for (size_t i = 0; i < result.queries.size(); ++i) {
+        auto& query = result.queries[i];
+        Bench::SinkTailReader sinkReader(query.sinkPath, initialSinkBytes[i], initialSinkBytes[i] == 0);
+        query.results = sinkReader.poll();
+        std::cout << "Query '" << query.name << "': " << query.results << " results, " << query.throughput()
+                  << " results/second" << std::endl;
+        if (query.timeToFirstResult) {
+            std::cout << "Query '" << query.name << "' time to first result: " << query.timeToFirstResult->count()
+                      << " milliseconds, time to drain: " << query.timeToDrain->count() << " milliseconds" << std::endl;
+        } else if (result.completionReason) {
+            std::cout << "Query '" << query.name << "' produced no results" << std::endl;
+        }
+    }
+    if (result.queries.size() > 1) {
+        std::cout << "All queries: submitted in " << result.submissionTime.count() << " milliseconds, stopped in "
+                  << result.stopTime.count() << " milliseconds, " << result.totalResults() << " results, "
+                  << result.aggregateThroughput() << " results/second" << std::endl;
+    }
+    return result;
+}
+
+void QueryRunner::forEachQuery(size_t count,
+                               const std::function<void(size_t index, NES::Client::RemoteClient& client)>& task) {
+    if (!pool) {
+        for (size_t index = 0; index < count; ++index) {
+            task(index, *client);
+        }
+        return;
+    }
+    pool->parallelFor(count, [&](size_t index, size_t worker) { task(index, *workerClients[worker]); });
+}
+
+void QueryRunner::stopSubmitted(RunResult& result, std::chrono::high_resolution_clock::time_point startTime) {
+    try {
+        forEachQuery(result.queries.size(), [&](size_t index, NES::Client::RemoteClient& workerClient) {
+            auto& query = result.queries[index];
+            if (query.queryId == NES::INVALID_QUERY_ID) {
+                return;
+            }
+            query.stopped = workerClient.stopQuery(query.queryId);
+            query.stoppedAt = millisecondsSince(startTime);
+        });
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to stop all submitted queries: " << e.what() << std::endl;
+    }
+}
+
+void QueryRunner::waitForDuration(const std::vector<QueryRunResult>& queries) const {
+    std::cout << "Waiting for query to process data (" << config.duration.count() << " seconds)..." << std::endl;
+    if (config.statusInterval.count() == 0) {
+        std::this_thread::sleep_for(config.duration);
+        return;
+    }
+
+    auto elapsed = std::chrono::seconds(0);
+    while (elapsed < config.duration) {
+        auto step = std::min(config.statusInterval, config.duration - elapsed);
+        std::this_thread::sleep_for(step);
+        elapsed += step;
+        for (const auto& query : queries) {
+            try {
+                std::cout << "[" << elapsed.count() << "s] Query " << query.queryId << " status: "
+                          << client->getQueryStatus(query.queryId) << std::endl;
+            } catch (const std::exception& e) {
+                std::cout << "[" << elapsed.count() << "s] Query " << query.queryId << " status: ERROR: " << e.what() << std::endl;
+            }
+        }
+    }
+}
+
+void QueryRunner::waitForCompletion(CompletionMonitor& monitor, RunResult& result) const {
+    std::cout << "Waiting for queries to complete (at most " << config.duration.count() << " seconds)..." << std::endl;
+    // Status polls stay on the calling thread, so the shared client is never used by two threads
+    auto report = monitor.waitForCompletion([&](size_t index) {
+        return client->getQueryStatus(result.queries[index].queryId);
+    });
+    std::cout << "Run ended after " << report.elapsed.count() << " milliseconds: " << toString(report.reason) << std::endl;
+
+    result.completionReason = report.reason;
+    for (size_t i = 0; i < result.queries.size(); ++i) {
+        result.queries[i].timeToFirstResult = report.queries[i].timeToFirstResult;
+        result.queries[i].timeToDrain = report.queries[i].timeToDrain();
+    }
+}
+
+const RunConfig& QueryRunner::getConfig() const { return config; }
+
+const std::shared_ptr<NES::Client::RemoteClient>& QueryRunner::getClient() const { return client; }
+
+int runMain(int argc, char** argv, const std::vector<QueryDefinition>& definitions, RunConfig defaults) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--help") {
+            std::cout << RunConfig::usage(argv[0]) << std::endl;
+            return 0;
+        }
+    }
+
+    try {
+        QueryRunner runner(RunConfig::fromArgs(argc, argv, std::move(defaults)));
+        if (!runner.connect()) {
+            std::cerr << "Failed to connect to NebulaStream server." << std::endl;
+            return 1;
+        }
+        std::cout << "Successfully connected to NebulaStream server!" << std::endl;
+        return runner.run(definitions).success() ? 0 : 1;
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << std::endl << RunConfig::usage(argv[0]) << std::endl;
+        return 1;
+    } catch (const NES::Client::ClientException& e) {
+        std::cerr << "Client Exception: " << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+}// namespace SNCB::Driver
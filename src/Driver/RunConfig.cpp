@@ -0,0 +1,126 @@
+#include <Driver/RunConfig.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace SNCB::Driver {
+
+namespace {
+
+long parseNumber(const std::string& flag, const std::string& value, long minimum) {
+    try {
+        size_t consumed = 0;
+        auto number = std::stol(value, &consumed);
+        if (consumed != value.size() || number < minimum) {
+            throw std::invalid_argument(value);
+        }
+        return number;
+    } catch (const std::logic_error&) {
+        throw std::invalid_argument("Invalid value for " + flag + ": '" + value + "'");
+    }
+}
+
+std::chrono::seconds parseSeconds(const std::string& flag, const std::string& value) {
+    return std::chrono::seconds(parseNumber(flag, value, 0));
+}
+
+std::chrono::milliseconds parseMilliseconds(const std::string& flag, const std::string& value) {
+    return std::chrono::milliseconds(parseNumber(flag, value, 1));
+}
+
+void parseCoordinator(const std::string& value, RunConfig& config) {
+    auto colon = value.rfind(':');
+    if (colon == std::string::npos) {
+        config.coordinatorHost = value;
+        return;
+    }
+    config.coordinatorHost = value.substr(0, colon);
+    try {
+        auto port = std::stoul(value.substr(colon + 1));
+        if (port == 0 || port > 65535) {
+            throw std::out_of_range(value);
+        }
+        config.coordinatorPort = static_cast<uint16_t>(port);
+    } catch (const std::logic_error&) {
+        throw std::invalid_argument("Invalid coordinator address: '" + value + "'");
+    }
+}
+
+}// namespace
+
+NES::Optimizer::PlacementStrategy parsePlacementStrategy(const std::string& name) {
+    if (name == "TopDown") {
+        return NES::Optimizer::PlacementStrategy::TopDown;
+    }
+    if (name == "BottomUp") {
+        return NES::Optimizer::PlacementStrategy::BottomUp;
+    }
+    throw std::invalid_argument("Unsupported placement strategy: '" + name + "' (expected TopDown or BottomUp)");
+}
+
+std::string toString(NES::Optimizer::PlacementStrategy placement) {
+    return placement == NES::Optimizer::PlacementStrategy::BottomUp ? "BottomUp" : "TopDown";
+}
+
+RunConfig RunConfig::fromArgs(int argc, char** argv, RunConfig defaults) {
+    RunConfig config = std::move(defaults);
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (flag == "--list-sources") {
+            config.listLogicalSources = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + flag);
+        }
+        const std::string value = argv[++i];
+        if (flag == "--coordinator") {
+            parseCoordinator(value, config);
+        } else if (flag == "--duration") {
+            config.duration = parseSeconds(flag, value);
+        } else if (flag == "--status-interval") {
+            config.statusInterval = parseSeconds(flag, value);
+        } else if (flag == "--client-timeout") {
+            config.clientTimeout = parseSeconds(flag, value);
+        } else if (flag == "--placement") {
+            config.placement = parsePlacementStrategy(value);
+        } else if (flag == "--lifecycle") {
+            config.lifecycle = parseLifecycleMode(value);
+        } else if (flag == "--idle-intervals") {
+            config.completion.idleIntervals = static_cast<uint32_t>(parseNumber(flag, value, 1));
+        } else if (flag == "--idle-interval-ms") {
+            config.completion.idleInterval = parseMilliseconds(flag, value);
+        } else if (flag == "--max-poll-ms") {
+            config.completion.maxPollInterval = parseMilliseconds(flag, value);
+        } else if (flag == "--parallel") {
+            config.parallelism = static_cast<uint32_t>(parseNumber(flag, value, 1));
+        } else if (flag == "--copies") {
+            config.copies = static_cast<uint32_t>(parseNumber(flag, value, 1));
+        } else if (flag == "--sink") {
+            config.sinkPath = value;
+        } else if (flag == "--output-dir") {
+            config.outputDirectory = value;
+        } else {
+            throw std::invalid_argument("Unknown option: " + flag);
+        }
+    }
+    return config;
+}
+
+std::string RunConfig::usage(const std::string& program) {
+    return "Usage: " + program
+        + " [--coordinator host[:port]] [--duration seconds] [--status-interval seconds]"
+          " [--placement TopDown|BottomUp] [--sink path] [--output-dir dir] [--client-timeout seconds]"
+          " [--list-sources] [--lifecycle fixed|completion] [--idle-intervals n] [--idle-interval-ms ms]"
+          " [--max-poll-ms ms] [--parallel n] [--copies n]";
+}
+
+CompletionSettings RunConfig::completionSettings() const {
+    CompletionSettings settings = completion;
+    settings.timeout = duration;
+    settings.initialPollInterval = std::min(settings.initialPollInterval, settings.maxPollInterval);
+    return settings;
+}
+
+}// namespace SNCB::Driver
@@ -0,0 +1,81 @@
+#include <Driver/WorkerPool.hpp>
+
+#include <exception>
+#include <stdexcept>
+
+namespace SNCB::Driver {
+
+WorkerPool::WorkerPool(size_t numberOfWorkers) {
+    if (numberOfWorkers == 0) {
+        throw std::invalid_argument("WorkerPool needs at least one worker");
+    }
+    for (size_t worker = 0; worker < numberOfWorkers; ++worker) {
+        workers.emplace_back([this, worker] { workerLoop(worker); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t WorkerPool::size() const { return workers.size(); }
+
+void WorkerPool::parallelFor(size_t count, const std::function<void(size_t index, size_t worker)>& task) {
+    std::mutex doneMutex;
+    std::condition_variable allDone;
+    size_t remaining = count;
+    std::exception_ptr firstError;
+
+    {
+        std::lock_guard lock(mutex);
+        for (size_t index = 0; index < count; ++index) {
+            tasks.emplace_back([&, index](size_t worker) {
+                std::exception_ptr error;
+                try {
+                    task(index, worker);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                std::lock_guard doneLock(doneMutex);
+                if (error && !firstError) {
+                    firstError = error;
+                }
+                if (--remaining == 0) {
+                    allDone.notify_one();
+                }
+            });
+        }
+    }
+    taskAvailable.notify_all();
+
+    std::unique_lock doneLock(doneMutex);
+    allDone.wait(doneLock, [&] { return remaining == 0; });
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+void WorkerPool::workerLoop(size_t worker) {
+    while (true) {
+        std::function<void(size_t)> task;
+        {
+            std::unique_lock lock(mutex);
+            taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task(worker);
+    }
+}
+
+}// namespace SNCB::Driver
@@ -0,0 +1,69 @@
+#include <Engine/Aggregation.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace SNCB::Engine {
+
+AggregationFunction::AggregationFunction(const WindowAggregation& aggregation, const Schema& inputSchema, const GeoContext* geo)
+    : kind(aggregation.getKind()) {
+    DataType inputType = DataType::UINT64;
+    if (aggregation.getOnField()) {
+        input.emplace(aggregation.getOnField(), inputSchema, geo);
+        inputType = input->getResultType();
+    }
+    switch (kind) {
+        case AggregationKind::Avg: resultField = {aggregation.getAsField(), DataType::FLOAT64}; break;
+        case AggregationKind::Count: resultField = {aggregation.getAsField(), DataType::UINT64}; break;
+        default:
+            resultField = {aggregation.getAsField(), inputType == DataType::BOOLEAN ? DataType::UINT64 : inputType};
+    }
+}
+
+AggregateValue AggregationFunction::initial() const {
+    switch (kind) {
+        case AggregationKind::Min: return {std::numeric_limits<double>::infinity(), 0};
+        case AggregationKind::Max: return {-std::numeric_limits<double>::infinity(), 0};
+        default: return {0.0, 0};
+    }
+}
+
+void AggregationFunction::lift(AggregateValue& state, const TupleBuffer& buffer, size_t row) const {
+    ++state.count;
+    if (!input) {
+        return;
+    }
+    double value = input->evaluate(buffer, row);
+    switch (kind) {
+        case AggregationKind::Min: state.value = std::min(state.value, value); break;
+        case AggregationKind::Max: state.value = std::max(state.value, value); break;
+        case AggregationKind::Sum:
+        case AggregationKind::Avg: state.value += value; break;
+        case AggregationKind::Count: break;
+    }
+}
+
+void AggregationFunction::combine(AggregateValue& state, const AggregateValue& other) const {
+    state.count += other.count;
+    switch (kind) {
+        case AggregationKind::Min: state.value = std::min(state.value, other.value); break;
+        case AggregationKind::Max: state.value = std::max(state.value, other.value); break;
+        case AggregationKind::Sum:
+        case AggregationKind::Avg: state.value += other.value; break;
+        case AggregationKind::Count: break;
+    }
+}
+
+double AggregationFunction::lower(const AggregateValue& state) const {
+    switch (kind) {
+        case AggregationKind::Avg: return state.count == 0 ? 0.0 : state.value / static_cast<double>(state.count);
+        case AggregationKind::Count: return static_cast<double>(state.count);
+        default: return state.value;
+    }
+}
+
+AggregationKind AggregationFunction::getKind() const { return kind; }
+
+const Field& AggregationFunction::getResultField() const { return resultField; }
+
+}// namespace SNCB::Engine
@@ -0,0 +1,185 @@
+#include <Engine/BinarySinkFormat.hpp>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace SNCB::Engine {
+
+namespace {
+constexpr char magic[8] = {'S', 'N', 'C', 'B', 'S', 'N', 'K', '1'};
+constexpr uint8_t rawEncoding = 0;
+constexpr uint8_t deltaEncoding = 1;
+
+template<typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+void patch(std::string& out, size_t offset, T value) {
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+/** @brief Bounds-checked reads from a block. */
+class Cursor {
+  public:
+    Cursor(const char* begin, const char* end, const std::string& path) : position(begin), end(end), path(path) {}
+
+    template<typename T>
+    T get() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+    const char* take(size_t length) {
+        if (length > static_cast<size_t>(end - position)) {
+            throw std::runtime_error("Sink file " + path + " has a malformed block");
+        }
+        const char* begin = position;
+        position += length;
+        return begin;
+    }
+    uint64_t getVarint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            auto byte = static_cast<uint8_t>(*take(1));
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Sink file " + path + " has a malformed varint");
+    }
+    bool atEnd() const { return position == end; }
+
+  private:
+    const char* position;
+    const char* end;
+    const std::string& path;
+};
+}// namespace
+
+void BinarySinkFormat::encodeHeader(const Schema& schema, std::string& out) {
+    out.append(magic, sizeof(magic));
+    put<uint32_t>(out, static_cast<uint32_t>(schema.size()));
+    for (const auto& field : schema.getFields()) {
+        put<uint8_t>(out, toTypeCode(field.type));
+        put<uint8_t>(out, 0);
+        put<uint16_t>(out, static_cast<uint16_t>(field.name.size()));
+        out += field.name;
+    }
+}
+
+void BinarySinkFormat::encodeBlock(const TupleBuffer& buffer, std::string& out) {
+    const auto& schema = *buffer.getSchema();
+    auto rows = buffer.getNumberOfTuples();
+    auto blockStart = out.size();
+    put<uint32_t>(out, 0);
+    put<uint32_t>(out, static_cast<uint32_t>(rows));
+    for (size_t field = 0; field < schema.size(); ++field) {
+        const uint64_t* column = buffer.getColumn(field);
+        bool delta = schema.getField(field).type != DataType::FLOAT64;
+        put<uint8_t>(out, delta ? deltaEncoding : rawEncoding);
+        auto columnStart = out.size();
+        put<uint32_t>(out, 0);
+        if (delta) {
+            uint64_t previous = 0;
+            for (size_t row = 0; row < rows; ++row) {
+                auto difference = static_cast<int64_t>(column[row] - previous);
+                putVarint(out, (static_cast<uint64_t>(difference) << 1) ^ static_cast<uint64_t>(difference >> 63));
+                previous = column[row];
+            }
+        } else {
+            out.append(reinterpret_cast<const char*>(column), rows * sizeof(uint64_t));
+        }
+        patch<uint32_t>(out, columnStart, static_cast<uint32_t>(out.size() - columnStart - sizeof(uint32_t)));
+    }
+    patch<uint32_t>(out, blockStart, static_cast<uint32_t>(out.size() - blockStart - sizeof(uint32_t)));
+}
+
+BinarySinkReader::BinarySinkReader(const std::string& path) : path(path), file(path, std::ios::binary) {
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open sink file " + path);
+    }
+    char header[sizeof(magic) + sizeof(uint32_t)];
+    if (!file.read(header, sizeof(header)) || std::memcmp(header, magic, sizeof(magic)) != 0) {
+        throw std::runtime_error(path + " is no BINARY_FORMAT sink file");
+    }
+    uint32_t fieldCount;
+    std::memcpy(&fieldCount, header + sizeof(magic), sizeof(fieldCount));
+    Schema fields;
+    for (uint32_t field = 0; field < fieldCount; ++field) {
+        char description[4];
+        if (!file.read(description, sizeof(description))) {
+            throw std::runtime_error("Sink file " + path + " has a truncated header");
+        }
+        auto type = fromTypeCode(static_cast<uint8_t>(description[0]));
+        uint16_t nameLength;
+        std::memcpy(&nameLength, description + 2, sizeof(nameLength));
+        std::string name(nameLength, '\0');
+        if (!type || !file.read(name.data(), nameLength)) {
+            throw std::runtime_error("Sink file " + path + " has a malformed header");
+        }
+        fields.addField(name, *type);
+    }
+    schema = std::make_shared<const Schema>(std::move(fields));
+}
+
+const SchemaPtr& BinarySinkReader::getSchema() const { return schema; }
+
+bool BinarySinkReader::readBlock(TupleBuffer& buffer) {
+    uint32_t size;
+    if (!file.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+        if (file.gcount() != 0) {
+            throw std::runtime_error("Sink file " + path + " ends within a block");
+        }
+        return false;
+    }
+    block.resize(size);
+    if (!file.read(block.data(), size)) {
+        throw std::runtime_error("Sink file " + path + " ends within a block");
+    }
+
+    Cursor cursor(block.data(), block.data() + block.size(), path);
+    auto rows = cursor.get<uint32_t>();
+    if (buffer.getCapacity() < rows || buffer.getSchema() != schema) {
+        buffer = TupleBuffer(schema, rows);
+    }
+    for (size_t field = 0; field < schema->size(); ++field) {
+        auto encoding = cursor.get<uint8_t>();
+        auto bytes = cursor.get<uint32_t>();
+        const char* begin = cursor.take(bytes);
+        Cursor column(begin, begin + bytes, path);
+        uint64_t* target = buffer.getColumn(field);
+        if (encoding == rawEncoding) {
+            std::memcpy(target, column.take(rows * sizeof(uint64_t)), rows * sizeof(uint64_t));
+        } else if (encoding == deltaEncoding) {
+            uint64_t previous = 0;
+            for (size_t row = 0; row < rows; ++row) {
+                auto zigzag = column.getVarint();
+                previous += (zigzag >> 1) ^ (0 - (zigzag & 1));
+                target[row] = previous;
+            }
+        } else {
+            throw std::runtime_error("Sink file " + path + " has an unknown column encoding");
+        }
+        if (!column.atEnd()) {
+            throw std::runtime_error("Sink file " + path + " has a malformed column");
+        }
+    }
+    if (!cursor.atEnd()) {
+        throw std::runtime_error("Sink file " + path + " has a malformed block");
+    }
+    buffer.setNumberOfTuples(rows);
+    return true;
+}
+
+}// namespace SNCB::Engine
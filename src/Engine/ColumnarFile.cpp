@@ -0,0 +1,227 @@
+#include <Engine/ColumnarFile.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SNCB::Engine {
+
+namespace {
+constexpr char magic[8] = {'S', 'N', 'C', 'B', 'C', 'O', 'L', '1'};
+constexpr uint32_t noTimeField = std::numeric_limits<uint32_t>::max();
+// magic, fields, time field, rows, chunks, directory offset
+constexpr size_t headerSize = 8 + 4 + 4 + 8 + 8 + 8;
+constexpr size_t chunkAlignment = 64;
+
+template<typename T>
+void put(std::ofstream& file, T value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/** @brief Bounds-checked reads from the mapping. */
+class Reader {
+  public:
+    Reader(const char* data, size_t size, const std::string& path) : data(data), size(size), path(path) {}
+
+    template<typename T>
+    T get() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+    std::string getString(size_t length) { return {take(length), length}; }
+    void seek(uint64_t offset) {
+        if (offset > size) {
+            throw std::runtime_error("Columnar file " + path + " is truncated");
+        }
+        position = offset;
+    }
+
+  private:
+    const char* take(size_t length) {
+        if (length > size - position) {
+            throw std::runtime_error("Columnar file " + path + " is truncated");
+        }
+        const char* begin = data + position;
+        position += length;
+        return begin;
+    }
+
+    const char* data;
+    size_t size;
+    const std::string& path;
+    size_t position = 0;
+};
+}// namespace
+
+ColumnarFileWriter::ColumnarFileWriter(const std::string& path, SchemaPtr schema, size_t rowsPerChunk,
+                                       const std::string& timeField)
+    : path(path), schema(schema), timeField(schema->findIndex(timeField)), pending(schema, rowsPerChunk) {
+    if (rowsPerChunk == 0) {
+        throw std::invalid_argument("Columnar chunks need at least one row");
+    }
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot create columnar file " + path);
+    }
+    // Counts and magic are written by finish
+    file.write(std::string(headerSize, '\0').data(), headerSize);
+    for (const auto& field : schema->getFields()) {
+        put<uint8_t>(file, toTypeCode(field.type));
+        put<uint8_t>(file, 0);
+        put<uint16_t>(file, static_cast<uint16_t>(field.name.size()));
+        file.write(field.name.data(), static_cast<std::streamsize>(field.name.size()));
+    }
+}
+
+void ColumnarFileWriter::write(const TupleBuffer& buffer) {
+    size_t done = 0;
+    while (done < buffer.getNumberOfTuples()) {
+        done += pending.appendRange(buffer, done, buffer.getNumberOfTuples() - done);
+        if (pending.isFull()) {
+            writeChunk();
+        }
+    }
+}
+
+void ColumnarFileWriter::writeChunk() {
+    ColumnarChunk chunk{};
+    auto end = static_cast<uint64_t>(file.tellp());
+    chunk.offset = (end + chunkAlignment - 1) / chunkAlignment * chunkAlignment;
+    file.write(std::string(chunk.offset - end, '\0').data(), static_cast<std::streamsize>(chunk.offset - end));
+    chunk.rows = pending.getNumberOfTuples();
+    for (size_t field = 0; field < schema->size(); ++field) {
+        file.write(reinterpret_cast<const char*>(pending.getColumn(field)),
+                   static_cast<std::streamsize>(chunk.rows * sizeof(uint64_t)));
+    }
+    if (timeField) {
+        const uint64_t* time = pending.getColumn(*timeField);
+        auto [min, max] = std::minmax_element(time, time + chunk.rows);
+        chunk.minTimestamp = *min;
+        chunk.maxTimestamp = *max;
+    }
+    chunks.push_back(chunk);
+    rows += chunk.rows;
+    pending.clear();
+}
+
+void ColumnarFileWriter::finish() {
+    if (!pending.isEmpty()) {
+        writeChunk();
+    }
+    auto directory = static_cast<uint64_t>(file.tellp());
+    for (const auto& chunk : chunks) {
+        put(file, chunk.offset);
+        put(file, chunk.rows);
+        put(file, chunk.minTimestamp);
+        put(file, chunk.maxTimestamp);
+    }
+    file.seekp(0);
+    file.write(magic, sizeof(magic));
+    put<uint32_t>(file, static_cast<uint32_t>(schema->size()));
+    put<uint32_t>(file, timeField ? static_cast<uint32_t>(*timeField) : noTimeField);
+    put<uint64_t>(file, rows);
+    put<uint64_t>(file, chunks.size());
+    put<uint64_t>(file, directory);
+    file.close();
+    if (file.fail()) {
+        throw std::runtime_error("Cannot write columnar file " + path);
+    }
+}
+
+uint64_t ColumnarFileWriter::getNumberOfRows() const { return rows; }
+
+const std::vector<ColumnarChunk>& ColumnarFileWriter::getChunks() const { return chunks; }
+
+ColumnarFile::ColumnarFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open columnar file " + path);
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < headerSize) {
+        ::close(fd);
+        throw std::runtime_error("Columnar file " + path + " is truncated");
+    }
+    size = static_cast<size_t>(status.st_size);
+    // Private and writable: in-place writes of operators copy the page instead of failing
+    void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Cannot map columnar file " + path);
+    }
+    mapping = static_cast<char*>(address);
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+    try {
+        Reader reader(mapping, size, path);
+        if (reader.getString(sizeof(magic)) != std::string(magic, sizeof(magic))) {
+            throw std::runtime_error(path + " is no complete columnar file");
+        }
+        auto fieldCount = reader.get<uint32_t>();
+        auto time = reader.get<uint32_t>();
+        rows = reader.get<uint64_t>();
+        auto chunkCount = reader.get<uint64_t>();
+        auto directory = reader.get<uint64_t>();
+
+        Schema fields;
+        for (uint32_t field = 0; field < fieldCount; ++field) {
+            auto type = fromTypeCode(reader.get<uint8_t>());
+            reader.get<uint8_t>();
+            auto nameLength = reader.get<uint16_t>();
+            if (!type) {
+                throw std::runtime_error("Columnar file " + path + " has an unknown field type");
+            }
+            fields.addField(reader.getString(nameLength), *type);
+        }
+        schema = std::make_shared<const Schema>(std::move(fields));
+        if (time != noTimeField) {
+            timeField = time;
+        }
+
+        reader.seek(directory);
+        uint64_t total = 0;
+        for (uint64_t index = 0; index < chunkCount; ++index) {
+            ColumnarChunk chunk{};
+            chunk.offset = reader.get<uint64_t>();
+            chunk.rows = reader.get<uint64_t>();
+            chunk.minTimestamp = reader.get<uint64_t>();
+            chunk.maxTimestamp = reader.get<uint64_t>();
+            if (chunk.offset % chunkAlignment != 0 || chunk.offset > size
+                || chunk.rows > (size - chunk.offset) / sizeof(uint64_t) / std::max<size_t>(fieldCount, 1)) {
+                throw std::runtime_error("Columnar file " + path + " has a chunk outside the file");
+            }
+            chunks.push_back(chunk);
+            total += chunk.rows;
+        }
+        if (total != rows) {
+            throw std::runtime_error("Columnar file " + path + " has inconsistent row counts");
+        }
+    } catch (...) {
+        ::munmap(mapping, size);
+        throw;
+    }
+}
+
+ColumnarFile::~ColumnarFile() { ::munmap(mapping, size); }
+
+const SchemaPtr& ColumnarFile::getSchema() const { return schema; }
+
+std::optional<size_t> ColumnarFile::getTimeField() const { return timeField; }
+
+uint64_t ColumnarFile::getNumberOfRows() const { return rows; }
+
+const std::vector<ColumnarChunk>& ColumnarFile::getChunks() const { return chunks; }
+
+uint64_t* ColumnarFile::getColumn(size_t chunk, size_t field) const {
+    const auto& info = chunks[chunk];
+    return reinterpret_cast<uint64_t*>(mapping + info.offset) + field * info.rows;
+}
+
+}// namespace SNCB::Engine
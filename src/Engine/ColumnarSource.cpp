@@ -0,0 +1,48 @@
+#include <Engine/ColumnarSource.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace SNCB::Engine {
+
+ColumnarSource::ColumnarSource(const std::string& path, SchemaPtr readSchema, size_t tuplesPerBuffer)
+    : file(path), schema(std::move(readSchema)), tuplesPerBuffer(tuplesPerBuffer) {
+    const auto& fileSchema = *file.getSchema();
+    for (const auto& field : schema->getFields()) {
+        auto index = fileSchema.findIndex(field.name);
+        if (!index) {
+            throw std::invalid_argument("Columnar file " + path + " has no field " + field.name);
+        }
+        if (fileSchema.getField(*index).type != field.type) {
+            throw std::invalid_argument("Columnar file " + path + " stores " + field.name + " as "
+                                        + toString(fileSchema.getField(*index).type));
+        }
+        fileFields.push_back(*index);
+    }
+}
+
+bool ColumnarSource::fillBuffer(TupleBuffer& buffer) {
+    const auto& chunks = file.getChunks();
+    while (chunk < chunks.size() && row == chunks[chunk].rows) {
+        ++chunk;
+        row = 0;
+    }
+    if (chunk == chunks.size()) {
+        buffer.clear();
+        return false;
+    }
+    auto count = static_cast<size_t>(std::min<uint64_t>(tuplesPerBuffer, chunks[chunk].rows - row));
+    std::vector<uint64_t*> columns;
+    columns.reserve(fileFields.size());
+    for (auto field : fileFields) {
+        columns.push_back(file.getColumn(chunk, field) + row);
+    }
+    buffer = TupleBuffer(schema, std::move(columns), count);
+    row += count;
+    producedTuples += count;
+    return true;
+}
+
+uint64_t ColumnarSource::getProducedTuples() const { return producedTuples; }
+
+}// namespace SNCB::Engine
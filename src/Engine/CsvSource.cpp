@@ -0,0 +1,124 @@
+#include <Engine/CsvSource.hpp>
+
+#include <Util/ByteScan.hpp>
+#include <Util/NumberParsing.hpp>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace SNCB::Engine {
+
+namespace {
+// Bytes read per chunk; a chunk grows for lines longer than this
+constexpr size_t chunkBytes = 1 << 18;
+}// namespace
+
+CsvSource::CsvSource(const PhysicalSourceConfig& config, SchemaPtr schema) : CsvSource(config, schema, schema) {}
+
+CsvSource::CsvSource(const PhysicalSourceConfig& config, const SchemaPtr& fileSchema, SchemaPtr readSchema)
+    : schema(std::move(readSchema)), delimiter(config.delimiter), skipLine(config.skipHeader), chunk(chunkBytes) {
+    size_t columnCount = 0;
+    for (size_t column = 0; column < fileSchema->size(); ++column) {
+        const auto& field = fileSchema->getField(column);
+        auto target = schema->findIndex(field.name);
+        columns.push_back({target, field.type});
+        if (target) {
+            columnCount = column + 1;
+        }
+    }
+    columns.resize(columnCount);
+    for (const auto& field : schema->getFields()) {
+        if (!fileSchema->contains(field.name)) {
+            throw std::invalid_argument("Source " + config.logicalSourceName + " has no field " + field.name);
+        }
+    }
+
+    file.open(config.filePath, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open CSV source " + config.filePath + " of " + config.logicalSourceName);
+    }
+}
+
+bool CsvSource::readChunk() {
+    // The partial line of the previous chunk moves to the front
+    std::memmove(chunk.data(), chunk.data() + chunkSize, tailSize);
+    size_t filled = tailSize;
+    chunkSize = 0;
+    while (chunkSize == 0) {
+        // One byte stays free for a newline after a last line without one
+        if (filled + 1 >= chunk.size()) {
+            chunk.resize(chunk.size() * 2);
+        }
+        file.read(chunk.data() + filled, static_cast<std::streamsize>(chunk.size() - 1 - filled));
+        auto read = static_cast<size_t>(file.gcount());
+        filled += read;
+        if (read == 0) {
+            if (filled == 0) {
+                tailSize = 0;
+                return false;
+            }
+            chunk[filled++] = '\n';
+        }
+        auto* lastNewline = static_cast<const char*>(memrchr(chunk.data(), '\n', filled));
+        if (lastNewline != nullptr) {
+            chunkSize = static_cast<size_t>(lastNewline - chunk.data()) + 1;
+        }
+    }
+    tailSize = filled - chunkSize;
+
+    structurals.resize(chunkSize);
+    structuralCount = Util::indexStructurals(chunk.data(), chunkSize, delimiter, structurals.data());
+    nextStructural = 0;
+    lineStart = 0;
+    return true;
+}
+
+bool CsvSource::fillBuffer(TupleBuffer& buffer) {
+    buffer.clear();
+    while (!buffer.isFull()) {
+        if (nextStructural == structuralCount && !readChunk()) {
+            break;
+        }
+        parseLine(buffer);
+    }
+    producedTuples += buffer.getNumberOfTuples();
+    return !buffer.isEmpty();
+}
+
+void CsvSource::parseLine(TupleBuffer& buffer) {
+    const char* data = chunk.data();
+    size_t firstEnd = structurals[nextStructural];
+    bool blank = data[firstEnd] == '\n' && (firstEnd == lineStart || (firstEnd == lineStart + 1 && data[lineStart] == '\r'));
+    if (skipLine || blank) {
+        skipLine = false;
+        while (data[structurals[nextStructural++]] != '\n') {
+        }
+        lineStart = structurals[nextStructural - 1] + 1;
+        return;
+    }
+
+    auto row = buffer.append();
+    size_t fieldStart = lineStart;
+    for (size_t column = 0;; ++column) {
+        size_t fieldEnd = structurals[nextStructural++];
+        bool lastField = data[fieldEnd] == '\n';
+        if (column < columns.size() && columns[column].field) {
+            size_t end = lastField && fieldEnd > fieldStart && data[fieldEnd - 1] == '\r' ? fieldEnd - 1 : fieldEnd;
+            auto field = *columns[column].field;
+            if (columns[column].type == DataType::FLOAT64) {
+                buffer.setDouble(row, field, Util::parseDouble(data + fieldStart, data + end));
+            } else {
+                buffer.setUInt(row, field, Util::parseUInt64(data + fieldStart, data + end));
+            }
+        }
+        fieldStart = fieldEnd + 1;
+        if (lastField) {
+            break;
+        }
+    }
+    lineStart = fieldStart;
+}
+
+uint64_t CsvSource::getProducedTuples() const { return producedTuples; }
+
+}// namespace SNCB::Engine
@@ -0,0 +1,322 @@
+#include <Engine/Expressions.hpp>
+#include <Engine/VectorKernels.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace SNCB::Engine {
+
+namespace {
+
+ExpressionNodePtr makeNode(ExpressionKind kind, std::vector<ExpressionNodePtr> children) {
+    auto node = std::make_shared<ExpressionNode>();
+    node->kind = kind;
+    node->children = std::move(children);
+    return node;
+}
+
+ExpressionNodePtr makeConstant(double value, DataType type) {
+    auto node = std::make_shared<ExpressionNode>();
+    node->kind = ExpressionKind::Constant;
+    node->constant = value;
+    node->constantType = type;
+    return node;
+}
+
+ExpressionItem binary(ExpressionKind kind, const ExpressionItem& left, const ExpressionItem& right) {
+    return makeNode(kind, {left.getNode(), right.getNode()});
+}
+
+const char* symbol(ExpressionKind kind) {
+    switch (kind) {
+        case ExpressionKind::Add: return "+";
+        case ExpressionKind::Sub: return "-";
+        case ExpressionKind::Mul: return "*";
+        case ExpressionKind::Div: return "/";
+        case ExpressionKind::Less: return "<";
+        case ExpressionKind::LessEquals: return "<=";
+        case ExpressionKind::Greater: return ">";
+        case ExpressionKind::GreaterEquals: return ">=";
+        case ExpressionKind::Equals: return "==";
+        case ExpressionKind::NotEquals: return "!=";
+        case ExpressionKind::And: return "&&";
+        case ExpressionKind::Or: return "||";
+        case ExpressionKind::Not: return "!";
+        case ExpressionKind::TEIntersects: return "teintersects";
+        case ExpressionKind::TPointAtSTBox: return "tpointatstbox";
+        case ExpressionKind::TEDWithin: return "tedwithin";
+        default: return "?";
+    }
+}
+
+bool isArithmetic(ExpressionKind kind) {
+    return kind == ExpressionKind::Add || kind == ExpressionKind::Sub || kind == ExpressionKind::Mul
+        || kind == ExpressionKind::Div;
+}
+
+// Type of an operator on its operands: arithmetic is UINT64 unless an operand is FLOAT64 or it divides
+DataType operatorType(ExpressionKind kind, bool floatingOperand) {
+    if (isArithmetic(kind)) {
+        return floatingOperand || kind == ExpressionKind::Div ? DataType::FLOAT64 : DataType::UINT64;
+    }
+    return DataType::BOOLEAN;
+}
+
+}// namespace
+
+void ExpressionNode::collectFields(std::vector<std::string>& fields) const {
+    if (kind == ExpressionKind::Field) {
+        if (std::find(fields.begin(), fields.end(), fieldName) == fields.end()) {
+            fields.push_back(fieldName);
+        }
+        return;
+    }
+    for (const auto& child : children) {
+        child->collectFields(fields);
+    }
+}
+
+std::string ExpressionNode::toString() const {
+    switch (kind) {
+        case ExpressionKind::Field: return fieldName;
+        case ExpressionKind::Constant: return std::to_string(constant);
+        case ExpressionKind::Not: return "!(" + children[0]->toString() + ")";
+        case ExpressionKind::TEIntersects:
+        case ExpressionKind::TPointAtSTBox:
+        case ExpressionKind::TEDWithin: {
+            std::string arguments;
+            for (const auto& child : children) {
+                arguments += (arguments.empty() ? "" : ",") + child->toString();
+            }
+            return std::string(symbol(kind)) + "(" + arguments + ")";
+        }
+        default: return "(" + children[0]->toString() + " " + symbol(kind) + " " + children[1]->toString() + ")";
+    }
+}
+
+ExpressionItem::ExpressionItem(ExpressionNodePtr node) : node(std::move(node)) {}
+ExpressionItem::ExpressionItem(int value) : node(makeConstant(value, DataType::UINT64)) {}
+ExpressionItem::ExpressionItem(int64_t value) : node(makeConstant(static_cast<double>(value), DataType::UINT64)) {}
+ExpressionItem::ExpressionItem(uint64_t value) : node(makeConstant(static_cast<double>(value), DataType::UINT64)) {}
+ExpressionItem::ExpressionItem(double value) : node(makeConstant(value, DataType::FLOAT64)) {}
+
+FieldAssignment ExpressionItem::operator=(const ExpressionItem& value) const {
+    if (node->kind != ExpressionKind::Field) {
+        throw std::invalid_argument("Only an Attribute can be assigned, not " + node->toString());
+    }
+    return FieldAssignment(node->fieldName, value.getNode());
+}
+
+const ExpressionNodePtr& ExpressionItem::getNode() const { return node; }
+
+FieldAssignment::FieldAssignment(std::string field, ExpressionNodePtr value) : field(std::move(field)), value(std::move(value)) {}
+
+const std::string& FieldAssignment::getField() const { return field; }
+
+const ExpressionNodePtr& FieldAssignment::getValue() const { return value; }
+
+ExpressionItem Attribute(const std::string& name) {
+    auto node = std::make_shared<ExpressionNode>();
+    node->kind = ExpressionKind::Field;
+    node->fieldName = name;
+    return ExpressionItem(ExpressionNodePtr(node));
+}
+
+ExpressionItem Attribute(const std::string& name, DataType type) {
+    auto node = std::make_shared<ExpressionNode>();
+    node->kind = ExpressionKind::Field;
+    node->fieldName = name;
+    node->declaredType = type;
+    return ExpressionItem(ExpressionNodePtr(node));
+}
+
+ExpressionItem operator+(const ExpressionItem& left, const ExpressionItem& right) { return binary(ExpressionKind::Add, left, right); }
+ExpressionItem operator-(const ExpressionItem& left, const ExpressionItem& right) { return binary(ExpressionKind::Sub, left, right); }
+ExpressionItem operator*(const ExpressionItem& left, const ExpressionItem& right) { return binary(ExpressionKind::Mul, left, right); }
+ExpressionItem operator/(const ExpressionItem& left, const ExpressionItem& right) { return binary(ExpressionKind::Div, left, right); }
+ExpressionItem operator<(const ExpressionItem& left, const ExpressionItem& right) { return binary(ExpressionKind::Less, left, right); }
+ExpressionItem operator<=(const ExpressionItem& left, const ExpressionItem& right) {
+    return binary(ExpressionKind::LessEquals, left, right);
+}
+ExpressionItem operator>(const ExpressionItem& left, const ExpressionItem& right) { return binary(ExpressionKind::Greater, left, right); }
+ExpressionItem operator>=(const ExpressionItem& left, const ExpressionItem& right) {
+    return binary(ExpressionKind::GreaterEquals, left, right);
+}
+ExpressionItem operator==(const ExpressionItem& left, const ExpressionItem& right) { return binary(ExpressionKind::Equals, left, right); }
+ExpressionItem operator!=(const ExpressionItem& left, const ExpressionItem& right) {
+    return binary(ExpressionKind::NotEquals, left, right);
+}
+ExpressionItem operator&&(const ExpressionItem& left, const ExpressionItem& right) { return binary(ExpressionKind::And, left, right); }
+ExpressionItem operator||(const ExpressionItem& left, const ExpressionItem& right) { return binary(ExpressionKind::Or, left, right); }
+ExpressionItem operator!(const ExpressionItem& value) { return makeNode(ExpressionKind::Not, {value.getNode()}); }
+
+ExpressionItem teintersects(const ExpressionItem& longitude, const ExpressionItem& latitude, const ExpressionItem& timestamp) {
+    return makeNode(ExpressionKind::TEIntersects, {longitude.getNode(), latitude.getNode(), timestamp.getNode()});
+}
+
+ExpressionItem tpointatstbox(const ExpressionItem& longitude, const ExpressionItem& latitude, const ExpressionItem& timestamp) {
+    return makeNode(ExpressionKind::TPointAtSTBox, {longitude.getNode(), latitude.getNode(), timestamp.getNode()});
+}
+
+ExpressionItem tedwithin(const ExpressionItem& longitude, const ExpressionItem& latitude, const ExpressionItem& timestamp) {
+    return makeNode(ExpressionKind::TEDWithin, {longitude.getNode(), latitude.getNode(), timestamp.getNode()});
+}
+
+ExpressionItem tedwithin(const ExpressionItem& longitude, const ExpressionItem& latitude, const ExpressionItem& timestamp,
+                         double slackMeters) {
+    return makeNode(ExpressionKind::TEDWithin,
+                    {longitude.getNode(), latitude.getNode(), timestamp.getNode(), ExpressionItem(slackMeters).getNode()});
+}
+
+CompiledExpression::CompiledExpression(const ExpressionNodePtr& root, const Schema& schema, const GeoContext* geo) : geo(geo) {
+    compile(root, schema);
+    scratch.resize(nodes.size() * BatchSize);
+    bitmap.resize(BatchSize / 64);
+    for (size_t index = 0; index < nodes.size(); ++index) {
+        if (nodes[index].kind == ExpressionKind::Constant) {
+            Kernels::fill(nodes[index].constant, scratch.data() + index * BatchSize, BatchSize);
+        }
+    }
+}
+
+size_t CompiledExpression::compile(const ExpressionNodePtr& node, const Schema& schema) {
+    // Children are compiled after their parent was reserved, so the root stays at index 0
+    auto index = nodes.size();
+    nodes.emplace_back();
+    nodes.back().kind = node->kind;
+    std::vector<size_t> children;
+    for (const auto& child : node->children) {
+        children.push_back(compile(child, schema));
+    }
+
+    auto& compiled = nodes[index];
+    compiled.children = std::move(children);
+    switch (node->kind) {
+        case ExpressionKind::Field:
+            compiled.field = schema.getIndex(node->fieldName);
+            compiled.type = schema.getField(compiled.field).type;
+            break;
+        case ExpressionKind::Constant:
+            compiled.constant = node->constant;
+            compiled.type = node->constantType;
+            break;
+        default:
+            bool floating = std::any_of(compiled.children.begin(), compiled.children.end(), [this](size_t child) {
+                return nodes[child].type == DataType::FLOAT64;
+            });
+            compiled.type = operatorType(node->kind, floating);
+            if ((node->kind == ExpressionKind::TEIntersects || node->kind == ExpressionKind::TPointAtSTBox
+                 || node->kind == ExpressionKind::TEDWithin)
+                && geo == nullptr) {
+                throw std::invalid_argument(std::string(symbol(node->kind)) + " needs a GeoContext");
+            }
+    }
+    return index;
+}
+
+DataType CompiledExpression::getResultType() const { return nodes[0].type; }
+
+std::optional<DataType> CompiledExpression::resultTypeOf(const ExpressionNodePtr& root, const Schema& schema) {
+    switch (root->kind) {
+        case ExpressionKind::Field: {
+            auto field = schema.findIndex(root->fieldName);
+            return field ? std::optional(schema.getField(*field).type) : std::nullopt;
+        }
+        case ExpressionKind::Constant: return root->constantType;
+        default: {
+            bool floating = false;
+            for (const auto& child : root->children) {
+                auto type = resultTypeOf(child, schema);
+                if (!type) {
+                    return std::nullopt;
+                }
+                floating |= *type == DataType::FLOAT64;
+            }
+            return operatorType(root->kind, floating);
+        }
+    }
+}
+
+double CompiledExpression::evaluate(size_t index, const TupleBuffer& buffer, size_t row) const {
+    const auto& node = nodes[index];
+    auto child = [&](size_t i) { return evaluate(node.children[i], buffer, row); };
+    switch (node.kind) {
+        case ExpressionKind::Field: return buffer.getAsDouble(row, node.field);
+        case ExpressionKind::Constant: return node.constant;
+        case ExpressionKind::Add: return child(0) + child(1);
+        case ExpressionKind::Sub: return child(0) - child(1);
+        case ExpressionKind::Mul: return child(0) * child(1);
+        case ExpressionKind::Div: return child(0) / child(1);
+        case ExpressionKind::Less: return child(0) < child(1);
+        case ExpressionKind::LessEquals: return child(0) <= child(1);
+        case ExpressionKind::Greater: return child(0) > child(1);
+        case ExpressionKind::GreaterEquals: return child(0) >= child(1);
+        case ExpressionKind::Equals: return child(0) == child(1);
+        case ExpressionKind::NotEquals: return child(0) != child(1);
+        case ExpressionKind::And: return child(0) != 0.0 && child(1) != 0.0;
+        case ExpressionKind::Or: return child(0) != 0.0 || child(1) != 0.0;
+        case ExpressionKind::Not: return child(0) == 0.0;
+        case ExpressionKind::TEIntersects: return geo->intersectsArea(child(0), child(1), static_cast<uint64_t>(child(2)));
+        case ExpressionKind::TPointAtSTBox: return geo->atSTBox(child(0), child(1), static_cast<uint64_t>(child(2)));
+        case ExpressionKind::TEDWithin:
+            return geo->withinDistance(child(0), child(1), static_cast<uint64_t>(child(2)), node.children.size() > 3 ? child(3) : 0.0);
+    }
+    return 0.0;
+}
+
+const double* CompiledExpression::evaluateBatch(const TupleBuffer& buffer, size_t begin, size_t count) {
+    return evaluateBatch(0, buffer, begin, count);
+}
+
+size_t CompiledExpression::selectBatch(const TupleBuffer& buffer, size_t begin, size_t count, uint32_t* selection) {
+    Kernels::toBitmap(evaluateBatch(0, buffer, begin, count), count, bitmap.data());
+    return Kernels::toSelection(bitmap.data(), count, static_cast<uint32_t>(begin), selection);
+}
+
+const double* CompiledExpression::evaluateBatch(size_t index, const TupleBuffer& buffer, size_t begin, size_t count) {
+    const auto& node = nodes[index];
+    double* out = scratch.data() + index * BatchSize;
+    switch (node.kind) {
+        case ExpressionKind::Field:
+            // FLOAT64 columns are used in place, only integer columns need a converted copy
+            if (node.type == DataType::FLOAT64) {
+                return buffer.getDoubleColumn(node.field) + begin;
+            }
+            Kernels::toDouble(buffer.getColumn(node.field) + begin, out, count);
+            return out;
+        case ExpressionKind::Constant: return out;
+        default: break;
+    }
+
+    const double* left = evaluateBatch(node.children[0], buffer, begin, count);
+    const double* right = node.children.size() > 1 ? evaluateBatch(node.children[1], buffer, begin, count) : nullptr;
+    switch (node.kind) {
+        case ExpressionKind::Add: Kernels::add(left, right, out, count); break;
+        case ExpressionKind::Sub: Kernels::sub(left, right, out, count); break;
+        case ExpressionKind::Mul: Kernels::mul(left, right, out, count); break;
+        case ExpressionKind::Div: Kernels::div(left, right, out, count); break;
+        case ExpressionKind::Less: Kernels::compare(Kernels::Comparison::Less, left, right, out, count); break;
+        case ExpressionKind::LessEquals: Kernels::compare(Kernels::Comparison::LessEquals, left, right, out, count); break;
+        case ExpressionKind::Greater: Kernels::compare(Kernels::Comparison::Greater, left, right, out, count); break;
+        case ExpressionKind::GreaterEquals: Kernels::compare(Kernels::Comparison::GreaterEquals, left, right, out, count); break;
+        case ExpressionKind::Equals: Kernels::compare(Kernels::Comparison::Equals, left, right, out, count); break;
+        case ExpressionKind::NotEquals: Kernels::compare(Kernels::Comparison::NotEquals, left, right, out, count); break;
+        case ExpressionKind::And: Kernels::logicalAnd(left, right, out, count); break;
+        case ExpressionKind::Or: Kernels::logicalOr(left, right, out, count); break;
+        case ExpressionKind::Not: Kernels::logicalNot(left, out, count); break;
+        case ExpressionKind::TEIntersects: geo->intersectsArea(left, right, count, out); break;
+        case ExpressionKind::TPointAtSTBox:
+            geo->atSTBox(left, right, evaluateBatch(node.children[2], buffer, begin, count), count, out);
+            break;
+        case ExpressionKind::TEDWithin: {
+            // The slack is a constant, so its scratch column holds it in every row
+            double slackMeters = node.children.size() > 3 ? evaluateBatch(node.children[3], buffer, begin, count)[0] : 0.0;
+            geo->withinDistance(left, right, count, slackMeters, out);
+            break;
+        }
+        default: break;
+    }
+    return out;
+}
+
+}// namespace SNCB::Engine
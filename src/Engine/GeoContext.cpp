@@ -0,0 +1,286 @@
+#include <Engine/GeoContext.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace SNCB::Engine {
+
+namespace {
+constexpr double earthRadiusMeters = 6371008.8;
+constexpr double degreesToRadians = M_PI / 180.0;
+// Cells are never smaller than this, and the grid never has more cells than maxCells
+constexpr double minCellMeters = 100.0;
+constexpr size_t maxCells = size_t{1} << 22;
+constexpr double metersPerLatitude = earthRadiusMeters * degreesToRadians;
+// Relative error the equirectangular distance may have against haversine. It stays below this up to
+// 20 km from areas within 70 degrees of the equator: the longitude scale of the area differs from that
+// of the position by tan(latitude) * latitude difference, 0.9 % there, and curvature adds about 1e-5
+constexpr double equirectangularTolerance = 0.01;
+constexpr double equirectangularMaxMeters = 20000.0;
+constexpr double equirectangularMaxLatitude = 70.0;
+// Positions per pass of the batched lookup
+constexpr size_t lookupBatch = 256;
+
+/** @brief Longitude and latitude extent in degrees of the positions within meters of a point. */
+struct DiscBounds {
+    double minLongitude;
+    double maxLongitude;
+    double minLatitude;
+    double maxLatitude;
+};
+
+DiscBounds discBounds(double longitude, double latitude, double meters) {
+    double angle = meters / earthRadiusMeters;
+    double minLatitude = latitude - angle / degreesToRadians;
+    double maxLatitude = latitude + angle / degreesToRadians;
+    if (minLatitude <= -90.0 || maxLatitude >= 90.0 || std::cos(latitude * degreesToRadians) <= std::sin(angle)) {
+        // The disc reaches a pole and spans all longitudes
+        return {-180.0, 180.0, std::max(minLatitude, -90.0), std::min(maxLatitude, 90.0)};
+    }
+    double longitudeDelta = std::asin(std::sin(angle) / std::cos(latitude * degreesToRadians)) / degreesToRadians;
+    return {longitude - longitudeDelta, longitude + longitudeDelta, minLatitude, maxLatitude};
+}
+}// namespace
+
+GeoContext::GeoContext(std::vector<HighRiskArea> areas, double areaRadiusMeters, double withinDistanceMeters, STBox box)
+    : areas(std::move(areas)), areaRadiusMeters(areaRadiusMeters), withinDistanceMeters(withinDistanceMeters), box(box) {
+    buildGrid();
+}
+
+void GeoContext::buildGrid() {
+    if (areas.empty()) {
+        return;
+    }
+    gridMeters = std::max(areaRadiusMeters, withinDistanceMeters);
+    bool nearEquator = true;
+    for (const auto& area : areas) {
+        areaMetersPerLongitude.push_back(metersPerLatitude * std::cos(area.latitude * degreesToRadians));
+        nearEquator = nearEquator && std::abs(area.latitude) <= equirectangularMaxLatitude;
+    }
+    equirectangularMeters = nearEquator ? equirectangularMaxMeters : 0.0;
+    std::vector<DiscBounds> bounds;
+    bounds.reserve(areas.size());
+    DiscBounds extent = discBounds(areas.front().longitude, areas.front().latitude, gridMeters);
+    for (const auto& area : areas) {
+        bounds.push_back(discBounds(area.longitude, area.latitude, gridMeters));
+        extent.minLongitude = std::min(extent.minLongitude, bounds.back().minLongitude);
+        extent.maxLongitude = std::max(extent.maxLongitude, bounds.back().maxLongitude);
+        extent.minLatitude = std::min(extent.minLatitude, bounds.back().minLatitude);
+        extent.maxLatitude = std::max(extent.maxLatitude, bounds.back().maxLatitude);
+    }
+
+    // Cells of about the larger distance, so a disc covers a handful of cells
+    double middleLatitude = (extent.minLatitude + extent.maxLatitude) / 2;
+    cellLatitudeDegrees = std::max(gridMeters, minCellMeters) / earthRadiusMeters / degreesToRadians;
+    cellLongitudeDegrees = cellLatitudeDegrees / std::max(std::cos(middleLatitude * degreesToRadians), 0.01);
+    auto cells = [&] {
+        gridColumns = static_cast<size_t>((extent.maxLongitude - extent.minLongitude) / cellLongitudeDegrees) + 1;
+        gridRows = static_cast<size_t>((extent.maxLatitude - extent.minLatitude) / cellLatitudeDegrees) + 1;
+        return gridColumns * gridRows;
+    };
+    while (cells() > maxCells) {
+        cellLongitudeDegrees *= 2;
+        cellLatitudeDegrees *= 2;
+    }
+    gridMinLongitude = extent.minLongitude;
+    gridMinLatitude = extent.minLatitude;
+    wrapsLongitude = extent.minLongitude < -180.0 || extent.maxLongitude > 180.0;
+
+    // Count the areas per cell, then place them
+    auto forEachCell = [&](const DiscBounds& disc, auto&& action) {
+        auto firstColumn = static_cast<size_t>((disc.minLongitude - gridMinLongitude) / cellLongitudeDegrees);
+        auto lastColumn = std::min(static_cast<size_t>((disc.maxLongitude - gridMinLongitude) / cellLongitudeDegrees), gridColumns - 1);
+        auto firstRow = static_cast<size_t>((disc.minLatitude - gridMinLatitude) / cellLatitudeDegrees);
+        auto lastRow = std::min(static_cast<size_t>((disc.maxLatitude - gridMinLatitude) / cellLatitudeDegrees), gridRows - 1);
+        for (size_t row = firstRow; row <= lastRow; ++row) {
+            for (size_t column = firstColumn; column <= lastColumn; ++column) {
+                action(row * gridColumns + column);
+            }
+        }
+    };
+    cellOffsets.assign(gridColumns * gridRows + 1, 0);
+    for (const auto& disc : bounds) {
+        forEachCell(disc, [&](size_t cell) { ++cellOffsets[cell + 1]; });
+    }
+    for (size_t cell = 0; cell < gridColumns * gridRows; ++cell) {
+        cellOffsets[cell + 1] += cellOffsets[cell];
+    }
+    cellAreas.resize(cellOffsets.back());
+    auto next = cellOffsets;
+    for (size_t area = 0; area < areas.size(); ++area) {
+        forEachCell(bounds[area], [&](size_t cell) { cellAreas[next[cell]++] = static_cast<uint32_t>(area); });
+    }
+}
+
+size_t GeoContext::findCell(double longitude, double latitude) const {
+    double column = (longitude - gridMinLongitude) / cellLongitudeDegrees;
+    double row = (latitude - gridMinLatitude) / cellLatitudeDegrees;
+    // Also rejects NaN positions
+    if (!(column >= 0 && row >= 0 && column < static_cast<double>(gridColumns) && row < static_cast<double>(gridRows))) {
+        return noCell;
+    }
+    return static_cast<size_t>(row) * gridColumns + static_cast<size_t>(column);
+}
+
+GeoContext GeoContext::fromCsv(const std::string& path, double areaRadiusMeters, double withinDistanceMeters, STBox box) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open high-risk areas file " + path);
+    }
+    std::vector<HighRiskArea> areas;
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        std::istringstream row(line);
+        std::string timestamp, latitude, longitude;
+        if (!std::getline(row, timestamp, ',') || !std::getline(row, latitude, ',') || !std::getline(row, longitude, ',')) {
+            throw std::runtime_error("Malformed high-risk area '" + line + "' in " + path);
+        }
+        areas.push_back({std::stoull(timestamp), std::stod(latitude), std::stod(longitude)});
+    }
+    return GeoContext(std::move(areas), areaRadiusMeters, withinDistanceMeters, box);
+}
+
+double GeoContext::haversineMeters(double longitude1, double latitude1, double longitude2, double latitude2) {
+    double deltaLatitude = (latitude2 - latitude1) * degreesToRadians;
+    double deltaLongitude = (longitude2 - longitude1) * degreesToRadians;
+    double a = std::sin(deltaLatitude / 2) * std::sin(deltaLatitude / 2)
+        + std::cos(latitude1 * degreesToRadians) * std::cos(latitude2 * degreesToRadians) * std::sin(deltaLongitude / 2)
+            * std::sin(deltaLongitude / 2);
+    return 2 * earthRadiusMeters * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+bool GeoContext::anyAreaWithin(double longitude, double latitude, double meters) const {
+    if (meters > gridMeters) {
+        // The cells only list areas up to gridMeters away
+        return std::any_of(areas.begin(), areas.end(), [&](const HighRiskArea& area) {
+            return haversineMeters(longitude, latitude, area.longitude, area.latitude) <= meters;
+        });
+    }
+    if (anyAreaInCell(findCell(longitude, latitude), longitude, latitude, meters)) {
+        return true;
+    }
+    return wrapsLongitude
+        && (anyAreaInCell(findCell(longitude - 360.0, latitude), longitude, latitude, meters)
+            || anyAreaInCell(findCell(longitude + 360.0, latitude), longitude, latitude, meters));
+}
+
+bool GeoContext::anyAreaInCell(size_t cell, double longitude, double latitude, double meters) const {
+    if (cell == noCell) {
+        return false;
+    }
+    // A great-circle distance is at least the latitude difference, which rejects most candidates without
+    // trigonometry; the slack keeps rounding from rejecting a position haversine would accept
+    double maxLatitudeDelta = meters / earthRadiusMeters / degreesToRadians * (1 + 1e-9);
+    for (auto index = cellOffsets[cell]; index < cellOffsets[cell + 1]; ++index) {
+        const auto& area = areas[cellAreas[index]];
+        if (std::abs(area.latitude - latitude) <= maxLatitudeDelta
+            && haversineMeters(longitude, latitude, area.longitude, area.latitude) <= meters) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GeoContext::anyAreaWithin(const double* longitudes, const double* latitudes, size_t count, double meters, double* out) const {
+    if (meters > gridMeters || wrapsLongitude) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = anyAreaWithin(longitudes[i], latitudes[i], meters);
+        }
+        return;
+    }
+    // Squared equirectangular distances at or below lower are within meters, above upper they are not;
+    // in between, and always when the approximation does not hold, haversine decides
+    bool approximate = meters <= equirectangularMeters;
+    double lower = approximate ? meters * (1 - equirectangularTolerance) : -1.0;
+    double upper = approximate ? meters * (1 + equirectangularTolerance) : std::numeric_limits<double>::infinity();
+    lower = lower < 0 ? -1.0 : lower * lower;
+    upper = upper * upper;
+    auto emptyCell = static_cast<uint32_t>(gridColumns * gridRows);
+    auto columns = static_cast<double>(gridColumns);
+    auto rows = static_cast<double>(gridRows);
+
+    uint32_t cells[lookupBatch];
+    for (size_t offset = 0; offset < count; offset += lookupBatch) {
+        size_t length = std::min(lookupBatch, count - offset);
+        const double* longitude = longitudes + offset;
+        const double* latitude = latitudes + offset;
+
+        // Cell of every position without branches, positions outside the grid get the empty sentinel
+        for (size_t i = 0; i < length; ++i) {
+            double column = (longitude[i] - gridMinLongitude) / cellLongitudeDegrees;
+            double row = (latitude[i] - gridMinLatitude) / cellLatitudeDegrees;
+            bool inside = column >= 0 && row >= 0 && column < columns && row < rows;
+            auto cell = static_cast<uint32_t>(inside ? row : 0) * static_cast<uint32_t>(gridColumns)
+                + static_cast<uint32_t>(inside ? column : 0);
+            cells[i] = inside ? cell : emptyCell;
+        }
+
+        for (size_t i = 0; i < length; ++i) {
+            bool within = false;
+            auto cell = cells[i];
+            if (cell != emptyCell) {
+                for (auto index = cellOffsets[cell]; index < cellOffsets[cell + 1] && !within; ++index) {
+                    auto area = cellAreas[index];
+                    double dx = (longitude[i] - areas[area].longitude) * areaMetersPerLongitude[area];
+                    double dy = (latitude[i] - areas[area].latitude) * metersPerLatitude;
+                    double squared = dx * dx + dy * dy;
+                    within = squared <= lower
+                        || (squared <= upper
+                            && haversineMeters(longitude[i], latitude[i], areas[area].longitude, areas[area].latitude) <= meters);
+                }
+            }
+            out[offset + i] = within;
+        }
+    }
+}
+
+bool GeoContext::intersectsArea(double longitude, double latitude, uint64_t) const {
+    return anyAreaWithin(longitude, latitude, areaRadiusMeters);
+}
+
+bool GeoContext::withinDistance(double longitude, double latitude, uint64_t, double slackMeters) const {
+    return anyAreaWithin(longitude, latitude, withinDistanceMeters + slackMeters);
+}
+
+void GeoContext::intersectsArea(const double* longitudes, const double* latitudes, size_t count, double* out) const {
+    anyAreaWithin(longitudes, latitudes, count, areaRadiusMeters, out);
+}
+
+void GeoContext::withinDistance(const double* longitudes, const double* latitudes, size_t count, double slackMeters, double* out) const {
+    anyAreaWithin(longitudes, latitudes, count, withinDistanceMeters + slackMeters, out);
+}
+
+void GeoContext::atSTBox(const double* longitudes, const double* latitudes, const double* timestamps, size_t count, double* out) const {
+    for (size_t i = 0; i < count; ++i) {
+        auto timestamp = static_cast<uint64_t>(timestamps[i]);
+        out[i] = longitudes[i] >= box.minLongitude && longitudes[i] <= box.maxLongitude && latitudes[i] >= box.minLatitude
+            && latitudes[i] <= box.maxLatitude && timestamp >= box.minTime && timestamp <= box.maxTime;
+    }
+}
+
+bool GeoContext::atSTBox(double longitude, double latitude, uint64_t timestamp) const {
+    return longitude >= box.minLongitude && longitude <= box.maxLongitude && latitude >= box.minLatitude
+        && latitude <= box.maxLatitude && timestamp >= box.minTime && timestamp <= box.maxTime;
+}
+
+const std::vector<HighRiskArea>& GeoContext::getAreas() const { return areas; }
+
+double GeoContext::getAreaRadiusMeters() const { return areaRadiusMeters; }
+
+double GeoContext::getWithinDistanceMeters() const { return withinDistanceMeters; }
+
+const STBox& GeoContext::getBox() const { return box; }
+
+size_t GeoContext::getNumberOfCells() const { return gridColumns * gridRows; }
+
+size_t GeoContext::getNumberOfCellEntries() const { return cellAreas.size(); }
+
+}// namespace SNCB::Engine
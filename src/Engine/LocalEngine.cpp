@@ -0,0 +1,579 @@
+#include <Engine/LocalEngine.hpp>
+
+#include <Engine/ColumnarSource.hpp>
+#include <Engine/CsvSource.hpp>
+#include <Engine/ReplaySource.hpp>
+#include <Engine/SncbGenerator.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace SNCB::Engine {
+
+std::string toString(QueryStatus status) {
+    switch (status) {
+        case QueryStatus::Registered: return "REGISTERED";
+        case QueryStatus::Running: return "RUNNING";
+        case QueryStatus::Stopped: return "STOPPED";
+        case QueryStatus::Failed: return "FAILED";
+    }
+    return "UNKNOWN";
+}
+
+namespace {
+
+bool reads(const ExpressionNodePtr& expression, const std::string& field) {
+    std::vector<std::string> fields;
+    expression->collectFields(fields);
+    return std::find(fields.begin(), fields.end(), field) != fields.end();
+}
+
+/**
+ * True if no later operator reads the field of the map at position index before a projection, a window or
+ * another map of the field drops it; fields that reach the sink or a join are live. A later map of the field
+ * writes in place and keeps the type and column of the field, so it only drops the map if the field is in the
+ * map's input schema, or else if both maps yield the same type and no map in between appends a field before it;
+ * without the input schema it never drops the map.
+ */
+bool isDeadMap(const std::vector<LogicalOperator>& operators, size_t index, const Schema* inputSchema) {
+    const auto& [field, value] = std::get<MapOperator>(operators[index]);
+    bool appendsBetween = false;
+    for (size_t i = index + 1; i < operators.size(); ++i) {
+        const auto& op = operators[i];
+        if (const auto* filter = std::get_if<FilterOperator>(&op)) {
+            if (reads(filter->predicate, field)) {
+                return false;
+            }
+        } else if (const auto* map = std::get_if<MapOperator>(&op)) {
+            if (reads(map->value, field)) {
+                return false;
+            }
+            if (map->field == field) {
+                if (inputSchema == nullptr) {
+                    return false;
+                }
+                if (inputSchema->contains(field)) {
+                    return true;
+                }
+                auto type = CompiledExpression::resultTypeOf(value, *inputSchema);
+                return !appendsBetween && type && type == CompiledExpression::resultTypeOf(map->value, *inputSchema);
+            }
+            appendsBetween |= inputSchema == nullptr || !inputSchema->contains(map->field);
+        } else if (const auto* project = std::get_if<ProjectOperator>(&op)) {
+            return std::find(project->fields.begin(), project->fields.end(), field) == project->fields.end();
+        } else if (const auto* window = std::get_if<WindowOperator>(&op)) {
+            bool read = window->window->time.fieldName == field
+                        || (window->window->predicate && reads(window->window->predicate, field));
+            for (const auto& aggregation : window->aggregations) {
+                read |= aggregation->getOnField() && reads(aggregation->getOnField(), field);
+            }
+            return !read;
+        } else {
+            return false;
+        }
+    }
+    return false;
+}
+
+}// namespace
+
+double QueryStatistics::getExecutionSeconds() const { return std::chrono::duration<double>(endTime - startTime).count(); }
+
+LocalEngine::LocalEngine(SourceCatalog catalog, std::shared_ptr<const GeoContext> geo)
+    : catalog(std::move(catalog)), geo(std::move(geo)) {}
+
+LocalEngine::~LocalEngine() {
+    {
+        std::lock_guard lock(mutex);
+        for (const auto& [id, query] : queries) {
+            query->stopRequested = true;
+        }
+    }
+    for (const auto& group : groups) {
+        if (group->thread.joinable()) {
+            group->thread.join();
+        }
+    }
+}
+
+std::unique_ptr<DataSource> LocalEngine::openSource(const SourceCatalog& catalog, const std::string& sourceName,
+                                                    const SchemaPtr& readSchema, size_t tuplesPerBuffer) {
+    const auto& physicalSource = catalog.getPhysicalSource(sourceName);
+    if (physicalSource.generator) {
+        return std::make_unique<SncbGenerator>(*physicalSource.generator, readSchema);
+    }
+    if (physicalSource.columnarFilePath.empty()) {
+        return std::make_unique<CsvSource>(physicalSource, catalog.getSchema(sourceName), readSchema);
+    }
+    return std::make_unique<ColumnarSource>(physicalSource.columnarFilePath, readSchema, tuplesPerBuffer);
+}
+
+std::unique_ptr<ExecutableOperator> LocalEngine::compileJoin(const JoinOperator& join, const SchemaPtr& schema,
+                                                             const GeoContext* geo, size_t capacity, const SourceCatalog* catalog) {
+    const auto& right = *join.right;
+    if (catalog == nullptr) {
+        throw std::invalid_argument("A join needs the source catalog to read " + right.getSourceName());
+    }
+    auto readSchema = getReadSchema(right, catalog->getSchema(right.getSourceName()));
+    auto tuplesPerBuffer = catalog->getTuplesPerBuffer(right.getSourceName());
+    auto pipeline = compileChain(right.getOperators(), 0, readSchema, nullptr, geo, tuplesPerBuffer, catalog);
+    auto rightSchema = readSchema;
+    for (const auto* op = pipeline.get(); op != nullptr; op = op->getNext()) {
+        rightSchema = op->getOutputSchema();
+    }
+    return std::make_unique<LatestWithinJoinExecutable>(join.condition, schema,
+                                                        openSource(*catalog, right.getSourceName(), readSchema, tuplesPerBuffer),
+                                                        readSchema, tuplesPerBuffer, std::move(pipeline), rightSchema, capacity);
+}
+
+std::unique_ptr<ExecutableOperator> LocalEngine::compileChain(const std::vector<LogicalOperator>& operators, size_t first,
+                                                              SchemaPtr schema, const SinkDescriptor* sink,
+                                                              const GeoContext* geo, size_t capacity,
+                                                              const SourceCatalog* catalog, bool dropDeadMaps) {
+    std::vector<std::unique_ptr<ExecutableOperator>> chain;
+    for (size_t i = first; i < operators.size(); ++i) {
+        std::visit(
+            [&](const auto& op) {
+                using T = std::decay_t<decltype(op)>;
+                if constexpr (std::is_same_v<T, FilterOperator>) {
+                    const auto* window = i + 1 < operators.size() ? std::get_if<WindowOperator>(&operators[i + 1]) : nullptr;
+                    if (window != nullptr && window->window->kind == WindowKind::Threshold) {
+                        // The threshold window evaluates the filter on its own batches, no filtered buffer is built
+                        chain.push_back(std::make_unique<ThresholdWindowExecutable>(*window, schema, geo, capacity, op.predicate));
+                        ++i;
+                    } else {
+                        chain.push_back(std::make_unique<FilterExecutable>(op.predicate, schema, geo, capacity));
+                    }
+                } else if constexpr (std::is_same_v<T, MapOperator>) {
+                    if (dropDeadMaps && isDeadMap(operators, i, schema.get())) {
+                        return;
+                    }
+                    chain.push_back(std::make_unique<MapExecutable>(op.field, op.value, schema, geo, capacity));
+                } else if constexpr (std::is_same_v<T, ProjectOperator>) {
+                    chain.push_back(std::make_unique<ProjectExecutable>(op.fields, schema, capacity));
+                } else if constexpr (std::is_same_v<T, JoinOperator>) {
+                    chain.push_back(compileJoin(op, schema, geo, capacity, catalog));
+                } else if (op.window->kind == WindowKind::Threshold) {
+                    chain.push_back(std::make_unique<ThresholdWindowExecutable>(op, schema, geo, capacity));
+                } else if (op.window->slide == op.window->size) {
+                    // Tumbling windows combine one partial per slice, see SlicePreAggregationExecutable
+                    chain.push_back(std::make_unique<SlicePreAggregationExecutable>(op, schema, geo, capacity));
+                    chain.push_back(std::make_unique<TimeWindowExecutable>(op, schema, geo, capacity, true));
+                } else {
+                    chain.push_back(std::make_unique<TimeWindowExecutable>(op, schema, geo, capacity));
+                }
+            },
+            operators[i]);
+        if (!chain.empty()) {
+            schema = chain.back()->getOutputSchema();
+        }
+    }
+    if (sink != nullptr) {
+        chain.push_back(FileSink::create(*sink, schema));
+    }
+    if (chain.empty()) {
+        return nullptr;
+    }
+
+    for (size_t i = chain.size() - 1; i > 0; --i) {
+        chain[i - 1]->setNext(std::move(chain[i]));
+    }
+    return std::move(chain.front());
+}
+
+std::unique_ptr<ExecutableOperator> LocalEngine::compile(const Query& query, const SchemaPtr& sourceSchema,
+                                                         const GeoContext* geo, size_t capacity, const SourceCatalog* catalog,
+                                                         bool dropDeadMaps) {
+    if (!query.getSink()) {
+        throw std::invalid_argument("Query on " + query.getSourceName() + " has no sink");
+    }
+    return compileChain(query.getOperators(), 0, sourceSchema, query.getSink().get(), geo, capacity, catalog, dropDeadMaps);
+}
+
+SchemaPtr LocalEngine::getReadSchema(const Query& query, const SchemaPtr& sourceSchema, bool dropDeadMaps) {
+    std::vector<std::string> names;
+    bool readsAll = true;
+    const auto& operators = query.getOperators();
+    for (size_t i = 0; i < operators.size(); ++i) {
+        std::visit(
+            [&](const auto& op) {
+                using T = std::decay_t<decltype(op)>;
+                if constexpr (std::is_same_v<T, FilterOperator>) {
+                    op.predicate->collectFields(names);
+                } else if constexpr (std::is_same_v<T, MapOperator>) {
+                    // Which maps the chain drops also depends on its schemas, so this keeps every map it may keep
+                    if (!dropDeadMaps || !isDeadMap(operators, i, nullptr)) {
+                        op.value->collectFields(names);
+                    }
+                } else if constexpr (std::is_same_v<T, ProjectOperator>) {
+                    names.insert(names.end(), op.fields.begin(), op.fields.end());
+                    readsAll = false;
+                } else if constexpr (std::is_same_v<T, JoinOperator>) {
+                    names.insert(names.end(), {op.condition.leftTime, op.condition.leftLongitude, op.condition.leftLatitude});
+                } else {
+                    if (op.window->predicate) {
+                        op.window->predicate->collectFields(names);
+                        if (op.window->maxDuration > 0) {
+                            names.push_back(op.window->time.fieldName);
+                        }
+                    } else {
+                        names.push_back(op.window->time.fieldName);
+                    }
+                    for (const auto& aggregation : op.aggregations) {
+                        if (aggregation->getOnField()) {
+                            aggregation->getOnField()->collectFields(names);
+                        }
+                    }
+                    readsAll = false;
+                }
+            },
+            operators[i]);
+        if (!readsAll) {
+            break;
+        }
+    }
+    if (readsAll) {
+        return sourceSchema;
+    }
+
+    // Names of fields created by maps are not in the source and drop out here
+    auto schema = std::make_shared<Schema>();
+    for (const auto& field : sourceSchema->getFields()) {
+        if (std::find(names.begin(), names.end(), field.name) != names.end()) {
+            schema->addField(field.name, field.type);
+        }
+    }
+    return schema;
+}
+
+const FileSink* LocalEngine::findSink(const ExecutableOperator* branch) {
+    while (branch->getNext() != nullptr) {
+        branch = branch->getNext();
+    }
+    return static_cast<const FileSink*>(branch);
+}
+
+std::unique_ptr<LocalEngine::QueryGroup> LocalEngine::buildGroup(const std::vector<const Query*>& groupQueries,
+                                                                 std::vector<std::unique_ptr<RunningQuery>>& members) const {
+    const auto& sourceName = groupQueries.front()->getSourceName();
+    auto fileSchema = catalog.getSchema(sourceName);
+
+    // The scan reads every field one of the queries reads
+    std::vector<SchemaPtr> readSchemas;
+    for (const auto* query : groupQueries) {
+        if (!query->getSink()) {
+            throw std::invalid_argument("Query on " + sourceName + " has no sink");
+        }
+        readSchemas.push_back(getReadSchema(*query, fileSchema));
+    }
+    auto readSchema = std::make_shared<Schema>();
+    for (const auto& field : fileSchema->getFields()) {
+        if (std::any_of(readSchemas.begin(), readSchemas.end(), [&](const auto& schema) { return schema->contains(field.name); })) {
+            readSchema->addField(field.name, field.type);
+        }
+    }
+
+    auto group = std::make_unique<QueryGroup>();
+    group->readSchema = readSchema;
+    group->tuplesPerBuffer = catalog.getTuplesPerBuffer(sourceName);
+    group->trackLatency = trackLatency;
+    group->workerSlots = workerSlots;
+    group->pipeline = std::make_unique<FanOutExecutable>(readSchema, group->tuplesPerBuffer);
+    auto capacity = group->tuplesPerBuffer;
+
+    // Queries that begin with the same time window, by time field, size and slide
+    std::map<std::tuple<std::string, uint64_t, uint64_t>, std::vector<size_t>> windowShares;
+    for (size_t i = 0; i < groupQueries.size(); ++i) {
+        const auto& operators = groupQueries[i]->getOperators();
+        if (!operators.empty() && std::holds_alternative<WindowOperator>(operators.front())) {
+            const auto& window = *std::get<WindowOperator>(operators.front()).window;
+            if (window.kind != WindowKind::Threshold) {
+                windowShares[{window.time.fieldName, window.size, window.slide}].push_back(i);
+            }
+        }
+    }
+
+    members.clear();
+    for (size_t i = 0; i < groupQueries.size(); ++i) {
+        members.push_back(std::make_unique<RunningQuery>());
+        members.back()->group = group.get();
+    }
+
+    for (const auto& [key, sharing] : windowShares) {
+        if (sharing.size() < 2) {
+            continue;
+        }
+        // One window computes the union of the aggregations, equal aggregations only once
+        WindowOperator shared{std::get<WindowOperator>(groupQueries[sharing.front()]->getOperators().front()).window, {}};
+        std::map<std::string, std::string> aggregationNames;
+        std::vector<std::vector<std::string>> sourceFields;
+        for (auto index : sharing) {
+            const auto& window = std::get<WindowOperator>(groupQueries[index]->getOperators().front());
+            std::vector<std::string> fields{"start", "end"};
+            for (const auto& aggregation : window.aggregations) {
+                auto signature = std::to_string(static_cast<int>(aggregation->getKind())) + ":"
+                    + (aggregation->getOnField() ? aggregation->getOnField()->toString() : "");
+                auto [name, inserted] = aggregationNames.try_emplace(signature, "shared_" + std::to_string(aggregationNames.size()));
+                if (inserted) {
+                    shared.aggregations.push_back(std::make_shared<WindowAggregation>(aggregation->getKind(), aggregation->getOnField())
+                                                      ->as(Attribute(name->second)));
+                }
+                fields.push_back(name->second);
+            }
+            sourceFields.push_back(std::move(fields));
+        }
+
+        bool tumbling = shared.window->slide == shared.window->size;
+        auto window = std::make_unique<TimeWindowExecutable>(shared, readSchema, geo.get(), capacity, tumbling);
+        auto fanOut = std::make_unique<FanOutExecutable>(window->getOutputSchema(), capacity);
+        for (size_t i = 0; i < sharing.size(); ++i) {
+            const auto& query = *groupQueries[sharing[i]];
+            const auto& window = std::get<WindowOperator>(query.getOperators().front());
+            // Each query sees the window under its own aggregation names, as if it ran alone
+            std::vector<std::string> names{"start", "end"};
+            for (const auto& aggregation : window.aggregations) {
+                names.push_back(aggregation->getAsField());
+            }
+            auto adapter = std::make_unique<ProjectExecutable>(sourceFields[i], names, fanOut->getOutputSchema(), capacity);
+            adapter->setNext(compileChain(query.getOperators(), 1, adapter->getOutputSchema(), query.getSink().get(), geo.get(),
+                                          capacity, &catalog));
+            auto& member = *members[sharing[i]];
+            member.owner = fanOut.get();
+            member.branch = fanOut->addBranch(std::move(adapter));
+            member.sink = findSink(member.branch);
+        }
+        window->setNext(std::move(fanOut));
+        if (tumbling) {
+            auto partials = std::make_unique<SlicePreAggregationExecutable>(shared, readSchema, geo.get(), capacity);
+            partials->setNext(std::move(window));
+            group->pipeline->addBranch(std::move(partials));
+        } else {
+            group->pipeline->addBranch(std::move(window));
+        }
+    }
+
+    for (size_t i = 0; i < groupQueries.size(); ++i) {
+        auto& member = *members[i];
+        if (member.branch == nullptr) {
+            member.owner = group->pipeline.get();
+            member.branch = group->pipeline->addBranch(compile(*groupQueries[i], readSchema, geo.get(), capacity, &catalog));
+            member.sink = findSink(member.branch);
+        }
+    }
+    group->source = openSource(catalog, sourceName, readSchema, group->tuplesPerBuffer);
+    if (const auto& replay = catalog.getPhysicalSource(sourceName).replay) {
+        group->source = std::make_unique<ReplaySource>(std::move(group->source), readSchema, group->tuplesPerBuffer, *replay);
+    }
+    return group;
+}
+
+uint64_t LocalEngine::submitQuery(const Query& query) { return submitQueries({query}, false).front(); }
+
+std::vector<uint64_t> LocalEngine::submitQueries(const std::vector<Query>& submitted, bool share) {
+    // Groups of queries that run together, in order of their first query
+    std::vector<std::vector<size_t>> partition;
+    for (size_t i = 0; i < submitted.size(); ++i) {
+        auto group = std::find_if(partition.begin(), partition.end(), [&](const auto& indices) {
+            return share && submitted[indices.front()].getSourceName() == submitted[i].getSourceName();
+        });
+        if (group == partition.end()) {
+            partition.push_back({i});
+        } else {
+            group->push_back(i);
+        }
+    }
+
+    // Everything is compiled before the first group starts, so a broken query starts nothing
+    std::vector<std::unique_ptr<QueryGroup>> built;
+    std::vector<std::vector<std::unique_ptr<RunningQuery>>> builtMembers(partition.size());
+    for (size_t g = 0; g < partition.size(); ++g) {
+        std::vector<const Query*> groupQueries;
+        for (auto index : partition[g]) {
+            groupQueries.push_back(&submitted[index]);
+        }
+        built.push_back(buildGroup(groupQueries, builtMembers[g]));
+    }
+
+    std::vector<uint64_t> queryIds(submitted.size());
+    std::lock_guard lock(mutex);
+    auto now = std::chrono::steady_clock::now();
+    for (size_t g = 0; g < partition.size(); ++g) {
+        auto* group = built[g].get();
+        for (size_t i = 0; i < partition[g].size(); ++i) {
+            auto& member = builtMembers[g][i];
+            member->status = QueryStatus::Running;
+            member->startTime = now;
+            group->members.push_back(member.get());
+            queryIds[partition[g][i]] = nextQueryId;
+            queries.emplace(nextQueryId++, std::move(member));
+        }
+        groups.push_back(std::move(built[g]));
+        group->thread = std::thread([this, group] { run(*group); });
+    }
+    return queryIds;
+}
+
+void LocalEngine::detach(RunningQuery& query) {
+    auto branch = query.owner->detachBranch(query.branch);
+    query.attached = false;
+    query.outputTuples.store(query.sink->getWrittenTuples(), std::memory_order_relaxed);
+    auto latencies = query.sink->getLatencies();
+    query.sink = nullptr;
+    branch.reset();
+    std::lock_guard lock(mutex);
+    query.latencies = std::move(latencies);
+    query.endTime = std::chrono::steady_clock::now();
+    query.status = QueryStatus::Stopped;
+}
+
+void LocalEngine::run(QueryGroup& group) {
+    auto attached = [&group] {
+        return std::count_if(group.members.begin(), group.members.end(), [](const RunningQuery* query) { return query->attached; });
+    };
+    // Holds one of the worker slots while the pipeline works, if the engine limits them
+    auto onWorker = [&group](auto&& work) {
+        if (group.workerSlots == nullptr) {
+            work();
+            return;
+        }
+        group.workerSlots->acquire();
+        try {
+            work();
+        } catch (...) {
+            group.workerSlots->release();
+            throw;
+        }
+        group.workerSlots->release();
+    };
+    try {
+        TupleBuffer buffer(group.readSchema, group.tuplesPerBuffer);
+        while (true) {
+            for (auto* query : group.members) {
+                if (query->attached && query->stopRequested.load(std::memory_order_relaxed)) {
+                    detach(*query);
+                    queryFinished.notify_all();
+                }
+            }
+            if (attached() == 0 || !group.source->fillBuffer(buffer)) {
+                break;
+            }
+            if (group.trackLatency) {
+                auto now = std::chrono::steady_clock::now().time_since_epoch();
+                buffer.setIngestionTime(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()));
+            }
+            for (auto* query : group.members) {
+                if (query->attached) {
+                    query->inputTuples.fetch_add(buffer.getNumberOfTuples(), std::memory_order_relaxed);
+                }
+            }
+            onWorker([&] { group.pipeline->execute(buffer); });
+            for (auto* query : group.members) {
+                if (query->attached) {
+                    query->outputTuples.store(query->sink->getWrittenTuples(), std::memory_order_relaxed);
+                }
+            }
+        }
+        onWorker([&] { group.pipeline->finish(); });
+        std::lock_guard lock(mutex);
+        for (auto* query : group.members) {
+            if (query->attached) {
+                query->outputTuples.store(query->sink->getWrittenTuples(), std::memory_order_relaxed);
+                query->latencies = query->sink->getLatencies();
+                query->attached = false;
+                query->endTime = std::chrono::steady_clock::now();
+                query->status = QueryStatus::Stopped;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::lock_guard lock(mutex);
+        for (auto* query : group.members) {
+            if (query->attached) {
+                query->attached = false;
+                query->endTime = std::chrono::steady_clock::now();
+                query->error = e.what();
+                query->status = QueryStatus::Failed;
+            }
+        }
+    }
+    queryFinished.notify_all();
+}
+
+LocalEngine::RunningQuery& LocalEngine::getQuery(uint64_t queryId) const {
+    auto it = queries.find(queryId);
+    if (it == queries.end()) {
+        throw std::invalid_argument("Unknown query id " + std::to_string(queryId));
+    }
+    return *it->second;
+}
+
+QueryStatus LocalEngine::getQueryStatus(uint64_t queryId) const {
+    std::lock_guard lock(mutex);
+    return getQuery(queryId).status.load();
+}
+
+bool LocalEngine::stopQuery(uint64_t queryId) {
+    std::unique_lock lock(mutex);
+    auto it = queries.find(queryId);
+    if (it == queries.end()) {
+        return false;
+    }
+    auto& query = *it->second;
+    query.stopRequested = true;
+    queryFinished.wait(lock, [&query] { return query.status != QueryStatus::Running; });
+
+    // The group's thread ends once none of its queries is running anymore
+    auto* group = query.group;
+    bool groupDone = std::none_of(group->members.begin(), group->members.end(), [](const RunningQuery* member) {
+        return member->status == QueryStatus::Running;
+    });
+    lock.unlock();
+    if (groupDone && group->thread.joinable() && group->thread.get_id() != std::this_thread::get_id()) {
+        group->thread.join();
+    }
+    return true;
+}
+
+QueryStatus LocalEngine::waitForQuery(uint64_t queryId, std::optional<std::chrono::milliseconds> timeout) {
+    std::unique_lock lock(mutex);
+    auto& query = getQuery(queryId);
+    auto done = [&query] { return query.status != QueryStatus::Registered && query.status != QueryStatus::Running; };
+    if (timeout) {
+        queryFinished.wait_for(lock, *timeout, done);
+    } else {
+        queryFinished.wait(lock, done);
+    }
+    return query.status.load();
+}
+
+QueryStatistics LocalEngine::getStatistics(uint64_t queryId) const {
+    std::lock_guard lock(mutex);
+    const auto& query = getQuery(queryId);
+    QueryStatistics statistics;
+    statistics.inputTuples = query.inputTuples.load();
+    statistics.outputTuples = query.outputTuples.load();
+    statistics.inputTupleSize = query.group->readSchema->getTupleSize();
+    statistics.startTime = query.startTime;
+    bool done = query.status == QueryStatus::Stopped || query.status == QueryStatus::Failed;
+    statistics.endTime = done ? query.endTime : std::chrono::steady_clock::now();
+    statistics.latencies = query.latencies;
+    return statistics;
+}
+
+std::string LocalEngine::getError(uint64_t queryId) const {
+    std::lock_guard lock(mutex);
+    return getQuery(queryId).error;
+}
+
+const SourceCatalog& LocalEngine::getCatalog() const { return catalog; }
+
+void LocalEngine::setLatencyTracking(bool enabled) { trackLatency = enabled; }
+
+void LocalEngine::setWorkerThreads(size_t n) {
+    workerSlots = n > 0 ? std::make_shared<std::counting_semaphore<>>(static_cast<std::ptrdiff_t>(n)) : nullptr;
+}
+
+}// namespace SNCB::Engine
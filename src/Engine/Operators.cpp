@@ -0,0 +1,807 @@
+#include <Engine/Operators.hpp>
+#include <Engine/BinarySinkFormat.hpp>
+#include <Engine/VectorKernels.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <sys/stat.h>
+
+namespace SNCB::Engine {
+
+ExecutableOperator::ExecutableOperator(SchemaPtr outputSchema) : outputSchema(std::move(outputSchema)) {}
+
+void ExecutableOperator::finish() {
+    if (next) {
+        next->finish();
+    }
+}
+
+bool ExecutableOperator::modifiesInput() const { return false; }
+
+void ExecutableOperator::setNext(std::unique_ptr<ExecutableOperator> nextOperator) { next = std::move(nextOperator); }
+
+ExecutableOperator* ExecutableOperator::getNext() const { return next.get(); }
+
+const SchemaPtr& ExecutableOperator::getOutputSchema() const { return outputSchema; }
+
+void ExecutableOperator::emit(TupleBuffer& buffer) {
+    if (next && !buffer.isEmpty()) {
+        next->execute(buffer);
+    }
+}
+
+FilterExecutable::FilterExecutable(const ExpressionNodePtr& predicate, SchemaPtr inputSchema, const GeoContext* geo, size_t capacity)
+    : ExecutableOperator(inputSchema), predicate(predicate, *inputSchema, geo), output(inputSchema, capacity) {}
+
+void FilterExecutable::execute(TupleBuffer& buffer) {
+    selection.resize(buffer.getNumberOfTuples());
+    size_t selected = 0;
+    for (size_t row = 0; row < buffer.getNumberOfTuples(); row += CompiledExpression::BatchSize) {
+        auto count = std::min(CompiledExpression::BatchSize, buffer.getNumberOfTuples() - row);
+        selected += predicate.selectBatch(buffer, row, count, selection.data() + selected);
+    }
+    selection.resize(selected);
+    // Gather the selected rows one column at a time
+    output.clear();
+    output.setIngestionTime(buffer.getIngestionTime());
+    for (size_t copied = 0; copied < selection.size();) {
+        if (output.isFull()) {
+            emit(output);
+            output.clear();
+        }
+        copied += output.appendRows(buffer, selection.data() + copied, selection.size() - copied);
+    }
+    emit(output);
+}
+
+SchemaPtr MapExecutable::outputSchemaOf(const std::string& field, const ExpressionNodePtr& value, const SchemaPtr& inputSchema,
+                                        const GeoContext* geo) {
+    if (inputSchema->contains(field)) {
+        return inputSchema;
+    }
+    auto schema = std::make_shared<Schema>(*inputSchema);
+    schema->addField(field, CompiledExpression(value, *inputSchema, geo).getResultType());
+    return schema;
+}
+
+MapExecutable::MapExecutable(const std::string& field, const ExpressionNodePtr& value, const SchemaPtr& inputSchema,
+                             const GeoContext* geo, size_t capacity)
+    : ExecutableOperator(outputSchemaOf(field, value, inputSchema, geo)), value(value, *inputSchema, geo),
+      targetField(outputSchema->getIndex(field)), inPlace(outputSchema == inputSchema) {
+    if (!inPlace) {
+        output.emplace(outputSchema, capacity);
+    }
+}
+
+void MapExecutable::execute(TupleBuffer& buffer) {
+    if (inPlace) {
+        for (size_t row = 0; row < buffer.getNumberOfTuples(); row += CompiledExpression::BatchSize) {
+            storeBatch(buffer, buffer, row, row, std::min(CompiledExpression::BatchSize, buffer.getNumberOfTuples() - row));
+        }
+        emit(buffer);
+        return;
+    }
+
+    // The new field is the last column, the others are copied over as they are
+    output->setIngestionTime(buffer.getIngestionTime());
+    for (size_t row = 0; row < buffer.getNumberOfTuples();) {
+        output->clear();
+        auto copied = output->appendRange(buffer, row, buffer.getNumberOfTuples() - row);
+        for (size_t i = 0; i < copied; i += CompiledExpression::BatchSize) {
+            storeBatch(buffer, *output, row + i, i, std::min(CompiledExpression::BatchSize, copied - i));
+        }
+        row += copied;
+        emit(*output);
+    }
+}
+
+bool MapExecutable::modifiesInput() const { return inPlace; }
+
+void MapExecutable::storeBatch(const TupleBuffer& input, TupleBuffer& target, size_t inputRow, size_t targetRow, size_t count) {
+    const double* results = value.evaluateBatch(input, inputRow, count);
+    if (outputSchema->getField(targetField).type == DataType::FLOAT64) {
+        // In place maps of a plain FLOAT64 field get their own column back
+        std::memmove(target.getDoubleColumn(targetField) + targetRow, results, count * sizeof(double));
+    } else {
+        Kernels::toUInt(results, target.getColumn(targetField) + targetRow, count);
+    }
+}
+
+namespace {
+SchemaPtr projectSchema(const std::vector<std::string>& fields, const std::vector<std::string>& outputNames,
+                        const Schema& inputSchema) {
+    if (outputNames.size() != fields.size()) {
+        throw std::invalid_argument("Projection of " + std::to_string(fields.size()) + " fields got "
+                                    + std::to_string(outputNames.size()) + " names");
+    }
+    auto schema = std::make_shared<Schema>();
+    for (size_t i = 0; i < fields.size(); ++i) {
+        schema->addField(outputNames[i], inputSchema.getField(inputSchema.getIndex(fields[i])).type);
+    }
+    return schema;
+}
+}// namespace
+
+ProjectExecutable::ProjectExecutable(const std::vector<std::string>& fields, const SchemaPtr& inputSchema, size_t capacity)
+    : ProjectExecutable(fields, fields, inputSchema, capacity) {}
+
+ProjectExecutable::ProjectExecutable(const std::vector<std::string>& fields, const std::vector<std::string>& outputNames,
+                                     const SchemaPtr& inputSchema, size_t capacity)
+    : ExecutableOperator(projectSchema(fields, outputNames, *inputSchema)), output(outputSchema, capacity) {
+    for (const auto& field : fields) {
+        sourceFields.push_back(inputSchema->getIndex(field));
+    }
+}
+
+void ProjectExecutable::execute(TupleBuffer& buffer) {
+    output.setIngestionTime(buffer.getIngestionTime());
+    for (size_t row = 0; row < buffer.getNumberOfTuples();) {
+        output.clear();
+        auto count = std::min(output.getCapacity(), buffer.getNumberOfTuples() - row);
+        for (size_t field = 0; field < sourceFields.size(); ++field) {
+            std::memcpy(output.getColumn(field), buffer.getColumn(sourceFields[field]) + row, count * sizeof(uint64_t));
+        }
+        output.setNumberOfTuples(count);
+        row += count;
+        emit(output);
+    }
+}
+
+namespace {
+std::vector<AggregationFunction> bindAggregations(const WindowOperator& window, const Schema& inputSchema, const GeoContext* geo) {
+    std::vector<AggregationFunction> functions;
+    for (const auto& aggregation : window.aggregations) {
+        functions.emplace_back(*aggregation, inputSchema, geo);
+    }
+    return functions;
+}
+
+SchemaPtr windowSchema(const WindowOperator& window, const Schema& inputSchema, const GeoContext* geo, bool withBounds) {
+    auto schema = std::make_shared<Schema>();
+    if (withBounds) {
+        schema->addField("start", DataType::UINT64);
+        schema->addField("end", DataType::UINT64);
+    }
+    for (const auto& function : bindAggregations(window, inputSchema, geo)) {
+        schema->addField(function.getResultField().name, function.getResultField().type);
+    }
+    return schema;
+}
+}// namespace
+
+SlicePreAggregationExecutable::SlicePreAggregationExecutable(const WindowOperator& window, const SchemaPtr& inputSchema,
+                                                             const GeoContext* geo, size_t capacity)
+    : ExecutableOperator(partialSchema(window.aggregations.size())), timeField(inputSchema->getIndex(window.window->time.fieldName)),
+      floatingTime(inputSchema->getField(timeField).type == DataType::FLOAT64),
+      sliceSize(std::gcd(window.window->size, window.window->slide)), aggregations(bindAggregations(window, *inputSchema, geo)),
+      output(outputSchema, capacity) {
+    for (const auto& aggregation : window.aggregations) {
+        if (aggregation->getOnField()) {
+            inputs.emplace_back(std::in_place, aggregation->getOnField(), *inputSchema, geo);
+        } else {
+            inputs.emplace_back();
+        }
+    }
+}
+
+SchemaPtr SlicePreAggregationExecutable::partialSchema(size_t numberOfAggregations) {
+    auto schema = std::make_shared<Schema>();
+    schema->addField("$slice", DataType::UINT64)
+        .addField("$maxTime", DataType::UINT64)
+        .addField("$ingestionTime", DataType::UINT64)
+        .addField("$tuples", DataType::UINT64);
+    for (size_t i = 0; i < numberOfAggregations; ++i) {
+        schema->addField("$value" + std::to_string(i), DataType::FLOAT64).addField("$count" + std::to_string(i), DataType::UINT64);
+    }
+    return schema;
+}
+
+void SlicePreAggregationExecutable::execute(TupleBuffer& buffer) {
+    output.clear();
+    output.setIngestionTime(buffer.getIngestionTime());
+    std::vector<const double*> values(aggregations.size());
+    for (size_t begin = 0; begin < buffer.getNumberOfTuples(); begin += CompiledExpression::BatchSize) {
+        auto count = std::min(CompiledExpression::BatchSize, buffer.getNumberOfTuples() - begin);
+        for (size_t i = 0; i < aggregations.size(); ++i) {
+            values[i] = inputs[i] ? inputs[i]->evaluateBatch(buffer, begin, count) : nullptr;
+        }
+        for (size_t offset = 0; offset < count; ++offset) {
+            auto row = begin + offset;
+            auto timestamp = floatingTime ? static_cast<uint64_t>(buffer.getDouble(row, timeField)) : buffer.getUInt(row, timeField);
+            uint64_t slice = timestamp - timestamp % sliceSize;
+            if (slice + sliceSize <= watermark) {
+                continue;
+            }
+            if (lastSlice == nullptr || slice != lastSliceStart) {
+                auto [open, inserted] = openSlices.try_emplace(slice);
+                if (inserted) {
+                    for (const auto& aggregation : aggregations) {
+                        open->second.values.push_back(aggregation.initial());
+                    }
+                }
+                lastSlice = &open->second;
+                lastSliceStart = slice;
+            }
+            ++lastSlice->tuples;
+            lastSlice->maxTime = std::max(lastSlice->maxTime, timestamp);
+            lastSlice->ingestionTime = std::max(lastSlice->ingestionTime, buffer.getIngestionTime());
+            for (size_t i = 0; i < aggregations.size(); ++i) {
+                // Folding one value as a partial of one tuple is what lift does
+                aggregations[i].combine(lastSlice->values[i], {values[i] ? values[i][offset] : 0.0, 1});
+            }
+            if (timestamp > watermark) {
+                // The slice of this tuple ends after it and stays open, so some slice is open here
+                watermark = timestamp;
+                if (openSlices.begin()->first + sliceSize <= watermark) {
+                    passSlices(watermark);
+                }
+            }
+        }
+    }
+    if (buffer.getNumberOfTuples() > 0) {
+        OpenSlice empty;
+        empty.maxTime = watermark;
+        empty.values.resize(aggregations.size());
+        appendRow(watermark - watermark % sliceSize, empty);
+    }
+    emit(output);
+}
+
+void SlicePreAggregationExecutable::finish() {
+    output.clear();
+    passSlices(std::nullopt);
+    emit(output);
+    ExecutableOperator::finish();
+}
+
+void SlicePreAggregationExecutable::passSlices(std::optional<uint64_t> until) {
+    while (!openSlices.empty() && (!until || openSlices.begin()->first + sliceSize <= *until)) {
+        if (&openSlices.begin()->second == lastSlice) {
+            lastSlice = nullptr;
+        }
+        appendRow(openSlices.begin()->first, openSlices.begin()->second);
+        openSlices.erase(openSlices.begin());
+    }
+}
+
+void SlicePreAggregationExecutable::appendRow(uint64_t slice, const OpenSlice& partial) {
+    if (output.isFull()) {
+        emit(output);
+        output.clear();
+    }
+    auto row = output.append();
+    output.setUInt(row, SliceField, slice);
+    output.setUInt(row, MaxTimeField, partial.maxTime);
+    output.setUInt(row, IngestionTimeField, partial.ingestionTime);
+    output.setUInt(row, TuplesField, partial.tuples);
+    for (size_t i = 0; i < partial.values.size(); ++i) {
+        output.setDouble(row, ValueField + 2 * i, partial.values[i].value);
+        output.setUInt(row, ValueField + 2 * i + 1, partial.values[i].count);
+    }
+}
+
+TimeWindowExecutable::TimeWindowExecutable(const WindowOperator& window, const SchemaPtr& inputSchema, const GeoContext* geo,
+                                           size_t capacity, bool partialInput)
+    : ExecutableOperator(windowSchema(window, *inputSchema, geo, true)),
+      timeField(inputSchema->getIndex(window.window->time.fieldName)),
+      floatingTime(inputSchema->getField(timeField).type == DataType::FLOAT64), partialInput(partialInput),
+      size(window.window->size), slide(window.window->slide), sliceSize(std::gcd(size, slide)),
+      aggregations(bindAggregations(window, *inputSchema, geo)),
+      pendingSlices(ArenaAllocator<std::pair<const uint64_t, Partial>>(&arena)), windowSlices(aggregations, &arena),
+      output(outputSchema, capacity) {}
+
+void TimeWindowExecutable::execute(TupleBuffer& buffer) {
+    output.clear();
+    if (partialInput) {
+        addPartials(buffer);
+        emit(output);
+        return;
+    }
+    for (size_t row = 0; row < buffer.getNumberOfTuples(); ++row) {
+        auto timestamp = floatingTime ? static_cast<uint64_t>(buffer.getDouble(row, timeField)) : buffer.getUInt(row, timeField);
+        // Windows end before the next tuple is added, so a late tuple only reaches windows that are still open
+        trigger(watermark);
+        addTuple(buffer, row, timestamp);
+        watermark = std::max(watermark, timestamp);
+    }
+    trigger(watermark);
+    emit(output);
+}
+
+Partial* TimeWindowExecutable::findSlice(uint64_t timestamp) {
+    uint64_t lastWindowStart = timestamp - timestamp % slide;
+    if (lastWindowStart + size <= watermark) {
+        return nullptr;
+    }
+    uint64_t sliceStart = timestamp - timestamp % sliceSize;
+    // The first window the tuple reaches: it contains the tuple and did not end at the watermark
+    auto firstWindowStart = firstWindowEndingAfter(std::max(timestamp, watermark));
+    nextWindowStart = nextWindowStart ? std::min(*nextWindowStart, firstWindowStart) : firstWindowStart;
+
+    if (!windowSlices.isEmpty() && sliceStart <= windowSlices.getLastStart()) {
+        // Out of order: the slice already belongs to the windows being emitted
+        return &windowSlices.findOrInsert(sliceStart);
+    }
+    auto [slice, inserted] = pendingSlices.try_emplace(sliceStart);
+    if (inserted) {
+        slice->second = windowSlices.identity();
+    }
+    return &slice->second;
+}
+
+void TimeWindowExecutable::addTuple(const TupleBuffer& buffer, size_t row, uint64_t timestamp) {
+    auto* slice = findSlice(timestamp);
+    if (slice == nullptr) {
+        return;
+    }
+    ++slice->tuples;
+    slice->ingestionTime = std::max(slice->ingestionTime, buffer.getIngestionTime());
+    for (size_t i = 0; i < aggregations.size(); ++i) {
+        aggregations[i].lift(slice->values[i], buffer, row);
+    }
+}
+
+void TimeWindowExecutable::addPartials(const TupleBuffer& buffer) {
+    using Partials = SlicePreAggregationExecutable;
+    partial.values.resize(aggregations.size());
+    for (size_t row = 0; row < buffer.getNumberOfTuples(); ++row) {
+        trigger(watermark);
+        partial.tuples = buffer.getUInt(row, Partials::TuplesField);
+        // Rows without tuples only advance the watermark to the largest timestamp the pre-aggregation saw
+        if (partial.tuples > 0) {
+            // A partial lies within one slice, so its start decides like any of its tuples which windows it reaches
+            auto* slice = findSlice(buffer.getUInt(row, Partials::SliceField));
+            if (slice != nullptr) {
+                partial.ingestionTime = buffer.getUInt(row, Partials::IngestionTimeField);
+                for (size_t i = 0; i < aggregations.size(); ++i) {
+                    partial.values[i] = {buffer.getDouble(row, Partials::ValueField + 2 * i),
+                                         buffer.getUInt(row, Partials::ValueField + 2 * i + 1)};
+                }
+                windowSlices.combine(*slice, partial);
+            }
+        }
+        watermark = std::max(watermark, buffer.getUInt(row, Partials::MaxTimeField));
+    }
+    trigger(watermark);
+}
+
+uint64_t TimeWindowExecutable::firstWindowEndingAfter(uint64_t timestamp) const {
+    return timestamp >= size ? (timestamp - size) / slide * slide + slide : 0;
+}
+
+void TimeWindowExecutable::trigger(uint64_t until) {
+    while (nextWindowStart && *nextWindowStart + size <= until) {
+        uint64_t start = *nextWindowStart;
+        uint64_t end = start + size;
+        while (!pendingSlices.empty() && pendingSlices.begin()->first < end) {
+            windowSlices.push(pendingSlices.begin()->first, pendingSlices.begin()->second);
+            pendingSlices.erase(pendingSlices.begin());
+        }
+        windowSlices.evictBefore(start);
+        if (!windowSlices.isEmpty()) {
+            windowSlices.query(windowState);
+            if (windowState.tuples > 0) {
+                emitWindow(start, windowState);
+            }
+            nextWindowStart = start + slide;
+        } else if (!pendingSlices.empty()) {
+            // Skip the empty windows up to the first one that covers the next slice
+            nextWindowStart = std::max(start + slide, firstWindowEndingAfter(pendingSlices.begin()->first));
+        } else {
+            nextWindowStart.reset();
+        }
+    }
+}
+
+void TimeWindowExecutable::emitWindow(uint64_t start, const Partial& window) {
+    // Results of a buffer share its ingestion time, windows of another one start a new buffer
+    if (output.isFull() || (!output.isEmpty() && output.getIngestionTime() != window.ingestionTime)) {
+        emit(output);
+        output.clear();
+    }
+    output.setIngestionTime(window.ingestionTime);
+    auto row = output.append();
+    output.setUInt(row, 0, start);
+    output.setUInt(row, 1, start + size);
+    for (size_t i = 0; i < aggregations.size(); ++i) {
+        output.setFromDouble(row, i + 2, aggregations[i].lower(window.values[i]));
+    }
+}
+
+void TimeWindowExecutable::finish() {
+    output.clear();
+    trigger(std::numeric_limits<uint64_t>::max());
+    emit(output);
+    ExecutableOperator::finish();
+}
+
+const ArenaStatistics& TimeWindowExecutable::getArenaStatistics() const { return arena.getStatistics(); }
+
+ThresholdWindowExecutable::ThresholdWindowExecutable(const WindowOperator& window, const SchemaPtr& inputSchema,
+                                                     const GeoContext* geo, size_t capacity, const ExpressionNodePtr& filter)
+    : ExecutableOperator(windowSchema(window, *inputSchema, geo, false)), predicate(window.window->predicate, *inputSchema, geo),
+      minCount(window.window->minCount), maxDuration(window.window->maxDuration),
+      aggregations(bindAggregations(window, *inputSchema, geo)), selection(CompiledExpression::BatchSize),
+      output(outputSchema, capacity) {
+    if (filter) {
+        this->filter.emplace(filter, *inputSchema, geo);
+    }
+    if (maxDuration > 0) {
+        timeField = inputSchema->getIndex(window.window->time.fieldName);
+        floatingTime = inputSchema->getField(*timeField).type == DataType::FLOAT64;
+    }
+}
+
+void ThresholdWindowExecutable::execute(TupleBuffer& buffer) {
+    output.clear();
+    for (size_t begin = 0; begin < buffer.getNumberOfTuples(); begin += CompiledExpression::BatchSize) {
+        auto count = std::min(CompiledExpression::BatchSize, buffer.getNumberOfTuples() - begin);
+        size_t selected = count;
+        if (filter) {
+            selected = filter->selectBatch(buffer, begin, count, selection.data());
+        } else {
+            std::iota(selection.begin(), selection.begin() + count, static_cast<uint32_t>(begin));
+        }
+        // Dense selections evaluate the predicate of the whole batch with the vector kernels, sparse ones row by row
+        const double* holds = selected * 4 >= count ? predicate.evaluateBatch(buffer, begin, count) : nullptr;
+        for (size_t i = 0; i < selected; ++i) {
+            auto row = selection[i];
+            if (holds != nullptr ? holds[row - begin] != 0.0 : predicate.evaluatePredicate(buffer, row)) {
+                addTuple(buffer, row);
+            } else if (open) {
+                close();
+            }
+        }
+    }
+    emit(output);
+}
+
+void ThresholdWindowExecutable::addTuple(const TupleBuffer& buffer, size_t row) {
+    uint64_t timestamp = 0;
+    if (timeField) {
+        timestamp = floatingTime ? static_cast<uint64_t>(buffer.getDouble(row, *timeField)) : buffer.getUInt(row, *timeField);
+        if (open && timestamp >= windowStart + maxDuration) {
+            close();
+        }
+    }
+    if (!open) {
+        open = true;
+        tuplesInWindow = 0;
+        windowIngestionTime = 0;
+        windowStart = timestamp;
+        states.clear();
+        for (const auto& aggregation : aggregations) {
+            states.push_back(aggregation.initial());
+        }
+    }
+    ++tuplesInWindow;
+    windowIngestionTime = std::max(windowIngestionTime, buffer.getIngestionTime());
+    for (size_t i = 0; i < aggregations.size(); ++i) {
+        aggregations[i].lift(states[i], buffer, row);
+    }
+}
+
+void ThresholdWindowExecutable::close() {
+    open = false;
+    if (tuplesInWindow < std::max<uint64_t>(minCount, 1)) {
+        return;
+    }
+    if (output.isFull() || (!output.isEmpty() && output.getIngestionTime() != windowIngestionTime)) {
+        emit(output);
+        output.clear();
+    }
+    output.setIngestionTime(windowIngestionTime);
+    auto row = output.append();
+    for (size_t i = 0; i < aggregations.size(); ++i) {
+        output.setFromDouble(row, i, aggregations[i].lower(states[i]));
+    }
+}
+
+void ThresholdWindowExecutable::finish() {
+    output.clear();
+    if (open) {
+        close();
+    }
+    emit(output);
+    ExecutableOperator::finish();
+}
+
+/** @brief Last operator of the right query of a join, adds what reaches it to the join state. */
+class LatestWithinJoinExecutable::RightSink : public ExecutableOperator {
+  public:
+    RightSink(LatestWithinJoinExecutable& join, SchemaPtr schema) : ExecutableOperator(std::move(schema)), join(join) {}
+    void execute(TupleBuffer& buffer) override { join.insert(buffer); }
+
+  private:
+    LatestWithinJoinExecutable& join;
+};
+
+namespace {
+size_t timeFieldIndex(const Schema& schema, const std::string& field) {
+    auto index = schema.getIndex(field);
+    if (schema.getField(index).type != DataType::UINT64) {
+        throw std::invalid_argument("Join time field " + field + " must be UINT64");
+    }
+    return index;
+}
+}// namespace
+
+SchemaPtr LatestWithinJoinExecutable::joinSchema(const Schema& left, const Schema& right) {
+    auto schema = std::make_shared<Schema>(left);
+    for (const auto& field : right.getFields()) {
+        if (left.contains(field.name)) {
+            throw std::invalid_argument("Both sides of the join have a field " + field.name + ", rename one with map and project");
+        }
+        schema->addField(field.name, field.type);
+    }
+    return schema;
+}
+
+LatestWithinJoinExecutable::LatestWithinJoinExecutable(const LatestWithinJoin& condition, const SchemaPtr& inputSchema,
+                                                       std::unique_ptr<DataSource> rightSource, SchemaPtr rightReadSchema,
+                                                       size_t rightTuplesPerBuffer, std::unique_ptr<ExecutableOperator> rightPipeline,
+                                                       const SchemaPtr& rightSchema, size_t capacity)
+    : ExecutableOperator(joinSchema(*inputSchema, *rightSchema)), leftTime(timeFieldIndex(*inputSchema, condition.leftTime)),
+      leftLongitude(inputSchema->getIndex(condition.leftLongitude)), leftLatitude(inputSchema->getIndex(condition.leftLatitude)),
+      rightTime(timeFieldIndex(*rightSchema, condition.rightTime)), rightLongitude(rightSchema->getIndex(condition.rightLongitude)),
+      rightLatitude(rightSchema->getIndex(condition.rightLatitude)), radiusMeters(condition.radiusMeters), maxAge(condition.maxAge),
+      rightSource(std::move(rightSource)), rightBuffer(std::move(rightReadSchema), rightTuplesPerBuffer),
+      rightPipeline(std::move(rightPipeline)), output(outputSchema, capacity) {
+    auto sink = std::make_unique<RightSink>(*this, rightSchema);
+    if (!this->rightPipeline) {
+        this->rightPipeline = std::move(sink);
+        return;
+    }
+    auto* last = this->rightPipeline.get();
+    while (last->getNext() != nullptr) {
+        last = last->getNext();
+    }
+    last->setNext(std::move(sink));
+}
+
+void LatestWithinJoinExecutable::insert(const TupleBuffer& buffer) {
+    const auto& schema = *buffer.getSchema();
+    for (size_t row = 0; row < buffer.getNumberOfTuples(); ++row) {
+        RightTuple tuple{buffer.getUInt(row, rightTime), buffer.getAsDouble(row, rightLongitude),
+                         buffer.getAsDouble(row, rightLatitude), std::vector<uint64_t>(schema.size())};
+        for (size_t field = 0; field < schema.size(); ++field) {
+            tuple.values[field] = buffer.getUInt(row, field);
+        }
+        rightWatermark = std::max(rightWatermark, tuple.timestamp);
+        state.push_back(std::move(tuple));
+    }
+}
+
+void LatestWithinJoinExecutable::advance(uint64_t timestamp) {
+    while (!rightExhausted && rightWatermark <= timestamp) {
+        if (!rightSource->fillBuffer(rightBuffer)) {
+            rightExhausted = true;
+            rightPipeline->finish();
+            break;
+        }
+        rightPipeline->execute(rightBuffer);
+    }
+}
+
+const LatestWithinJoinExecutable::RightTuple* LatestWithinJoinExecutable::findMatch(uint64_t timestamp, double longitude,
+                                                                                   double latitude) const {
+    for (auto it = state.rbegin(); it != state.rend(); ++it) {
+        if (it->timestamp > timestamp) {
+            continue;
+        }
+        if (timestamp - it->timestamp > maxAge) {
+            break;
+        }
+        if (GeoContext::haversineMeters(longitude, latitude, it->longitude, it->latitude) <= radiusMeters) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+void LatestWithinJoinExecutable::execute(TupleBuffer& buffer) {
+    auto leftWidth = buffer.getSchema()->size();
+    output.clear();
+    output.setIngestionTime(buffer.getIngestionTime());
+    for (size_t row = 0; row < buffer.getNumberOfTuples(); ++row) {
+        auto timestamp = buffer.getUInt(row, leftTime);
+        advance(timestamp);
+        if (timestamp > leftWatermark) {
+            // Right tuples more than maxAge before the left stream cannot match anymore
+            leftWatermark = timestamp;
+            while (!state.empty() && leftWatermark - std::min(state.front().timestamp, leftWatermark) > maxAge) {
+                state.pop_front();
+            }
+        }
+        const auto* match = findMatch(timestamp, buffer.getAsDouble(row, leftLongitude), buffer.getAsDouble(row, leftLatitude));
+        if (match == nullptr) {
+            continue;
+        }
+        if (output.isFull()) {
+            emit(output);
+            output.clear();
+        }
+        auto target = output.append();
+        for (size_t field = 0; field < leftWidth; ++field) {
+            output.getColumn(field)[target] = buffer.getColumn(field)[row];
+        }
+        for (size_t field = 0; field < match->values.size(); ++field) {
+            output.getColumn(leftWidth + field)[target] = match->values[field];
+        }
+    }
+    emit(output);
+}
+
+FanOutExecutable::FanOutExecutable(SchemaPtr schema, size_t capacity)
+    : ExecutableOperator(schema), copy(std::move(schema), capacity) {}
+
+void FanOutExecutable::execute(TupleBuffer& buffer) {
+    // The last branch may change the original, the others that would change it get a copy
+    for (size_t i = 0; i < branches.size(); ++i) {
+        if (i + 1 < branches.size() && branches[i]->modifiesInput()) {
+            copy.clear();
+            copy.appendRange(buffer, 0, buffer.getNumberOfTuples());
+            copy.setIngestionTime(buffer.getIngestionTime());
+            branches[i]->execute(copy);
+        } else {
+            branches[i]->execute(buffer);
+        }
+    }
+}
+
+void FanOutExecutable::finish() {
+    for (const auto& branch : branches) {
+        branch->finish();
+    }
+}
+
+ExecutableOperator* FanOutExecutable::addBranch(std::unique_ptr<ExecutableOperator> branch) {
+    branches.push_back(std::move(branch));
+    return branches.back().get();
+}
+
+std::unique_ptr<ExecutableOperator> FanOutExecutable::detachBranch(const ExecutableOperator* branch) {
+    auto it = std::find_if(branches.begin(), branches.end(), [branch](const auto& candidate) { return candidate.get() == branch; });
+    if (it == branches.end()) {
+        return nullptr;
+    }
+    auto detached = std::move(*it);
+    branches.erase(it);
+    detached->finish();
+    return detached;
+}
+
+size_t FanOutExecutable::getNumberOfBranches() const { return branches.size(); }
+
+std::unique_ptr<FileSink> FileSink::create(const SinkDescriptor& descriptor, SchemaPtr inputSchema) {
+    if (descriptor.format == "BINARY_FORMAT") {
+        return std::make_unique<BinaryFileSink>(descriptor, std::move(inputSchema));
+    }
+    return std::make_unique<CsvFileSink>(descriptor, std::move(inputSchema));
+}
+
+uint64_t FileSink::getWrittenTuples() const { return writtenTuples; }
+
+const Util::LatencyHistogram& FileSink::getLatencies() const { return latencies; }
+
+void FileSink::recordLatencies(const TupleBuffer& buffer) {
+    if (buffer.getIngestionTime() == 0) {
+        return;
+    }
+    auto now = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    latencies.record(now - std::min(now, buffer.getIngestionTime()), buffer.getNumberOfTuples());
+}
+
+CsvFileSink::CsvFileSink(const SinkDescriptor& descriptor, SchemaPtr inputSchema) : FileSink(std::move(inputSchema)) {
+    struct stat fileStat {};
+    bool hasContent = descriptor.append && ::stat(descriptor.filePath.c_str(), &fileStat) == 0 && fileStat.st_size > 0;
+    file = std::fopen(descriptor.filePath.c_str(), descriptor.append ? "a" : "w");
+    if (file == nullptr) {
+        throw std::runtime_error("Cannot open sink file " + descriptor.filePath);
+    }
+    if (!hasContent) {
+        std::string header;
+        for (const auto& field : outputSchema->getFields()) {
+            header += (header.empty() ? "" : ",") + field.name;
+        }
+        header += '\n';
+        std::fwrite(header.data(), 1, header.size(), file);
+    }
+}
+
+CsvFileSink::~CsvFileSink() {
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+}
+
+void CsvFileSink::execute(TupleBuffer& buffer) {
+    const auto& fields = outputSchema->getFields();
+    char number[32];
+    line.clear();
+    for (size_t row = 0; row < buffer.getNumberOfTuples(); ++row) {
+        for (size_t field = 0; field < fields.size(); ++field) {
+            if (field > 0) {
+                line += ',';
+            }
+            std::to_chars_result result{};
+            if (fields[field].type == DataType::FLOAT64) {
+                result = std::to_chars(number, number + sizeof(number), buffer.getDouble(row, field));
+            } else {
+                result = std::to_chars(number, number + sizeof(number), buffer.getUInt(row, field));
+            }
+            line.append(number, result.ptr);
+        }
+        line += '\n';
+    }
+    std::fwrite(line.data(), 1, line.size(), file);
+    writtenTuples += buffer.getNumberOfTuples();
+    recordLatencies(buffer);
+}
+
+void CsvFileSink::finish() { std::fflush(file); }
+
+BinaryFileSink::BinaryFileSink(const SinkDescriptor& descriptor, SchemaPtr inputSchema)
+    : FileSink(std::move(inputSchema)), pending(outputSchema, BlockTuples) {
+    BinarySinkFormat::encodeHeader(*outputSchema, encoded);
+    struct stat fileStat {};
+    if (descriptor.append && ::stat(descriptor.filePath.c_str(), &fileStat) == 0 && fileStat.st_size > 0) {
+        // New blocks must match the header already in the file
+        if (BinarySinkReader(descriptor.filePath).getSchema()->toString() != outputSchema->toString()) {
+            throw std::runtime_error("Sink file " + descriptor.filePath + " holds results of another schema");
+        }
+        encoded.clear();
+    }
+    file = std::fopen(descriptor.filePath.c_str(), descriptor.append ? "ab" : "wb");
+    if (file == nullptr) {
+        throw std::runtime_error("Cannot open sink file " + descriptor.filePath);
+    }
+}
+
+BinaryFileSink::~BinaryFileSink() {
+    if (file != nullptr) {
+        encodePending();
+        write();
+        std::fclose(file);
+    }
+}
+
+void BinaryFileSink::execute(TupleBuffer& buffer) {
+    for (size_t row = 0; row < buffer.getNumberOfTuples();) {
+        row += pending.appendRange(buffer, row, buffer.getNumberOfTuples() - row);
+        if (pending.isFull()) {
+            encodePending();
+        }
+    }
+    writtenTuples += buffer.getNumberOfTuples();
+    if (encoded.size() >= WriteBytes) {
+        write();
+    }
+    recordLatencies(buffer);
+}
+
+void BinaryFileSink::finish() {
+    encodePending();
+    write();
+    std::fflush(file);
+}
+
+void BinaryFileSink::encodePending() {
+    if (!pending.isEmpty()) {
+        BinarySinkFormat::encodeBlock(pending, encoded);
+        pending.clear();
+    }
+}
+
+void BinaryFileSink::write() {
+    std::fwrite(encoded.data(), 1, encoded.size(), file);
+    encoded.clear();
+}
+
+}// namespace SNCB::Engine
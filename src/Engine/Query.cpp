@@ -0,0 +1,82 @@
+#include <Engine/Query.hpp>
+
+#include <stdexcept>
+
+namespace SNCB::Engine {
+
+SinkDescriptorPtr FileSinkDescriptor::create(const std::string& filePath, const std::string& format, const std::string& mode) {
+    if (format != "CSV_FORMAT" && format != "BINARY_FORMAT") {
+        throw std::invalid_argument("The local engine writes CSV_FORMAT and BINARY_FORMAT sinks, got " + format);
+    }
+    if (mode != "APPEND" && mode != "OVERWRITE") {
+        throw std::invalid_argument("Sink mode must be APPEND or OVERWRITE, got " + mode);
+    }
+    return std::make_shared<SinkDescriptor>(SinkDescriptor{filePath, format, mode == "APPEND"});
+}
+
+Query::Query(std::string sourceName) : sourceName(std::move(sourceName)) {}
+
+Query Query::from(const std::string& sourceName) { return Query(sourceName); }
+
+Query& Query::filter(const ExpressionItem& predicate) {
+    operators.emplace_back(FilterOperator{predicate.getNode()});
+    return *this;
+}
+
+Query& Query::map(const FieldAssignment& assignment) {
+    operators.emplace_back(MapOperator{assignment.getField(), assignment.getValue()});
+    return *this;
+}
+
+Query& Query::projectFields(const std::vector<ExpressionItem>& fields) {
+    ProjectOperator project;
+    for (const auto& field : fields) {
+        if (field.getNode()->kind != ExpressionKind::Field) {
+            throw std::invalid_argument("project() expects Attributes, got " + field.getNode()->toString());
+        }
+        project.fields.push_back(field.getNode()->fieldName);
+    }
+    operators.emplace_back(std::move(project));
+    return *this;
+}
+
+Query& Query::project(const std::vector<ExpressionItem>& fields) { return projectFields(fields); }
+
+WindowedQuery Query::window(WindowTypePtr window) { return WindowedQuery(*this, std::move(window)); }
+
+Query& Query::joinLatestWithin(const Query& right, LatestWithinJoin condition) {
+    if (right.getSink()) {
+        throw std::invalid_argument("The right query of a join on " + right.getSourceName() + " must not have a sink");
+    }
+    if (condition.radiusMeters <= 0.0) {
+        throw std::invalid_argument("A join needs a positive radius");
+    }
+    operators.emplace_back(JoinOperator{std::make_shared<const Query>(right), std::move(condition)});
+    return *this;
+}
+
+Query& Query::sink(SinkDescriptorPtr sink) {
+    sinkDescriptor = std::move(sink);
+    return *this;
+}
+
+const std::string& Query::getSourceName() const { return sourceName; }
+
+const std::vector<LogicalOperator>& Query::getOperators() const { return operators; }
+
+const SinkDescriptorPtr& Query::getSink() const { return sinkDescriptor; }
+
+WindowedQuery::WindowedQuery(Query query, WindowTypePtr window) : query(std::move(query)), window(std::move(window)) {}
+
+Query WindowedQuery::apply(std::vector<WindowAggregationPtr> aggregations) { return applyAggregations(std::move(aggregations)); }
+
+Query WindowedQuery::applyAggregations(std::vector<WindowAggregationPtr> aggregations) {
+    if (aggregations.empty()) {
+        throw std::invalid_argument("A window needs at least one aggregation");
+    }
+    Query result = query;
+    result.operators.emplace_back(WindowOperator{window, std::move(aggregations)});
+    return result;
+}
+
+}// namespace SNCB::Engine
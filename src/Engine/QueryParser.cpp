@@ -0,0 +1,464 @@
+#include <Engine/QueryParser.hpp>
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace SNCB::Engine {
+
+namespace {
+
+enum class TokenKind { Identifier, String, Integer, Decimal, Symbol, End };
+
+struct Token {
+    TokenKind kind;
+    std::string text;
+    size_t offset;
+};
+
+std::vector<Token> tokenize(const std::string& text) {
+    // Longer symbols first, so "::" is not read as two ':'
+    static const std::vector<std::string> symbols = {"::", "->", "||", "&&", "==", "!=", "<=", ">=", "<", ">", "+", "-",
+                                                     "*",  "/",  "!",  "=",  "(",  ")",  ",",  ".",  ";"};
+    std::vector<Token> tokens;
+    size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+        } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            size_t begin = i;
+            while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_')) {
+                ++i;
+            }
+            tokens.push_back({TokenKind::Identifier, text.substr(begin, i - begin), begin});
+        } else if (std::isdigit(static_cast<unsigned char>(c))) {
+            size_t begin = i;
+            bool decimal = false;
+            while (i < text.size() && (std::isdigit(static_cast<unsigned char>(text[i])) || text[i] == '.')) {
+                decimal |= text[i] == '.';
+                ++i;
+            }
+            if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+                decimal = true;
+                ++i;
+                if (i < text.size() && (text[i] == '+' || text[i] == '-')) {
+                    ++i;
+                }
+                while (i < text.size() && std::isdigit(static_cast<unsigned char>(text[i]))) {
+                    ++i;
+                }
+            }
+            tokens.push_back({decimal ? TokenKind::Decimal : TokenKind::Integer, text.substr(begin, i - begin), begin});
+        } else if (c == '"') {
+            size_t begin = i++;
+            std::string value;
+            while (i < text.size() && text[i] != '"') {
+                if (text[i] == '\\' && i + 1 < text.size()) {
+                    ++i;
+                }
+                value.push_back(text[i++]);
+            }
+            if (i >= text.size()) {
+                throw std::invalid_argument("Unterminated string at offset " + std::to_string(begin));
+            }
+            ++i;
+            tokens.push_back({TokenKind::String, std::move(value), begin});
+        } else {
+            bool matched = false;
+            for (const auto& symbol : symbols) {
+                if (text.compare(i, symbol.size(), symbol) == 0) {
+                    tokens.push_back({TokenKind::Symbol, symbol, i});
+                    i += symbol.size();
+                    matched = true;
+                    break;
+                }
+            }
+            if (!matched) {
+                throw std::invalid_argument("Unexpected character '" + std::string(1, c) + "' at offset " + std::to_string(i));
+            }
+        }
+    }
+    tokens.push_back({TokenKind::End, "", text.size()});
+    return tokens;
+}
+
+/** @brief Recursive descent over the tokens, with the operator precedence of C++. */
+class Parser {
+  public:
+    explicit Parser(std::vector<Token> tokens) : tokens(std::move(tokens)) {}
+
+    Query parseQuery() {
+        expectIdentifier("Query");
+        expect("::");
+        expectIdentifier("from");
+        expect("(");
+        auto query = Query::from(expectString());
+        expect(")");
+        while (accept(".")) {
+            auto call = expectIdentifier();
+            expect("(");
+            if (call == "filter") {
+                query.filter(parseExpression());
+            } else if (call == "map") {
+                auto field = parseAttribute();
+                expect("=");
+                query.map(field = parseExpression());
+            } else if (call == "project") {
+                std::vector<ExpressionItem> fields;
+                do {
+                    fields.push_back(parseAttribute());
+                } while (accept(","));
+                query.project(fields);
+            } else if (call == "window") {
+                auto window = parseWindow();
+                expect(")");
+                expect(".");
+                expectIdentifier("apply");
+                expect("(");
+                std::vector<WindowAggregationPtr> aggregations;
+                do {
+                    aggregations.push_back(parseAggregation());
+                } while (accept(","));
+                query = query.window(window).apply(aggregations);
+            } else if (call == "sink") {
+                query.sink(parseSink());
+            } else {
+                fail("unsupported query operator " + call);
+            }
+            expect(")");
+        }
+        accept(";");
+        if (peek().kind != TokenKind::End) {
+            fail("unexpected '" + peek().text + "'");
+        }
+        return query;
+    }
+
+  private:
+    const Token& peek() const { return tokens[position]; }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::invalid_argument("Cannot parse query at offset " + std::to_string(peek().offset) + ": " + message);
+    }
+
+    bool accept(const std::string& symbol) {
+        if (peek().kind == TokenKind::Symbol && peek().text == symbol) {
+            ++position;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(const std::string& symbol) {
+        if (!accept(symbol)) {
+            fail("expected '" + symbol + "'" + (peek().kind == TokenKind::End ? " at the end" : ", got '" + peek().text + "'"));
+        }
+    }
+
+    std::string expectIdentifier(const std::string& name = "") {
+        if (peek().kind != TokenKind::Identifier || (!name.empty() && peek().text != name)) {
+            fail("expected " + (name.empty() ? std::string("a name") : name) + ", got '" + peek().text + "'");
+        }
+        return tokens[position++].text;
+    }
+
+    std::string expectString() {
+        if (peek().kind != TokenKind::String) {
+            fail("expected a string, got '" + peek().text + "'");
+        }
+        return tokens[position++].text;
+    }
+
+    uint64_t expectInteger() {
+        if (peek().kind != TokenKind::Integer) {
+            fail("expected an integer, got '" + peek().text + "'");
+        }
+        return std::strtoull(tokens[position++].text.c_str(), nullptr, 10);
+    }
+
+    /** @brief Attribute("name") or Attribute("name", BasicType::TYPE). */
+    ExpressionItem parseAttribute() {
+        expectIdentifier("Attribute");
+        expect("(");
+        auto name = expectString();
+        std::optional<DataType> type;
+        if (accept(",")) {
+            expectIdentifier("BasicType");
+            expect("::");
+            type = parseDataType(expectIdentifier());
+        }
+        expect(")");
+        return type ? Attribute(name, *type) : Attribute(name);
+    }
+
+    ExpressionItem parseExpression() { return parseOr(); }
+
+    // ExpressionItem's operator= builds a map assignment, so operands are combined as nodes
+    ExpressionItem parseOr() {
+        auto left = parseAnd().getNode();
+        while (accept("||")) {
+            left = (ExpressionItem(left) || parseAnd()).getNode();
+        }
+        return left;
+    }
+
+    ExpressionItem parseAnd() {
+        auto left = parseEquality().getNode();
+        while (accept("&&")) {
+            left = (ExpressionItem(left) && parseEquality()).getNode();
+        }
+        return left;
+    }
+
+    ExpressionItem parseEquality() {
+        auto left = parseRelational().getNode();
+        while (true) {
+            if (accept("==")) {
+                left = (ExpressionItem(left) == parseRelational()).getNode();
+            } else if (accept("!=")) {
+                left = (ExpressionItem(left) != parseRelational()).getNode();
+            } else {
+                return left;
+            }
+        }
+    }
+
+    ExpressionItem parseRelational() {
+        auto left = parseAdditive().getNode();
+        while (true) {
+            if (accept("<=")) {
+                left = (ExpressionItem(left) <= parseAdditive()).getNode();
+            } else if (accept(">=")) {
+                left = (ExpressionItem(left) >= parseAdditive()).getNode();
+            } else if (accept("<")) {
+                left = (ExpressionItem(left) < parseAdditive()).getNode();
+            } else if (accept(">")) {
+                left = (ExpressionItem(left) > parseAdditive()).getNode();
+            } else {
+                return left;
+            }
+        }
+    }
+
+    ExpressionItem parseAdditive() {
+        auto left = parseMultiplicative().getNode();
+        while (true) {
+            if (accept("+")) {
+                left = (ExpressionItem(left) + parseMultiplicative()).getNode();
+            } else if (accept("-")) {
+                left = (ExpressionItem(left) - parseMultiplicative()).getNode();
+            } else {
+                return left;
+            }
+        }
+    }
+
+    ExpressionItem parseMultiplicative() {
+        auto left = parseUnary().getNode();
+        while (true) {
+            if (accept("*")) {
+                left = (ExpressionItem(left) * parseUnary()).getNode();
+            } else if (accept("/")) {
+                left = (ExpressionItem(left) / parseUnary()).getNode();
+            } else {
+                return left;
+            }
+        }
+    }
+
+    ExpressionItem parseUnary() {
+        if (accept("!")) {
+            return !parseUnary();
+        }
+        if (accept("-")) {
+            // The expression tree has no negation, so only literals can be negative
+            if (peek().kind == TokenKind::Integer) {
+                return ExpressionItem(-static_cast<int64_t>(expectInteger()));
+            }
+            if (peek().kind == TokenKind::Decimal) {
+                return ExpressionItem(-std::strtod(tokens[position++].text.c_str(), nullptr));
+            }
+            fail("only number literals can be negated");
+        }
+        return parsePrimary();
+    }
+
+    ExpressionItem parsePrimary() {
+        const auto& token = peek();
+        if (token.kind == TokenKind::Integer) {
+            // Integer literals are UINT64 constants, as the int overloads of the query API make them
+            return ExpressionItem(static_cast<int64_t>(expectInteger()));
+        }
+        if (token.kind == TokenKind::Decimal) {
+            return ExpressionItem(std::strtod(tokens[position++].text.c_str(), nullptr));
+        }
+        if (accept("(")) {
+            auto inner = parseExpression();
+            expect(")");
+            return inner;
+        }
+        if (token.kind != TokenKind::Identifier) {
+            fail("expected an expression, got '" + token.text + "'");
+        }
+        if (token.text == "Attribute") {
+            return parseAttribute();
+        }
+        auto function = expectIdentifier();
+        if (function != "teintersects" && function != "tpointatstbox" && function != "tedwithin") {
+            fail("unsupported function " + function);
+        }
+        expect("(");
+        auto longitude = parseExpression();
+        expect(",");
+        auto latitude = parseExpression();
+        expect(",");
+        auto timestamp = parseExpression();
+        std::optional<double> slack;
+        if (function == "tedwithin" && accept(",")) {
+            auto value = parseExpression();
+            if (value.getNode()->kind != ExpressionKind::Constant) {
+                fail("the slack of tedwithin must be a number");
+            }
+            slack = value.getNode()->constant;
+        }
+        expect(")");
+        if (function == "teintersects") {
+            return teintersects(longitude, latitude, timestamp);
+        }
+        if (function == "tpointatstbox") {
+            return tpointatstbox(longitude, latitude, timestamp);
+        }
+        return slack ? tedwithin(longitude, latitude, timestamp, *slack) : tedwithin(longitude, latitude, timestamp);
+    }
+
+    TimeMeasure parseTimeMeasure() {
+        auto unit = expectIdentifier();
+        expect("(");
+        auto value = expectInteger();
+        expect(")");
+        if (unit == "Milliseconds") {
+            return Milliseconds(value);
+        }
+        if (unit == "Seconds") {
+            return Seconds(value);
+        }
+        if (unit == "Minutes") {
+            return Minutes(value);
+        }
+        fail("unsupported time unit " + unit);
+    }
+
+    TimeCharacteristic parseEventTime() {
+        expectIdentifier("EventTime");
+        expect("(");
+        auto field = parseAttribute();
+        expect(")");
+        return EventTime(field);
+    }
+
+    WindowTypePtr parseWindow() {
+        auto kind = expectIdentifier();
+        expect("::");
+        expectIdentifier("of");
+        expect("(");
+        WindowTypePtr window;
+        if (kind == "TumblingWindow") {
+            auto time = parseEventTime();
+            expect(",");
+            window = TumblingWindow::of(time, parseTimeMeasure());
+        } else if (kind == "SlidingWindow") {
+            auto time = parseEventTime();
+            expect(",");
+            auto size = parseTimeMeasure();
+            expect(",");
+            window = SlidingWindow::of(time, size, parseTimeMeasure());
+        } else if (kind == "ThresholdWindow") {
+            auto predicate = parseExpression();
+            if (!accept(",")) {
+                window = ThresholdWindow::of(predicate);
+            } else {
+                auto minCount = expectInteger();
+                if (accept(",")) {
+                    auto time = parseEventTime();
+                    expect(",");
+                    window = ThresholdWindow::of(predicate, minCount, time, parseTimeMeasure());
+                } else {
+                    window = ThresholdWindow::of(predicate, minCount);
+                }
+            }
+        } else {
+            fail("unsupported window " + kind);
+        }
+        expect(")");
+        return window;
+    }
+
+    WindowAggregationPtr parseAggregation() {
+        auto kind = expectIdentifier();
+        expect("(");
+        WindowAggregationPtr aggregation;
+        if (kind == "Count") {
+            aggregation = Count();
+        } else {
+            auto field = parseAttribute();
+            if (kind == "Min") {
+                aggregation = Min(field);
+            } else if (kind == "Max") {
+                aggregation = Max(field);
+            } else if (kind == "Sum") {
+                aggregation = Sum(field);
+            } else if (kind == "Avg") {
+                aggregation = Avg(field);
+            } else {
+                fail("unsupported aggregation " + kind);
+            }
+        }
+        expect(")");
+        if (accept("->")) {
+            expectIdentifier("as");
+            expect("(");
+            aggregation = aggregation->as(parseAttribute());
+            expect(")");
+        }
+        return aggregation;
+    }
+
+    SinkDescriptorPtr parseSink() {
+        auto kind = expectIdentifier();
+        expect("::");
+        expectIdentifier("create");
+        expect("(");
+        SinkDescriptorPtr sink;
+        if (kind == "FileSinkDescriptor") {
+            auto path = expectString();
+            std::string format = "CSV_FORMAT";
+            std::string mode = "APPEND";
+            if (accept(",")) {
+                format = expectString();
+                if (accept(",")) {
+                    mode = expectString();
+                }
+            }
+            sink = FileSinkDescriptor::create(path, format, mode);
+        } else if (kind == "NullOutputSinkDescriptor" || kind == "PrintSinkDescriptor") {
+            sink = FileSinkDescriptor::create("/dev/null", "CSV_FORMAT", "APPEND");
+        } else {
+            fail("unsupported sink " + kind);
+        }
+        expect(")");
+        return sink;
+    }
+
+    std::vector<Token> tokens;
+    size_t position = 0;
+};
+
+}// namespace
+
+Query parseQuery(const std::string& text) { return Parser(tokenize(text)).parseQuery(); }
+
+}// namespace SNCB::Engine
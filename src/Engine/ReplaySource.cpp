@@ -0,0 +1,170 @@
+#include <Engine/ReplaySource.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace SNCB::Engine {
+
+namespace {
+constexpr double metersPerLatitudeDegree = 111195.0;
+constexpr double degreesToRadians = 3.14159265358979323846 / 180.0;
+}// namespace
+
+ReplaySource::ReplaySource(std::unique_ptr<DataSource> source, SchemaPtr schema, size_t tuplesPerBuffer, ReplayConfig config)
+    : source(std::move(source)), config(std::move(config)), input(schema, tuplesPerBuffer), timeField(schema->findIndex(this->config.timeField)),
+      idField(schema->findIndex("id")), latitudeField(schema->findIndex("latitude")), longitudeField(schema->findIndex("longitude")),
+      random(this->config.seed) {
+    if (this->config.copies == 0 || this->config.copies > tuplesPerBuffer) {
+        throw std::invalid_argument("A replay needs between 1 and " + std::to_string(tuplesPerBuffer) + " copies per tuple");
+    }
+    if (this->config.speedup > 0.0) {
+        if (!timeField || schema->getField(*timeField).type != DataType::UINT64) {
+            throw std::invalid_argument("A replay with speedup needs the UINT64 time field " + this->config.timeField
+                                        + " among the fields the queries read");
+        }
+    } else {
+        timeField.reset();
+    }
+    timer = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (timer < 0) {
+        throw std::runtime_error("Cannot create the replay timer");
+    }
+}
+
+ReplaySource::~ReplaySource() { ::close(timer); }
+
+std::chrono::nanoseconds ReplaySource::deadlineOf(size_t inputRow, uint64_t produced) const {
+    double seconds = 0.0;
+    if (config.eventsPerSecond > 0.0) {
+        seconds = static_cast<double>(produced) / config.eventsPerSecond;
+    }
+    if (timeField) {
+        auto timestamp = input.getUInt(inputRow, *timeField);
+        if (timestamp > *firstTimestamp) {
+            seconds = std::max(seconds, static_cast<double>(timestamp - *firstTimestamp) / (config.timeUnitsPerSecond * config.speedup));
+        }
+    }
+    return std::chrono::nanoseconds(static_cast<int64_t>(seconds * 1e9));
+}
+
+void ReplaySource::waitUntil(std::chrono::steady_clock::time_point deadline) const {
+    // steady_clock is CLOCK_MONOTONIC, the timer's clock
+    auto sleepUntil = deadline - SpinWindow;
+    if (std::chrono::steady_clock::now() < sleepUntil) {
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(sleepUntil.time_since_epoch()).count();
+        itimerspec expiry{};
+        expiry.it_value.tv_sec = static_cast<time_t>(nanoseconds / 1000000000);
+        expiry.it_value.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+        uint64_t expirations = 0;
+        if (::timerfd_settime(timer, TFD_TIMER_ABSTIME, &expiry, nullptr) == 0) {
+            // An interrupted read only shortens the wait, the spin below covers the rest
+            [[maybe_unused]] auto read = ::read(timer, &expirations, sizeof(expirations));
+        }
+    }
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+void ReplaySource::multiply(TupleBuffer& buffer, size_t count) {
+    auto base = buffer.getNumberOfTuples();
+    auto copies = config.copies;
+    buffer.setNumberOfTuples(base + count * copies);
+    for (size_t field = 0; field < input.getSchema()->size(); ++field) {
+        const uint64_t* from = input.getColumn(field) + row;
+        uint64_t* to = buffer.getColumn(field) + base;
+        if (copies == 1) {
+            std::memcpy(to, from, count * sizeof(uint64_t));
+            continue;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            std::fill_n(to + i * copies, copies, from[i]);
+        }
+    }
+    if (copies == 1) {
+        return;
+    }
+
+    bool integerId = idField && input.getSchema()->getField(*idField).type != DataType::FLOAT64;
+    bool jitter = config.gpsJitterMeters > 0.0 && latitudeField && longitudeField;
+    std::uniform_real_distribution<double> offset(-config.gpsJitterMeters, config.gpsJitterMeters);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t copy = 1; copy < copies; ++copy) {
+            auto target = base + i * copies + copy;
+            if (idField) {
+                if (integerId) {
+                    buffer.setUInt(target, *idField, buffer.getUInt(target, *idField) + copy * config.idOffset);
+                } else {
+                    buffer.setFromDouble(target, *idField,
+                                         buffer.getAsDouble(target, *idField) + static_cast<double>(copy * config.idOffset));
+                }
+            }
+            if (jitter) {
+                double latitude = buffer.getAsDouble(target, *latitudeField);
+                double longitude = buffer.getAsDouble(target, *longitudeField);
+                double metersPerLongitudeDegree = metersPerLatitudeDegree * std::max(std::cos(latitude * degreesToRadians), 1e-6);
+                buffer.setFromDouble(target, *latitudeField, latitude + offset(random) / metersPerLatitudeDegree);
+                buffer.setFromDouble(target, *longitudeField, longitude + offset(random) / metersPerLongitudeDegree);
+            }
+        }
+    }
+}
+
+bool ReplaySource::fillBuffer(TupleBuffer& buffer) {
+    if (!start) {
+        start = std::chrono::steady_clock::now();
+    }
+    buffer.clear();
+    std::optional<std::chrono::nanoseconds> first;
+    std::chrono::nanoseconds due{0};
+    bool windowEnded = false;
+    while (!windowEnded) {
+        if (row == input.getNumberOfTuples()) {
+            row = 0;
+            if (!source->fillBuffer(input)) {
+                break;
+            }
+            continue;
+        }
+        if (timeField && !firstTimestamp) {
+            firstTimestamp = input.getUInt(row, *timeField);
+        }
+        // Whole input tuples with all their copies, as far as they fit and are due within the batch window
+        auto room = (buffer.getCapacity() - buffer.getNumberOfTuples()) / config.copies;
+        size_t count = 0;
+        while (count < room && row + count < input.getNumberOfTuples()) {
+            auto deadline = deadlineOf(row + count, producedTuples + buffer.getNumberOfTuples() + count * config.copies);
+            if (!first) {
+                first = deadline;
+            } else if (deadline > *first + BatchWindow) {
+                windowEnded = true;
+                break;
+            }
+            due = std::max(due, deadline);
+            ++count;
+        }
+        multiply(buffer, count);
+        row += count;
+        if (count == room) {
+            break;
+        }
+    }
+    if (buffer.isEmpty()) {
+        return false;
+    }
+    producedTuples += buffer.getNumberOfTuples();
+    if (due.count() > 0) {
+        waitUntil(*start + due);
+    }
+    return true;
+}
+
+uint64_t ReplaySource::getProducedTuples() const { return producedTuples; }
+
+}// namespace SNCB::Engine
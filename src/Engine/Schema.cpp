@@ -0,0 +1,95 @@
+#include <Engine/Schema.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace SNCB::Engine {
+
+DataType parseDataType(const std::string& name) {
+    if (name == "UINT64") {
+        return DataType::UINT64;
+    }
+    if (name == "FLOAT64") {
+        return DataType::FLOAT64;
+    }
+    if (name == "BOOLEAN") {
+        return DataType::BOOLEAN;
+    }
+    throw std::invalid_argument("Unsupported field type '" + name + "', expected UINT64, FLOAT64 or BOOLEAN");
+}
+
+std::string toString(DataType type) {
+    switch (type) {
+        case DataType::UINT64: return "UINT64";
+        case DataType::FLOAT64: return "FLOAT64";
+        case DataType::BOOLEAN: return "BOOLEAN";
+    }
+    return "UNKNOWN";
+}
+
+uint8_t toTypeCode(DataType type) {
+    switch (type) {
+        case DataType::UINT64: return 0;
+        case DataType::FLOAT64: return 1;
+        case DataType::BOOLEAN: return 2;
+    }
+    return 0xFF;
+}
+
+std::optional<DataType> fromTypeCode(uint8_t code) {
+    switch (code) {
+        case 0: return DataType::UINT64;
+        case 1: return DataType::FLOAT64;
+        case 2: return DataType::BOOLEAN;
+        default: return std::nullopt;
+    }
+}
+
+Schema::Schema(std::vector<Field> fields) : fields(std::move(fields)) {}
+
+Schema& Schema::addField(const std::string& name, DataType type) {
+    if (contains(name)) {
+        throw std::invalid_argument("Schema already contains a field " + name);
+    }
+    fields.push_back({name, type});
+    return *this;
+}
+
+size_t Schema::size() const { return fields.size(); }
+
+const Field& Schema::getField(size_t index) const { return fields.at(index); }
+
+const std::vector<Field>& Schema::getFields() const { return fields; }
+
+size_t Schema::getIndex(const std::string& name) const {
+    if (auto index = findIndex(name)) {
+        return *index;
+    }
+    throw std::invalid_argument("Unknown field '" + name + "' in schema " + toString());
+}
+
+std::optional<size_t> Schema::findIndex(const std::string& name) const {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].name == name) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+bool Schema::contains(const std::string& name) const { return findIndex(name).has_value(); }
+
+size_t Schema::getTupleSize() const { return fields.size() * sizeof(uint64_t); }
+
+std::string Schema::toString() const {
+    std::string result;
+    for (const auto& field : fields) {
+        if (!result.empty()) {
+            result += ",";
+        }
+        result += field.name + ":" + Engine::toString(field.type);
+    }
+    return result;
+}
+
+}// namespace SNCB::Engine
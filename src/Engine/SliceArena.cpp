@@ -0,0 +1,52 @@
+#include <Engine/SliceArena.hpp>
+
+#include <algorithm>
+#include <new>
+
+namespace SNCB::Engine {
+
+void* SliceArena::allocate(size_t bytes) {
+    auto& pool = poolOf(bytes);
+    ++statistics.allocations;
+    statistics.peakLiveRecords = std::max(statistics.peakLiveRecords, ++statistics.liveRecords);
+    if (pool.freeList != nullptr) {
+        ++statistics.reuses;
+        auto* record = pool.freeList;
+        pool.freeList = record->next;
+        return record;
+    }
+    if (pool.cursor == pool.end) {
+        // Records larger than a slab get a slab of their own
+        auto slabBytes = std::max(SlabBytes / pool.recordSize, size_t{1}) * pool.recordSize;
+        slabs.push_back(std::make_unique_for_overwrite<std::byte[]>(slabBytes));
+        ++statistics.slabs;
+        statistics.reservedBytes += slabBytes;
+        pool.cursor = slabs.back().get();
+        pool.end = pool.cursor + slabBytes;
+    }
+    auto* record = pool.cursor;
+    pool.cursor += pool.recordSize;
+    return record;
+}
+
+void SliceArena::release(void* record, size_t bytes) {
+    auto& pool = poolOf(bytes);
+    --statistics.liveRecords;
+    pool.freeList = new (record) FreeRecord{pool.freeList};
+}
+
+const ArenaStatistics& SliceArena::getStatistics() const { return statistics; }
+
+SliceArena::Pool& SliceArena::poolOf(size_t bytes) {
+    // Records keep the alignment of operator new and can hold the link of the free list
+    constexpr size_t alignment = alignof(std::max_align_t);
+    auto recordSize = (std::max(bytes, sizeof(FreeRecord)) + alignment - 1) / alignment * alignment;
+    for (auto& pool : pools) {
+        if (pool.recordSize == recordSize) {
+            return pool;
+        }
+    }
+    return pools.emplace_back(Pool{recordSize});
+}
+
+}// namespace SNCB::Engine
@@ -0,0 +1,85 @@
+#include <Engine/SlidingAggregator.hpp>
+
+#include <algorithm>
+
+namespace SNCB::Engine {
+
+TwoStacksAggregator::TwoStacksAggregator(const std::vector<AggregationFunction>& functions, SliceArena* arena)
+    : functions(functions), arena(arena), entries(ArenaAllocator<Entry>(arena)), back(identity()) {}
+
+Partial TwoStacksAggregator::identity() const {
+    Partial partial{0, 0, decltype(Partial::values)(ArenaAllocator<AggregateValue>(arena))};
+    partial.values.reserve(functions.size());
+    for (const auto& function : functions) {
+        partial.values.push_back(function.initial());
+    }
+    return partial;
+}
+
+void TwoStacksAggregator::combine(Partial& state, const Partial& other) const {
+    state.tuples += other.tuples;
+    state.ingestionTime = std::max(state.ingestionTime, other.ingestionTime);
+    for (size_t i = 0; i < functions.size(); ++i) {
+        functions[i].combine(state.values[i], other.values[i]);
+    }
+}
+
+void TwoStacksAggregator::push(uint64_t start, const Partial& slice) {
+    combine(back, slice);
+    entries.push_back({start, slice, {}});
+}
+
+void TwoStacksAggregator::evictBefore(uint64_t start) {
+    while (!entries.empty() && entries.front().start < start) {
+        if (stale) {
+            // The next query flips anyway, so the stacks need no update until then
+            entries.pop_front();
+            continue;
+        }
+        if (split == 0) {
+            flip();
+        }
+        entries.pop_front();
+        --split;
+    }
+}
+
+Partial& TwoStacksAggregator::findOrInsert(uint64_t start) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), start, [](const Entry& entry, uint64_t value) {
+        return entry.start < value;
+    });
+    if (it == entries.end() || it->start != start) {
+        it = entries.insert(it, {start, identity(), {}});
+    }
+    stale = true;
+    return it->slice;
+}
+
+void TwoStacksAggregator::flip() {
+    Partial suffix = identity();
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        combine(suffix, it->slice);
+        it->suffix = suffix;
+    }
+    split = entries.size();
+    back = identity();
+    stale = false;
+}
+
+void TwoStacksAggregator::query(Partial& result) {
+    if (stale) {
+        flip();
+    }
+    if (split == 0) {
+        result = back;
+        return;
+    }
+    result = entries.front().suffix;
+    combine(result, back);
+}
+
+bool TwoStacksAggregator::isEmpty() const { return entries.empty(); }
+
+uint64_t TwoStacksAggregator::getLastStart() const { return entries.back().start; }
+
+}// namespace SNCB::Engine
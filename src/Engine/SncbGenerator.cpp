@@ -0,0 +1,290 @@
+#include <Engine/SncbGenerator.hpp>
+
+#include <Util/YamlLite.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace SNCB::Engine {
+
+namespace {
+constexpr double pi = 3.14159265358979323846;
+constexpr double degreesToRadians = pi / 180.0;
+constexpr double metersPerLatitudeDegree = 111195.0;
+// Acceleration and braking of a passenger train in m/s^2
+constexpr double acceleration = 0.6;
+constexpr double deceleration = 0.9;
+// Mean cruise time before a train changes its speed, dwell time range at a stop, brake response time
+constexpr double meanCruiseSeconds = 300.0;
+constexpr double minDwellSeconds = 30.0;
+constexpr double maxDwellSeconds = 120.0;
+constexpr double brakeSeconds = 2.0;
+// Rows a thread generates at least, below that a buffer is generated on the calling thread
+constexpr uint64_t minRowsPerThread = 16384;
+
+// SplitMix64: eight bytes of state per train and good enough statistics for synthetic data
+uint64_t nextRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+double uniform(uint64_t& state) { return static_cast<double>(nextRandom(state) >> 11) * 0x1.0p-53; }
+
+// Approximately standard normal, the sum of four uniforms scaled to unit variance
+double noise(uint64_t& state) { return (uniform(state) + uniform(state) + uniform(state) + uniform(state) - 2.0) * 1.7320508075688772; }
+
+double roundTo(double value, double scale) { return std::round(value * scale) / scale; }
+
+void validate(const SncbGeneratorConfig& config) {
+    if (config.minSpeed < 0.0 || config.minSpeed > config.maxSpeed || config.minLongitude >= config.maxLongitude
+        || config.minLatitude >= config.maxLatitude || config.minLatitude < -89.0 || config.maxLatitude > 89.0) {
+        throw std::invalid_argument("SNCB generator bounds are empty or out of range");
+    }
+    if (config.sampleInterval == 0 || config.timeUnitsPerSecond <= 0.0) {
+        throw std::invalid_argument("SNCB generator needs a positive sample interval");
+    }
+}
+}// namespace
+
+SchemaPtr SncbGenerator::getSchema() {
+    // In the order of Field
+    static const auto schema = std::make_shared<const Schema>(Schema()
+                                                                  .addField("timestamp", DataType::UINT64)
+                                                                  .addField("id", DataType::UINT64)
+                                                                  .addField("Vbat", DataType::FLOAT64)
+                                                                  .addField("PCFA_bar", DataType::FLOAT64)
+                                                                  .addField("PCFF_bar", DataType::FLOAT64)
+                                                                  .addField("PCF1_bar", DataType::FLOAT64)
+                                                                  .addField("PCF2_bar", DataType::FLOAT64)
+                                                                  .addField("T1_bar", DataType::FLOAT64)
+                                                                  .addField("T2_bar", DataType::FLOAT64)
+                                                                  .addField("Code1", DataType::UINT64)
+                                                                  .addField("Code2", DataType::UINT64)
+                                                                  .addField("speed", DataType::FLOAT64)
+                                                                  .addField("latitude", DataType::FLOAT64)
+                                                                  .addField("longitude", DataType::FLOAT64));
+    return schema;
+}
+
+SncbGeneratorConfig SncbGenerator::readE2EConfig(const std::string& path, const std::string& sourceName) {
+    auto root = Util::YamlNode::parseFile(path);
+    for (const auto& source : root["logicalSources"].items()) {
+        if (source["name"].asString() != sourceName) {
+            continue;
+        }
+        if (source["type"].asString() != "SNCB") {
+            throw std::invalid_argument("Logical source " + sourceName + " of " + path + " is not of type SNCB");
+        }
+        SncbGeneratorConfig config;
+        config.minSpeed = source["minSpeed"].asDouble(config.minSpeed);
+        config.maxSpeed = source["maxSpeed"].asDouble(config.maxSpeed);
+        config.minLongitude = source["minLongitude"].asDouble(config.minLongitude);
+        config.maxLongitude = source["maxLongitude"].asDouble(config.maxLongitude);
+        config.minLatitude = source["minLatitude"].asDouble(config.minLatitude);
+        config.maxLatitude = source["maxLatitude"].asDouble(config.maxLatitude);
+        validate(config);
+        return config;
+    }
+    throw std::invalid_argument("No logical source " + sourceName + " in " + path);
+}
+
+SncbGenerator::SncbGenerator(SncbGeneratorConfig config, SchemaPtr schema)
+    : config(std::move(config)), sampleSeconds(static_cast<double>(this->config.sampleInterval) / this->config.timeUnitsPerSecond),
+      threads(this->config.threads > 0 ? this->config.threads : std::max(1U, std::thread::hardware_concurrency())),
+      totalTuples(this->config.trains * this->config.samplesPerTrain) {
+    validate(this->config);
+    if (this->config.trains == 0) {
+        throw std::invalid_argument("SNCB generator needs at least one train");
+    }
+
+    slots.fill(FieldCount);
+    auto produced = getSchema();
+    for (size_t slot = 0; slot < schema->size(); ++slot) {
+        const auto& field = schema->getField(slot);
+        auto index = produced->findIndex(field.name);
+        if (!index) {
+            throw std::invalid_argument("SNCB generator cannot produce field " + field.name);
+        }
+        if (field.type != produced->getField(*index).type) {
+            throw std::invalid_argument("SNCB generator produces " + field.name + " as " + toString(produced->getField(*index).type));
+        }
+        slots[*index] = slot;
+    }
+
+    const auto& c = this->config;
+    trains.resize(c.trains);
+    for (size_t index = 0; index < trains.size(); ++index) {
+        auto& train = trains[index];
+        uint64_t seed = c.seed * 0x9E3779B97F4A7C15ULL + index;
+        train.random = nextRandom(seed);
+        train.latitude = c.minLatitude + uniform(train.random) * (c.maxLatitude - c.minLatitude);
+        train.longitude = c.minLongitude + uniform(train.random) * (c.maxLongitude - c.minLongitude);
+        train.heading = 2.0 * pi * uniform(train.random);
+        train.speed = c.minSpeed + uniform(train.random) * (c.maxSpeed - c.minSpeed);
+        train.targetSpeed = train.speed;
+        if (uniform(train.random) < 0.2) {
+            train.speed = c.minSpeed;
+            train.targetSpeed = c.minSpeed;
+            train.brake = 1.0;
+            train.dwellSamples = 1 + static_cast<uint64_t>(uniform(train.random) * maxDwellSeconds / sampleSeconds);
+        }
+    }
+}
+
+bool SncbGenerator::fillBuffer(TupleBuffer& buffer) {
+    auto count = std::min<uint64_t>(buffer.getCapacity(), totalTuples - producedTuples);
+    if (count == 0) {
+        buffer.clear();
+        return false;
+    }
+    buffer.setNumberOfTuples(count);
+    std::array<uint64_t*, FieldCount> columns{};
+    for (size_t field = 0; field < FieldCount; ++field) {
+        columns[field] = slots[field] < FieldCount ? buffer.getColumn(slots[field]) : nullptr;
+    }
+
+    // Threads own disjoint ranges of trains, each advancing its trains through all rows of the buffer
+    auto workers = std::max<uint64_t>(1, std::min<uint64_t>({threads, trains.size(), count / minRowsPerThread}));
+    auto begin = producedTuples;
+    auto end = producedTuples + count;
+    std::vector<std::thread> helpers;
+    for (uint64_t worker = 1; worker < workers; ++worker) {
+        helpers.emplace_back([this, worker, workers, begin, end, &columns] {
+            generate(trains.size() * worker / workers, trains.size() * (worker + 1) / workers, begin, end, columns);
+        });
+    }
+    generate(0, trains.size() / workers, begin, end, columns);
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+    producedTuples = end;
+    return true;
+}
+
+uint64_t SncbGenerator::getProducedTuples() const { return producedTuples; }
+
+uint64_t SncbGenerator::getTotalTuples() const { return totalTuples; }
+
+void SncbGenerator::generate(size_t firstTrain, size_t lastTrain, uint64_t begin, uint64_t end,
+                             const std::array<uint64_t*, FieldCount>& columns) {
+    uint64_t numberOfTrains = trains.size();
+    for (uint64_t step = begin / numberOfTrains; step * numberOfTrains < end; ++step) {
+        for (size_t index = firstTrain; index < lastTrain; ++index) {
+            uint64_t row = step * numberOfTrains + index;
+            if (row >= end) {
+                break;
+            }
+            if (row >= begin) {
+                advance(trains[index], index, step, columns.data(), row - begin);
+            }
+        }
+    }
+}
+
+void SncbGenerator::advance(Train& train, uint64_t index, uint64_t step, uint64_t* const* columns, size_t row) {
+    const auto& c = config;
+    auto& random = train.random;
+
+    // Speed profile: dwell at a stop, accelerate or brake towards the target, cruise until a new target
+    double targetBrake = 0.0;
+    double speedStep = 3.6 * sampleSeconds;
+    if (train.dwellSamples > 0) {
+        targetBrake = 1.0;
+        if (--train.dwellSamples == 0) {
+            train.targetSpeed = c.minSpeed + (c.maxSpeed - c.minSpeed) * (0.5 + 0.5 * uniform(random));
+        }
+    } else if (train.speed < train.targetSpeed) {
+        train.speed = std::min(train.targetSpeed, train.speed + acceleration * speedStep);
+    } else if (train.speed > train.targetSpeed) {
+        train.speed = std::max(train.targetSpeed, train.speed - deceleration * speedStep);
+        targetBrake = 0.6;
+    } else if (train.stopping) {
+        train.stopping = false;
+        auto dwellSeconds = minDwellSeconds + (maxDwellSeconds - minDwellSeconds) * uniform(random);
+        train.dwellSamples = 1 + static_cast<uint64_t>(dwellSeconds / sampleSeconds);
+    } else if (uniform(random) < sampleSeconds / meanCruiseSeconds) {
+        train.stopping = uniform(random) < 0.4;
+        train.targetSpeed = train.stopping ? c.minSpeed : c.minSpeed + (c.maxSpeed - c.minSpeed) * (0.5 + 0.5 * uniform(random));
+    }
+    train.brake += (targetBrake - train.brake) * std::min(1.0, sampleSeconds / brakeSeconds);
+
+    // Path: move along the heading, which bends slowly with the distance, and reflect at the box
+    double meters = train.speed / 3.6 * sampleSeconds;
+    train.heading += noise(random) * 0.0005 * meters;
+    train.latitude += meters * std::cos(train.heading) / metersPerLatitudeDegree;
+    train.longitude += meters * std::sin(train.heading) / (metersPerLatitudeDegree * std::cos(train.latitude * degreesToRadians));
+    if (train.latitude < c.minLatitude || train.latitude > c.maxLatitude) {
+        train.latitude = std::clamp(2.0 * std::clamp(train.latitude, c.minLatitude, c.maxLatitude) - train.latitude, c.minLatitude, c.maxLatitude);
+        train.heading = pi - train.heading;
+    }
+    if (train.longitude < c.minLongitude || train.longitude > c.maxLongitude) {
+        train.longitude = std::clamp(2.0 * std::clamp(train.longitude, c.minLongitude, c.maxLongitude) - train.longitude, c.minLongitude,
+                                     c.maxLongitude);
+        train.heading = -train.heading;
+    }
+
+    // Pressures: PCFA follows the brake, PCFF drops with it, a CFA spike moves PCFA alone
+    if (train.spikeSamples == 0 && uniform(random) < c.cfaSpikeProbability) {
+        train.spikeSamples = 2 + nextRandom(random) % 9;
+        train.spikeBar = 0.6 + 1.9 * uniform(random);
+    }
+    double spike = 0.0;
+    if (train.spikeSamples > 0) {
+        spike = train.spikeBar;
+        --train.spikeSamples;
+    }
+    double pcfa = std::max(0.0, 3.8 * train.brake + 0.02 * noise(random) + spike);
+    double pcff = 5.0 - 1.5 * train.brake + 0.01 * noise(random);
+    for (auto& drift : train.drift) {
+        drift = 0.98 * drift + 0.028 * noise(random);
+    }
+    double vbat = 24.1 + 0.05 * noise(random);
+    double speed = train.speed > c.minSpeed ? std::clamp(train.speed + 0.3 * noise(random), c.minSpeed, c.maxSpeed) : train.speed;
+
+    // Alarms: bursts of one code in Code1 or Code2
+    if (train.alarmSamples == 0) {
+        train.code1 = 0;
+        train.code2 = 0;
+        if (uniform(random) < c.alarmProbability) {
+            train.alarmSamples = 3 + nextRandom(random) % 18;
+            auto code = 1 + nextRandom(random) % 4;
+            (nextRandom(random) % 2 == 0 ? train.code1 : train.code2) = code;
+        }
+    }
+    if (train.alarmSamples > 0) {
+        --train.alarmSamples;
+    }
+
+    auto setUInt = [&](Field field, uint64_t value) {
+        if (columns[field] != nullptr) {
+            columns[field][row] = value;
+        }
+    };
+    auto setDouble = [&](Field field, double value) {
+        if (columns[field] != nullptr) {
+            columns[field][row] = std::bit_cast<uint64_t>(value);
+        }
+    };
+    setUInt(Timestamp, c.startTimestamp + step * c.sampleInterval);
+    setUInt(Id, c.firstId + index);
+    setDouble(Vbat, roundTo(vbat, 10.0));
+    setDouble(PCFA, roundTo(pcfa, 100.0));
+    setDouble(PCFF, roundTo(pcff, 100.0));
+    setDouble(PCF1, roundTo(3.0 + 0.3 * train.brake + train.drift[0], 100.0));
+    setDouble(PCF2, roundTo(3.0 + 0.3 * train.brake + train.drift[1], 100.0));
+    setDouble(T1, roundTo(2.9 + train.drift[2], 100.0));
+    setDouble(T2, roundTo(2.9 + train.drift[3], 100.0));
+    setUInt(Code1, train.code1);
+    setUInt(Code2, train.code2);
+    setDouble(Speed, roundTo(speed, 10.0));
+    setDouble(Latitude, roundTo(train.latitude, 1e5));
+    setDouble(Longitude, roundTo(train.longitude, 1e5));
+}
+
+}// namespace SNCB::Engine
@@ -0,0 +1,210 @@
+#include <Engine/SncbQueries.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace SNCB::Engine {
+
+namespace {
+
+// Min and max of PCFA and PCFF over 10 s windows sliding by the given step, reported when the
+// PCFA pressure varies while the PCFF pressure stays stable (Query6 and the same-window clients)
+Query pressureVariation(const std::string& source, TimeMeasure slide, const std::string& sinkPath) {
+    return Query::from(source)
+        .window(SlidingWindow::of(EventTime(Attribute("timestamp", BasicType::UINT64)), Seconds(10), slide))
+        .apply(Min(Attribute("PCFA_bar"))->as(Attribute("PCFA_min_value")),
+               Max(Attribute("PCFA_bar"))->as(Attribute("PCFA_max_value")),
+               Min(Attribute("PCFF_bar"))->as(Attribute("PCFF_min_value")),
+               Max(Attribute("PCFF_bar"))->as(Attribute("PCFF_max_value")))
+        .map(Attribute("wStart") = Attribute("start"))
+        .map(Attribute("wEnd") = Attribute("end"))
+        .map(Attribute("variationPCFA") = Attribute("PCFA_max_value") - Attribute("PCFA_min_value"))
+        .map(Attribute("variationPCFF") = Attribute("PCFF_max_value") - Attribute("PCFF_min_value"))
+        .filter(Attribute("variationPCFA") > 0.4 && Attribute("variationPCFF") <= 0.1)
+        .project(Attribute("wStart"), Attribute("wEnd"), Attribute("variationPCFA"), Attribute("variationPCFF"))
+        .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+}
+
+Query pcffVariation(const std::string& sinkPath) {
+    return Query::from("nrok5")
+        .window(SlidingWindow::of(EventTime(Attribute("timestamp", BasicType::UINT64)), Seconds(10), Seconds(1)))
+        .apply(Min(Attribute("PCFF_bar"))->as(Attribute("PCFF_min_value_f")),
+               Max(Attribute("PCFF_bar"))->as(Attribute("PCFF_max_value_f")))
+        .map(Attribute("variationPCFF_f") = Attribute("PCFF_max_value_f") - Attribute("PCFF_min_value_f"))
+        .filter(Attribute("variationPCFF_f") < 0.1)
+        .project(Attribute("start"),
+                 Attribute("end"),
+                 Attribute("PCFF_min_value_f"),
+                 Attribute("PCFF_max_value_f"),
+                 Attribute("variationPCFF_f"))
+        .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+}
+
+std::vector<LocalQueryDefinition> buildQueries() {
+    std::vector<LocalQueryDefinition> queries;
+
+    queries.push_back({"QueryTest", "QueryTest", "query_output.csv", [](const std::string& sinkPath) {
+                           return Query::from("sncb")
+                               .filter(Attribute("speed") > 100)
+                               .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+                       }});
+
+    queries.push_back({"Query1", "query1", "query1.csv", [](const std::string& sinkPath) {
+                           return Query::from("sncb")
+                               .filter((Attribute("Code1") != 0 || Attribute("Code2") != 0))
+                               .window(ThresholdWindow::of(teintersects(Attribute("longitude", BasicType::FLOAT64),
+                                                                        Attribute("latitude", BasicType::FLOAT64),
+                                                                        Attribute("timestamp", BasicType::UINT64))
+                                                           == 1))
+                               .apply(Sum(Attribute("speed", BasicType::UINT64)))
+                               .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+                       }});
+
+    queries.push_back({"Query2", "query2", "query2.csv", [](const std::string& sinkPath) {
+                           return Query::from("sncb")
+                               .filter(Attribute("speed") > 0 && Attribute("PCFA_bar") > 0
+                                       && Attribute("speed") * 0.5 + Attribute("PCFA_bar") * 0.5 > 2)
+                               .filter(tpointatstbox(Attribute("longitude", BasicType::FLOAT64),
+                                                     Attribute("latitude", BasicType::FLOAT64),
+                                                     Attribute("timestamp", BasicType::UINT64))
+                                       == 1)
+                               .window(TumblingWindow::of(EventTime(Attribute("timestamp")), Milliseconds(500)))
+                               .apply(Avg(Attribute("speed")))
+                               .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+                       }});
+
+    queries.push_back({"Query3", "query3", "query3.csv", [](const std::string& sinkPath) {
+                           return Query::from("sncb")
+                               .filter(tedwithin(Attribute("longitude", BasicType::FLOAT64),
+                                                 Attribute("latitude", BasicType::FLOAT64),
+                                                 Attribute("timestamp", BasicType::UINT64))
+                                           == 0
+                                       && Attribute("timestamp", BasicType::UINT64) > 0)
+                               .window(TumblingWindow::of(EventTime(Attribute("timestamp")), Seconds(10)))
+                               .apply(Avg(Attribute("speed")))
+                               .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+                       }});
+
+    // The client writes both streams to separate sinks for an offline join; here they are joined while
+    // streaming, every train position with the latest hourly weather reading within 10 km
+    queries.push_back({"Query4", "query4", "query4.csv", [](const std::string& sinkPath) {
+                           auto weather = Query::from("weather")
+                                              .map(Attribute("w_temperature") = Attribute("temperature"))
+                                              .map(Attribute("w_timestamp") = Attribute("timestamp"))
+                                              .map(Attribute("w_gps_lat") = Attribute("gps_lat"))
+                                              .map(Attribute("w_gps_lon") = Attribute("gps_lon"))
+                                              .project(Attribute("w_temperature"), Attribute("w_timestamp"),
+                                                       Attribute("w_gps_lat"), Attribute("w_gps_lon"));
+                           return Query::from("sncb")
+                               .map(Attribute("t_timestamp") = Attribute("timestamp"))
+                               .map(Attribute("t_lat") = Attribute("latitude"))
+                               .map(Attribute("t_lon") = Attribute("longitude"))
+                               .map(Attribute("t_speed") = Attribute("speed"))
+                               .project(Attribute("t_timestamp"), Attribute("t_lat"), Attribute("t_lon"), Attribute("t_speed"))
+                               // Both timestamps are in seconds
+                               .joinLatestWithin(weather,
+                                                 {.leftTime = "t_timestamp",
+                                                  .leftLongitude = "t_lon",
+                                                  .leftLatitude = "t_lat",
+                                                  .rightTime = "w_timestamp",
+                                                  .rightLongitude = "w_gps_lon",
+                                                  .rightLatitude = "w_gps_lat",
+                                                  .radiusMeters = 10000.0,
+                                                  .maxAge = 3600})
+                               .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+                       }});
+
+    queries.push_back({"Query5", "query5", "query5.csv", [](const std::string& sinkPath) {
+                           return Query::from("sncb")
+                               .map(Attribute("passenger_count") =
+                                        (Attribute("T1_bar") + Attribute("T2_bar") + Attribute("PCF1_bar") + Attribute("PCF2_bar"))
+                                        / 4.0)
+                               .filter(Attribute("passenger_count") > 3.15)
+                               .filter(tpointatstbox(Attribute("longitude", BasicType::FLOAT64),
+                                                     Attribute("latitude", BasicType::FLOAT64),
+                                                     Attribute("timestamp", BasicType::UINT64))
+                                           == 1
+                                       && Attribute("speed") > -1)
+                               .map(Attribute("adjusted_temp") = 20.0)
+                               .map(Attribute("adjusted_light") = 80.0)
+                               .window(TumblingWindow::of(EventTime(Attribute("timestamp")), Milliseconds(500)))
+                               .apply(Avg(Attribute("speed")))
+                               .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+                       }});
+
+    queries.push_back({"Query6", "query6", "query6.csv", [](const std::string& sinkPath) {
+                           return pressureVariation("nrok5", Milliseconds(10), sinkPath);
+                       }});
+
+    queries.push_back({"QueryCFA", "queryCFA", "outputFileCFA_nrok5.csv", [](const std::string& sinkPath) {
+                           return Query::from("nrok5")
+                               .window(SlidingWindow::of(EventTime(Attribute("timestamp", BasicType::UINT64)), Seconds(10), Seconds(1)))
+                               .apply(Min(Attribute("PCFA_bar"))->as(Attribute("PCFA_min_value")),
+                                      Max(Attribute("PCFA_bar"))->as(Attribute("PCFA_max_value")))
+                               .map(Attribute("wStart") = Attribute("start"))
+                               .map(Attribute("wEnd") = Attribute("end"))
+                               .map(Attribute("variationPCFA") = Attribute("PCFA_max_value") - Attribute("PCFA_min_value"))
+                               .filter(Attribute("variationPCFA") > 0.4)
+                               .project(Attribute("wStart"),
+                                        Attribute("wEnd"),
+                                        Attribute("PCFA_min_value"),
+                                        Attribute("PCFA_max_value"),
+                                        Attribute("variationPCFA"))
+                               .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+                       }});
+
+    queries.push_back({"QueryCFF", "queryCFF", "outputFileCFF_nrok5.csv", pcffVariation});
+
+    queries.push_back({"QueryCFAandCFF", "CFA", "outputCFA.csv", [](const std::string& sinkPath) {
+                           return Query::from("nrok5")
+                               .window(SlidingWindow::of(EventTime(Attribute("timestamp", BasicType::UINT64)), Seconds(10), Seconds(1)))
+                               .apply(Min(Attribute("PCFA_bar"))->as(Attribute("min_pcfa_bar")),
+                                      Max(Attribute("PCFA_bar"))->as(Attribute("max_pcfa_bar")))
+                               .map(Attribute("window_end_ts") = Attribute("end"))
+                               .map(Attribute("variation") = Attribute("max_pcfa_bar") - Attribute("min_pcfa_bar"))
+                               .filter(Attribute("variation") > 0.4)
+                               .project(Attribute("window_end_ts"),
+                                        Attribute("min_pcfa_bar"),
+                                        Attribute("max_pcfa_bar"),
+                                        Attribute("variation"))
+                               .sink(FileSinkDescriptor::create(sinkPath, "CSV_FORMAT", "APPEND"));
+                       }});
+
+    queries.push_back({"QueryCFAandCFF", "CFF", "outputCFF.csv", pcffVariation});
+
+    queries.push_back({"Querytrysamewindow", "querytrysamewindow", "outputWholeday-10s-10ms_nrok5.csv",
+                       [](const std::string& sinkPath) { return pressureVariation("nrok5", Milliseconds(10), sinkPath); }});
+
+    queries.push_back({"querytrysamewindowOneday", "querytrysamewindowOneday", "outputsamewindows_7s_10ms_equal.csv",
+                       [](const std::string& sinkPath) { return pressureVariation("nrok5Oneday", Milliseconds(10), sinkPath); }});
+    return queries;
+}
+
+std::string lowercase(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+    return value;
+}
+
+}// namespace
+
+const std::vector<LocalQueryDefinition>& getSncbQueries() {
+    static const std::vector<LocalQueryDefinition> queries = buildQueries();
+    return queries;
+}
+
+std::vector<LocalQueryDefinition> findSncbQueries(const std::string& selector) {
+    auto wanted = lowercase(selector);
+    std::vector<LocalQueryDefinition> matches;
+    for (const auto& query : getSncbQueries()) {
+        if (wanted == "all" || lowercase(query.client) == wanted || lowercase(query.name) == wanted) {
+            matches.push_back(query);
+        }
+    }
+    if (matches.empty()) {
+        throw std::invalid_argument("No SNCB query named " + selector);
+    }
+    return matches;
+}
+
+}// namespace SNCB::Engine
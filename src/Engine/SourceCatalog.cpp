@@ -0,0 +1,111 @@
+#include <Engine/SourceCatalog.hpp>
+
+#include <Util/YamlLite.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+namespace SNCB::Engine {
+
+namespace {
+std::string resolveDataFile(const std::string& configuredPath, const std::string& dataDirectory) {
+    namespace fs = std::filesystem;
+    if (fs::exists(configuredPath) || dataDirectory.empty()) {
+        return configuredPath;
+    }
+    auto local = fs::path(dataDirectory) / fs::path(configuredPath).filename();
+    return fs::exists(local) ? local.string() : configuredPath;
+}
+}// namespace
+
+SourceCatalog SourceCatalog::fromYaml(const std::string& coordinatorConfig, const std::string& workerConfig,
+                                      const std::string& dataDirectory) {
+    SourceCatalog catalog;
+    auto coordinator = Util::YamlNode::parseFile(coordinatorConfig);
+    for (const auto& source : coordinator["logicalSources"].items()) {
+        Schema schema;
+        for (const auto& field : source["fields"].items()) {
+            schema.addField(field["name"].asString(), parseDataType(field["type"].asString()));
+        }
+        catalog.addLogicalSource(source["logicalSourceName"].asString(), std::move(schema));
+    }
+
+    auto worker = Util::YamlNode::parseFile(workerConfig);
+    for (const auto& source : worker["physicalSources"].items()) {
+        if (source["type"].asString() != "CSV_SOURCE") {
+            continue;
+        }
+        const auto& configuration = source["configuration"];
+        PhysicalSourceConfig config;
+        config.logicalSourceName = source["logicalSourceName"].asString();
+        config.physicalSourceName = source["physicalSourceName"].asString();
+        config.filePath = resolveDataFile(configuration["filePath"].asString(), dataDirectory);
+        config.skipHeader = configuration["skipHeader"].asBool(true);
+        config.delimiter = configuration["delimiter"].asString(",").front();
+        config.tuplesPerBuffer = configuration["numberOfTuplesToProducePerBuffer"].asUInt(0);
+        config.gatheringIntervalMs = configuration["gatheringInterval"].asUInt(0);
+        catalog.addPhysicalSource(std::move(config));
+    }
+    return catalog;
+}
+
+void SourceCatalog::addLogicalSource(const std::string& name, Schema schema) {
+    schemas[name] = std::make_shared<const Schema>(std::move(schema));
+}
+
+void SourceCatalog::addPhysicalSource(PhysicalSourceConfig config) {
+    auto name = config.logicalSourceName;
+    physicalSources[name] = std::move(config);
+}
+
+SchemaPtr SourceCatalog::getSchema(const std::string& logicalSourceName) const {
+    auto it = schemas.find(logicalSourceName);
+    if (it == schemas.end()) {
+        throw std::invalid_argument("Unknown logical source " + logicalSourceName);
+    }
+    return it->second;
+}
+
+const PhysicalSourceConfig& SourceCatalog::getPhysicalSource(const std::string& logicalSourceName) const {
+    auto it = physicalSources.find(logicalSourceName);
+    if (it == physicalSources.end()) {
+        throw std::invalid_argument("No physical source for logical source " + logicalSourceName);
+    }
+    return it->second;
+}
+
+void SourceCatalog::setColumnarFile(const std::string& logicalSourceName, const std::string& path) {
+    getPhysicalSource(logicalSourceName);
+    physicalSources[logicalSourceName].columnarFilePath = path;
+}
+
+void SourceCatalog::setReplay(const std::string& logicalSourceName, const ReplayConfig& replay) {
+    getPhysicalSource(logicalSourceName);
+    physicalSources[logicalSourceName].replay = replay;
+}
+
+void SourceCatalog::setGenerator(const std::string& logicalSourceName, const SncbGeneratorConfig& generator) {
+    getPhysicalSource(logicalSourceName);
+    physicalSources[logicalSourceName].generator = generator;
+}
+
+std::vector<std::string> SourceCatalog::getLogicalSourceNames() const {
+    std::vector<std::string> names;
+    for (const auto& [name, schema] : schemas) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+void SourceCatalog::setBufferSizeInBytes(size_t bytes) { bufferSizeInBytes = bytes; }
+
+size_t SourceCatalog::getTuplesPerBuffer(const std::string& logicalSourceName) const {
+    const auto& config = getPhysicalSource(logicalSourceName);
+    if (config.tuplesPerBuffer > 0) {
+        return config.tuplesPerBuffer;
+    }
+    return std::max<size_t>(1, bufferSizeInBytes / getSchema(logicalSourceName)->getTupleSize());
+}
+
+}// namespace SNCB::Engine
@@ -0,0 +1,100 @@
+#include <Engine/TupleBuffer.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace SNCB::Engine {
+
+TupleBuffer::TupleBuffer(SchemaPtr schema, size_t capacity)
+    : schema(std::move(schema)), width(this->schema->size()), capacity(capacity), slots(width * capacity) {
+    for (const auto& field : this->schema->getFields()) {
+        types.push_back(field.type);
+    }
+    for (size_t field = 0; field < width; ++field) {
+        columns.push_back(slots.data() + field * capacity);
+    }
+}
+
+TupleBuffer::TupleBuffer(SchemaPtr schema, std::vector<uint64_t*> columns, size_t numberOfTuples)
+    : schema(std::move(schema)), width(this->schema->size()), capacity(numberOfTuples), numberOfTuples(numberOfTuples),
+      columns(std::move(columns)) {
+    if (this->columns.size() != width) {
+        throw std::invalid_argument("TupleBuffer needs one column per field, got " + std::to_string(this->columns.size()));
+    }
+    for (const auto& field : this->schema->getFields()) {
+        types.push_back(field.type);
+    }
+}
+
+TupleBuffer::TupleBuffer(const TupleBuffer& other)
+    : schema(other.schema), types(other.types), width(other.width), capacity(other.capacity),
+      numberOfTuples(other.numberOfTuples), ingestionTime(other.ingestionTime), slots(other.slots), columns(other.columns) {
+    // A copy of an owning buffer owns its own slots, a copy of a view shares the external columns
+    if (!slots.empty()) {
+        for (size_t field = 0; field < width; ++field) {
+            columns[field] = slots.data() + field * capacity;
+        }
+    }
+}
+
+TupleBuffer& TupleBuffer::operator=(const TupleBuffer& other) {
+    if (this != &other) {
+        *this = TupleBuffer(other);
+    }
+    return *this;
+}
+
+const SchemaPtr& TupleBuffer::getSchema() const { return schema; }
+
+size_t TupleBuffer::getNumberOfTuples() const { return numberOfTuples; }
+
+size_t TupleBuffer::getCapacity() const { return capacity; }
+
+bool TupleBuffer::isFull() const { return numberOfTuples == capacity; }
+
+bool TupleBuffer::isEmpty() const { return numberOfTuples == 0; }
+
+size_t TupleBuffer::append() {
+    if (isFull()) {
+        throw std::logic_error("TupleBuffer is full");
+    }
+    for (size_t field = 0; field < width; ++field) {
+        getColumn(field)[numberOfTuples] = 0;
+    }
+    return numberOfTuples++;
+}
+
+void TupleBuffer::setNumberOfTuples(size_t tuples) {
+    if (tuples > capacity) {
+        throw std::logic_error("TupleBuffer cannot hold " + std::to_string(tuples) + " tuples");
+    }
+    numberOfTuples = tuples;
+}
+
+void TupleBuffer::clear() { numberOfTuples = 0; }
+
+size_t TupleBuffer::appendRows(const TupleBuffer& source, const uint32_t* rows, size_t count) {
+    count = std::min(count, capacity - numberOfTuples);
+    for (size_t field = 0; field < std::min(width, source.width); ++field) {
+        const auto* from = source.getColumn(field);
+        auto* to = getColumn(field) + numberOfTuples;
+        for (size_t i = 0; i < count; ++i) {
+            to[i] = from[rows[i]];
+        }
+    }
+    numberOfTuples += count;
+    return count;
+}
+
+size_t TupleBuffer::appendRange(const TupleBuffer& source, size_t begin, size_t count) {
+    count = std::min(count, capacity - numberOfTuples);
+    for (size_t field = 0; field < std::min(width, source.width); ++field) {
+        std::memcpy(getColumn(field) + numberOfTuples, source.getColumn(field) + begin, count * sizeof(uint64_t));
+    }
+    numberOfTuples += count;
+    return count;
+}
+
+}// namespace SNCB::Engine
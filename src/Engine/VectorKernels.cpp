@@ -0,0 +1,257 @@
+#include <Engine/VectorKernels.hpp>
+
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SNCB_KERNELS_AVX2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SNCB_KERNELS_NEON 1
+#endif
+
+namespace SNCB::Engine::Kernels {
+
+namespace {
+
+// Each kernel runs its vector loop over the full lanes and finishes the tail with the scalar
+// operation, so results do not depend on the instruction set.
+#if defined(SNCB_KERNELS_AVX2)
+constexpr size_t Lanes = 4;
+using Vector = __m256d;
+inline Vector load(const double* in) { return _mm256_loadu_pd(in); }
+inline void store(double* out, Vector value) { _mm256_storeu_pd(out, value); }
+inline Vector broadcast(double value) { return _mm256_set1_pd(value); }
+inline Vector vadd(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+inline Vector vsub(Vector a, Vector b) { return _mm256_sub_pd(a, b); }
+inline Vector vmul(Vector a, Vector b) { return _mm256_mul_pd(a, b); }
+inline Vector vdiv(Vector a, Vector b) { return _mm256_div_pd(a, b); }
+// Comparison masks are all ones or all zeros per lane; and-ing them with 1.0 yields 1.0 or 0.0
+template<int Predicate>
+inline Vector vcompare(Vector a, Vector b) {
+    return _mm256_and_pd(_mm256_cmp_pd(a, b, Predicate), broadcast(1.0));
+}
+inline Vector vnonzero(Vector a) { return _mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_NEQ_UQ); }
+inline Vector vand(Vector a, Vector b) { return _mm256_and_pd(_mm256_and_pd(vnonzero(a), vnonzero(b)), broadcast(1.0)); }
+inline Vector vor(Vector a, Vector b) { return _mm256_and_pd(_mm256_or_pd(vnonzero(a), vnonzero(b)), broadcast(1.0)); }
+inline Vector vnot(Vector a) { return vcompare<_CMP_EQ_OQ>(a, _mm256_setzero_pd()); }
+inline uint64_t vbits(Vector a) { return static_cast<uint64_t>(_mm256_movemask_pd(vnonzero(a))); }
+// Unoptimized builds do not clear the upper register halves on return, which makes the SSE code of
+// libm that runs next (e.g. the geo functions) pay an AVX-SSE transition penalty per instruction
+inline void leaveVectorCode() { _mm256_zeroupper(); }
+constexpr int LessPredicate = _CMP_LT_OQ;
+constexpr int LessEqualsPredicate = _CMP_LE_OQ;
+constexpr int GreaterPredicate = _CMP_GT_OQ;
+constexpr int GreaterEqualsPredicate = _CMP_GE_OQ;
+constexpr int EqualsPredicate = _CMP_EQ_OQ;
+constexpr int NotEqualsPredicate = _CMP_NEQ_UQ;
+#elif defined(SNCB_KERNELS_NEON)
+constexpr size_t Lanes = 2;
+using Vector = float64x2_t;
+inline Vector load(const double* in) { return vld1q_f64(in); }
+inline void store(double* out, Vector value) { vst1q_f64(out, value); }
+inline Vector broadcast(double value) { return vdupq_n_f64(value); }
+inline Vector vadd(Vector a, Vector b) { return vaddq_f64(a, b); }
+inline Vector vsub(Vector a, Vector b) { return vsubq_f64(a, b); }
+inline Vector vmul(Vector a, Vector b) { return vmulq_f64(a, b); }
+inline Vector vdiv(Vector a, Vector b) { return vdivq_f64(a, b); }
+inline Vector vone(uint64x2_t mask) { return vreinterpretq_f64_u64(vandq_u64(mask, vreinterpretq_u64_f64(broadcast(1.0)))); }
+inline uint64x2_t vnonzero(Vector a) { return veorq_u64(vceqq_f64(a, vdupq_n_f64(0.0)), vdupq_n_u64(~0ULL)); }
+constexpr int LessPredicate = 0;
+constexpr int LessEqualsPredicate = 1;
+constexpr int GreaterPredicate = 2;
+constexpr int GreaterEqualsPredicate = 3;
+constexpr int EqualsPredicate = 4;
+constexpr int NotEqualsPredicate = 5;
+template<int Predicate>
+inline Vector vcompare(Vector a, Vector b) {
+    if constexpr (Predicate == LessPredicate) {
+        return vone(vcltq_f64(a, b));
+    } else if constexpr (Predicate == LessEqualsPredicate) {
+        return vone(vcleq_f64(a, b));
+    } else if constexpr (Predicate == GreaterPredicate) {
+        return vone(vcgtq_f64(a, b));
+    } else if constexpr (Predicate == GreaterEqualsPredicate) {
+        return vone(vcgeq_f64(a, b));
+    } else if constexpr (Predicate == EqualsPredicate) {
+        return vone(vceqq_f64(a, b));
+    } else {
+        return vone(veorq_u64(vceqq_f64(a, b), vdupq_n_u64(~0ULL)));
+    }
+}
+inline Vector vand(Vector a, Vector b) { return vone(vandq_u64(vnonzero(a), vnonzero(b))); }
+inline Vector vor(Vector a, Vector b) { return vone(vorrq_u64(vnonzero(a), vnonzero(b))); }
+inline Vector vnot(Vector a) { return vone(vceqq_f64(a, vdupq_n_f64(0.0))); }
+inline uint64_t vbits(Vector a) {
+    auto mask = vnonzero(a);
+    return (vgetq_lane_u64(mask, 0) & 1) | ((vgetq_lane_u64(mask, 1) & 1) << 1);
+}
+inline void leaveVectorCode() {}
+#else
+constexpr size_t Lanes = 1;
+constexpr int LessPredicate = 0;
+constexpr int LessEqualsPredicate = 1;
+constexpr int GreaterPredicate = 2;
+constexpr int GreaterEqualsPredicate = 3;
+constexpr int EqualsPredicate = 4;
+constexpr int NotEqualsPredicate = 5;
+#endif
+
+template<typename VectorOp, typename ScalarOp>
+inline void binary(const double* left, const double* right, double* out, size_t count, VectorOp vectorOp, ScalarOp scalarOp) {
+    size_t i = 0;
+#if defined(SNCB_KERNELS_AVX2) || defined(SNCB_KERNELS_NEON)
+    for (; i + Lanes <= count; i += Lanes) {
+        store(out + i, vectorOp(load(left + i), load(right + i)));
+    }
+    leaveVectorCode();
+#else
+    (void) vectorOp;
+#endif
+    for (; i < count; ++i) {
+        out[i] = scalarOp(left[i], right[i]);
+    }
+}
+
+template<int Predicate, typename ScalarOp>
+inline void compareWith(const double* left, const double* right, double* out, size_t count, ScalarOp scalarOp) {
+#if defined(SNCB_KERNELS_AVX2) || defined(SNCB_KERNELS_NEON)
+    binary(left, right, out, count, [](auto a, auto b) { return vcompare<Predicate>(a, b); }, scalarOp);
+#else
+    binary(left, right, out, count, nullptr, scalarOp);
+#endif
+}
+
+// Truth values of the scalar fallback and the tails, branch-free like the vector loops
+inline double truth(bool value) { return static_cast<double>(value); }
+
+}// namespace
+
+const char* getInstructionSet() {
+#if defined(SNCB_KERNELS_AVX2)
+    return "AVX2";
+#elif defined(SNCB_KERNELS_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+void fill(double value, double* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = value;
+    }
+}
+
+void toDouble(const uint64_t* in, double* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<double>(in[i]);
+    }
+}
+
+void toUInt(const double* in, uint64_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = in[i] <= 0.0 ? 0 : static_cast<uint64_t>(in[i]);
+    }
+}
+
+#if defined(SNCB_KERNELS_AVX2) || defined(SNCB_KERNELS_NEON)
+#define SNCB_VECTOR_OP(op) [](Vector a, Vector b) { return op(a, b); }
+#else
+#define SNCB_VECTOR_OP(op) nullptr
+#endif
+
+void add(const double* left, const double* right, double* out, size_t count) {
+    binary(left, right, out, count, SNCB_VECTOR_OP(vadd), [](double a, double b) { return a + b; });
+}
+
+void sub(const double* left, const double* right, double* out, size_t count) {
+    binary(left, right, out, count, SNCB_VECTOR_OP(vsub), [](double a, double b) { return a - b; });
+}
+
+void mul(const double* left, const double* right, double* out, size_t count) {
+    binary(left, right, out, count, SNCB_VECTOR_OP(vmul), [](double a, double b) { return a * b; });
+}
+
+void div(const double* left, const double* right, double* out, size_t count) {
+    binary(left, right, out, count, SNCB_VECTOR_OP(vdiv), [](double a, double b) { return a / b; });
+}
+
+void compare(Comparison comparison, const double* left, const double* right, double* out, size_t count) {
+    switch (comparison) {
+        case Comparison::Less:
+            compareWith<LessPredicate>(left, right, out, count, [](double a, double b) { return truth(a < b); });
+            break;
+        case Comparison::LessEquals:
+            compareWith<LessEqualsPredicate>(left, right, out, count, [](double a, double b) { return truth(a <= b); });
+            break;
+        case Comparison::Greater:
+            compareWith<GreaterPredicate>(left, right, out, count, [](double a, double b) { return truth(a > b); });
+            break;
+        case Comparison::GreaterEquals:
+            compareWith<GreaterEqualsPredicate>(left, right, out, count, [](double a, double b) { return truth(a >= b); });
+            break;
+        case Comparison::Equals:
+            compareWith<EqualsPredicate>(left, right, out, count, [](double a, double b) { return truth(a == b); });
+            break;
+        case Comparison::NotEquals:
+            compareWith<NotEqualsPredicate>(left, right, out, count, [](double a, double b) { return truth(a != b); });
+            break;
+    }
+}
+
+void logicalAnd(const double* left, const double* right, double* out, size_t count) {
+    binary(left, right, out, count, SNCB_VECTOR_OP(vand), [](double a, double b) { return truth((a != 0.0) & (b != 0.0)); });
+}
+
+void logicalOr(const double* left, const double* right, double* out, size_t count) {
+    binary(left, right, out, count, SNCB_VECTOR_OP(vor), [](double a, double b) { return truth((a != 0.0) | (b != 0.0)); });
+}
+
+void logicalNot(const double* in, double* out, size_t count) {
+    size_t i = 0;
+#if defined(SNCB_KERNELS_AVX2) || defined(SNCB_KERNELS_NEON)
+    for (; i + Lanes <= count; i += Lanes) {
+        store(out + i, vnot(load(in + i)));
+    }
+    leaveVectorCode();
+#endif
+    for (; i < count; ++i) {
+        out[i] = truth(in[i] == 0.0);
+    }
+}
+
+#undef SNCB_VECTOR_OP
+
+void toBitmap(const double* values, size_t count, uint64_t* bitmap) {
+    for (size_t word = 0; word * 64 < count; ++word) {
+        auto begin = word * 64;
+        auto end = begin + 64 < count ? begin + 64 : count;
+        uint64_t bits = 0;
+        size_t i = begin;
+#if defined(SNCB_KERNELS_AVX2) || defined(SNCB_KERNELS_NEON)
+        for (; i + Lanes <= end; i += Lanes) {
+            bits |= vbits(load(values + i)) << (i - begin);
+        }
+        leaveVectorCode();
+#endif
+        for (; i < end; ++i) {
+            bits |= static_cast<uint64_t>(values[i] != 0.0) << (i - begin);
+        }
+        bitmap[word] = bits;
+    }
+}
+
+size_t toSelection(const uint64_t* bitmap, size_t count, uint32_t offset, uint32_t* selection) {
+    size_t selected = 0;
+    for (size_t word = 0; word * 64 < count; ++word) {
+        auto bits = bitmap[word];
+        while (bits != 0) {
+            selection[selected++] = offset + static_cast<uint32_t>(word * 64 + std::countr_zero(bits));
+            bits &= bits - 1;
+        }
+    }
+    return selected;
+}
+
+}// namespace SNCB::Engine::Kernels
@@ -0,0 +1,101 @@
+#include <Engine/Windowing.hpp>
+
+#include <stdexcept>
+
+namespace SNCB::Engine {
+
+TimeMeasure Milliseconds(uint64_t milliseconds) { return {milliseconds}; }
+
+TimeMeasure Seconds(uint64_t seconds) { return {seconds * 1000}; }
+
+TimeMeasure Minutes(uint64_t minutes) { return {minutes * 60 * 1000}; }
+
+TimeCharacteristic EventTime(const ExpressionItem& field) {
+    if (field.getNode()->kind != ExpressionKind::Field) {
+        throw std::invalid_argument("EventTime expects an Attribute, got " + field.getNode()->toString());
+    }
+    return {field.getNode()->fieldName};
+}
+
+namespace {
+
+WindowTypePtr makeTimeWindow(WindowKind kind, TimeCharacteristic time, uint64_t size, uint64_t slide) {
+    WindowType window;
+    window.kind = kind;
+    window.time = std::move(time);
+    window.size = size;
+    window.slide = slide;
+    return std::make_shared<WindowType>(std::move(window));
+}
+
+}// namespace
+
+WindowTypePtr TumblingWindow::of(TimeCharacteristic time, TimeMeasure size) {
+    if (size.milliseconds == 0) {
+        throw std::invalid_argument("Tumbling window size must be positive");
+    }
+    return makeTimeWindow(WindowKind::Tumbling, std::move(time), size.milliseconds, size.milliseconds);
+}
+
+WindowTypePtr SlidingWindow::of(TimeCharacteristic time, TimeMeasure size, TimeMeasure slide) {
+    if (size.milliseconds == 0 || slide.milliseconds == 0 || slide.milliseconds > size.milliseconds) {
+        throw std::invalid_argument("Sliding window needs 0 < slide <= size");
+    }
+    return makeTimeWindow(WindowKind::Sliding, std::move(time), size.milliseconds, slide.milliseconds);
+}
+
+WindowTypePtr ThresholdWindow::of(const ExpressionItem& predicate) { return of(predicate, 0); }
+
+WindowTypePtr ThresholdWindow::of(const ExpressionItem& predicate, uint64_t minCount) {
+    WindowType window;
+    window.kind = WindowKind::Threshold;
+    window.predicate = predicate.getNode();
+    window.minCount = minCount;
+    return std::make_shared<WindowType>(std::move(window));
+}
+
+WindowTypePtr ThresholdWindow::of(const ExpressionItem& predicate, uint64_t minCount, TimeCharacteristic time,
+                                  TimeMeasure maxDuration) {
+    if (maxDuration.milliseconds == 0) {
+        throw std::invalid_argument("Threshold window maximum duration must be positive");
+    }
+    WindowType window = *of(predicate, minCount);
+    window.time = std::move(time);
+    window.maxDuration = maxDuration.milliseconds;
+    return std::make_shared<WindowType>(std::move(window));
+}
+
+WindowAggregation::WindowAggregation(AggregationKind kind, ExpressionNodePtr onField) : kind(kind), onField(std::move(onField)) {
+    if (this->onField && this->onField->kind == ExpressionKind::Field) {
+        asField = this->onField->fieldName;
+    } else if (kind == AggregationKind::Count) {
+        asField = "count";
+    }
+}
+
+WindowAggregationPtr WindowAggregation::as(const ExpressionItem& field) const {
+    if (field.getNode()->kind != ExpressionKind::Field) {
+        throw std::invalid_argument("as() expects an Attribute, got " + field.getNode()->toString());
+    }
+    auto renamed = std::make_shared<WindowAggregation>(*this);
+    renamed->asField = field.getNode()->fieldName;
+    return renamed;
+}
+
+AggregationKind WindowAggregation::getKind() const { return kind; }
+
+const ExpressionNodePtr& WindowAggregation::getOnField() const { return onField; }
+
+const std::string& WindowAggregation::getAsField() const { return asField; }
+
+WindowAggregationPtr Min(const ExpressionItem& field) { return std::make_shared<WindowAggregation>(AggregationKind::Min, field.getNode()); }
+
+WindowAggregationPtr Max(const ExpressionItem& field) { return std::make_shared<WindowAggregation>(AggregationKind::Max, field.getNode()); }
+
+WindowAggregationPtr Sum(const ExpressionItem& field) { return std::make_shared<WindowAggregation>(AggregationKind::Sum, field.getNode()); }
+
+WindowAggregationPtr Avg(const ExpressionItem& field) { return std::make_shared<WindowAggregation>(AggregationKind::Avg, field.getNode()); }
+
+WindowAggregationPtr Count() { return std::make_shared<WindowAggregation>(AggregationKind::Count, nullptr); }
+
+}// namespace SNCB::Engine
@@ -0,0 +1,98 @@
+#include <Util/ByteScan.hpp>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace SNCB::Util {
+
+uint64_t countByte(const char* data, size_t size, char byte) {
+    uint64_t count = 0;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi8(byte);
+    for (; i + 32 <= size; i += 32) {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        count += static_cast<uint64_t>(__builtin_popcount(mask));
+    }
+#elif defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi8(byte);
+    for (; i + 16 <= size; i += 16) {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+        count += static_cast<uint64_t>(__builtin_popcount(mask));
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t needle = vdupq_n_u8(static_cast<uint8_t>(byte));
+    // Matches are 0xFF per lane; subtracting them counts up to 255 steps per lane before a widening flush
+    while (i + 16 <= size) {
+        uint8x16_t lanes = vdupq_n_u8(0);
+        size_t steps = 0;
+        for (; i + 16 <= size && steps < 255; i += 16, ++steps) {
+            auto block = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+            lanes = vsubq_u8(lanes, vceqq_u8(block, needle));
+        }
+        uint64x2_t sums = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(lanes)));
+        count += vgetq_lane_u64(sums, 0) + vgetq_lane_u64(sums, 1);
+    }
+#endif
+
+    for (; i < size; ++i) {
+        count += data[i] == byte;
+    }
+    return count;
+}
+
+size_t indexStructurals(const char* data, size_t size, char delimiter, uint32_t* positions) {
+    size_t count = 0;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i delimiters = _mm256_set1_epi8(delimiter);
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    for (; i + 32 <= size; i += 32) {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto matches = _mm256_or_si256(_mm256_cmpeq_epi8(block, delimiters), _mm256_cmpeq_epi8(block, newlines));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+        for (; mask != 0; mask &= mask - 1) {
+            positions[count++] = static_cast<uint32_t>(i + static_cast<size_t>(__builtin_ctz(mask)));
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+    const __m128i newlines = _mm_set1_epi8('\n');
+    for (; i + 16 <= size; i += 16) {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto matches = _mm_or_si128(_mm_cmpeq_epi8(block, delimiters), _mm_cmpeq_epi8(block, newlines));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+        for (; mask != 0; mask &= mask - 1) {
+            positions[count++] = static_cast<uint32_t>(i + static_cast<size_t>(__builtin_ctz(mask)));
+        }
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t delimiters = vdupq_n_u8(static_cast<uint8_t>(delimiter));
+    const uint8x16_t newlines = vdupq_n_u8('\n');
+    for (; i + 16 <= size; i += 16) {
+        auto block = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        auto matches = vorrq_u8(vceqq_u8(block, delimiters), vceqq_u8(block, newlines));
+        // NEON has no movemask: narrowing by 4 bits leaves one nibble per byte, of which one bit is kept
+        auto mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0) & 0x1111111111111111ULL;
+        for (; mask != 0; mask &= mask - 1) {
+            positions[count++] = static_cast<uint32_t>(i + static_cast<size_t>(__builtin_ctzll(mask)) / 4);
+        }
+    }
+#endif
+
+    for (; i < size; ++i) {
+        if (data[i] == delimiter || data[i] == '\n') {
+            positions[count++] = static_cast<uint32_t>(i);
+        }
+    }
+    return count;
+}
+
+}// namespace SNCB::Util
@@ -0,0 +1,82 @@
+#include <Util/LatencyHistogram.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace SNCB::Util {
+
+namespace {
+// Values below SubBuckets get a bucket each, every larger power of two SubBuckets
+constexpr size_t numberOfBuckets = LatencyHistogram::SubBuckets * (64 - LatencyHistogram::SubBucketBits + 1);
+}// namespace
+
+LatencyHistogram::LatencyHistogram() : counts(numberOfBuckets) {}
+
+size_t LatencyHistogram::bucketOf(uint64_t value) {
+    if (value < SubBuckets) {
+        return value;
+    }
+    unsigned exponent = std::bit_width(value) - 1;
+    unsigned shift = exponent - SubBucketBits;
+    return (exponent - SubBucketBits + 1) * SubBuckets + ((value >> shift) - SubBuckets);
+}
+
+uint64_t LatencyHistogram::upperBoundOf(size_t bucket) {
+    if (bucket < SubBuckets) {
+        return bucket;
+    }
+    unsigned shift = bucket / SubBuckets - 1;
+    uint64_t subBucket = SubBuckets + bucket % SubBuckets;
+    // The last bucket ends at the largest uint64_t
+    return shift == 64 - SubBucketBits - 1 && subBucket == 2 * SubBuckets - 1 ? UINT64_MAX : ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value, uint64_t occurrences) {
+    if (occurrences == 0) {
+        return;
+    }
+    counts[bucketOf(value)] += occurrences;
+    min = count == 0 ? value : std::min(min, value);
+    max = std::max(max, value);
+    count += occurrences;
+    sum += static_cast<double>(value) * static_cast<double>(occurrences);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.count == 0) {
+        return;
+    }
+    for (size_t bucket = 0; bucket < counts.size(); ++bucket) {
+        counts[bucket] += other.counts[bucket];
+    }
+    min = count == 0 ? other.min : std::min(min, other.min);
+    max = std::max(max, other.max);
+    count += other.count;
+    sum += other.sum;
+}
+
+uint64_t LatencyHistogram::getCount() const { return count; }
+
+uint64_t LatencyHistogram::getMin() const { return min; }
+
+uint64_t LatencyHistogram::getMax() const { return max; }
+
+double LatencyHistogram::getMean() const { return count == 0 ? 0.0 : sum / static_cast<double>(count); }
+
+uint64_t LatencyHistogram::getPercentile(double percent) const {
+    if (count == 0) {
+        return 0;
+    }
+    auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(percent, 0.0, 100.0) / 100.0 * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < counts.size(); ++bucket) {
+        seen += counts[bucket];
+        if (seen >= rank) {
+            return std::clamp(upperBoundOf(bucket), min, max);
+        }
+    }
+    return max;
+}
+
+}// namespace SNCB::Util
@@ -0,0 +1,107 @@
+#include <Util/NumberParsing.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace SNCB::Util {
+
+namespace {
+
+constexpr double powersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+constexpr uint64_t maxExactMantissa = uint64_t{1} << 53;
+
+bool isDigit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+
+/** @brief Calls the C parser on a null-terminated copy, so it cannot read past the field. */
+template<typename Parse>
+auto parseCopy(const char* begin, const char* end, Parse parse) {
+    auto length = static_cast<size_t>(end - begin);
+    char text[64];
+    if (length < sizeof(text)) {
+        std::memcpy(text, begin, length);
+        text[length] = '\0';
+        return parse(text);
+    }
+    std::string copy(begin, end);
+    return parse(copy.c_str());
+}
+
+double strtodCopy(const char* begin, const char* end) {
+    return parseCopy(begin, end, [](const char* text) { return std::strtod(text, nullptr); });
+}
+
+}// namespace
+
+uint64_t parseUInt64(const char* begin, const char* end) {
+    uint64_t value = 0;
+    const char* cursor = begin;
+    for (; cursor != end && isDigit(*cursor) && cursor - begin < 19; ++cursor) {
+        value = value * 10 + static_cast<uint64_t>(*cursor - '0');
+    }
+    if (cursor == begin || (cursor != end && isDigit(*cursor))) {
+        return parseCopy(begin, end, [](const char* text) { return std::strtoull(text, nullptr, 10); });
+    }
+    return value;
+}
+
+double parseDouble(const char* begin, const char* end) {
+    const char* cursor = begin;
+    bool negative = cursor != end && *cursor == '-';
+    cursor += negative;
+
+    uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool anyDigit = false;
+    for (; cursor != end && isDigit(*cursor); ++cursor) {
+        anyDigit = true;
+        if (mantissa != 0 || *cursor != '0') {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor - '0');
+            ++significantDigits;
+        }
+    }
+    if (cursor != end && *cursor == '.') {
+        for (++cursor; cursor != end && isDigit(*cursor); ++cursor) {
+            anyDigit = true;
+            if (mantissa != 0 || *cursor != '0') {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor - '0');
+                ++significantDigits;
+            }
+            --exponent;
+        }
+    }
+    // No digits (inf, nan, empty), hexadecimal, or a mantissa that may have overflowed
+    if (!anyDigit || significantDigits > 19 || (cursor != end && (*cursor == 'x' || *cursor == 'X'))) {
+        return strtodCopy(begin, end);
+    }
+    if (cursor != end && (*cursor == 'e' || *cursor == 'E')) {
+        const char* digits = cursor + 1;
+        bool negativeExponent = digits != end && *digits == '-';
+        digits += digits != end && (*digits == '-' || *digits == '+');
+        // An 'e' without digits is not part of the number, as for strtod
+        if (digits != end && isDigit(*digits)) {
+            int value = 0;
+            for (; digits != end && isDigit(*digits); ++digits) {
+                if (value > 1000) {
+                    return strtodCopy(begin, end);
+                }
+                value = value * 10 + (*digits - '0');
+            }
+            exponent += negativeExponent ? -value : value;
+        }
+    }
+
+    if (mantissa == 0) {
+        return negative ? -0.0 : 0.0;
+    }
+    if (mantissa > maxExactMantissa || exponent < -22 || exponent > 22) {
+        return strtodCopy(begin, end);
+    }
+    double value = static_cast<double>(mantissa);
+    value = exponent < 0 ? value / powersOfTen[-exponent] : value * powersOfTen[exponent];
+    return negative ? -value : value;
+}
+
+}// namespace SNCB::Util
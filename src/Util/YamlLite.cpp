@@ -0,0 +1,289 @@
+#include <Util/YamlLite.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace SNCB::Util {
+
+namespace {
+
+struct Line {
+    size_t number;
+    size_t indent;
+    std::string content;
+};
+
+std::string trim(const std::string& value) {
+    auto begin = value.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    auto end = value.find_last_not_of(" \t\r");
+    return value.substr(begin, end - begin + 1);
+}
+
+/** @brief Removes a comment, i.e. a '#' at the start or after whitespace that is not inside quotes. */
+std::string stripComment(const std::string& line) {
+    char quote = 0;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quote != 0) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '#' && (i == 0 || line[i - 1] == ' ' || line[i - 1] == '\t')) {
+            return line.substr(0, i);
+        }
+    }
+    return line;
+}
+
+std::string unquote(const std::string& value) {
+    if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front()) {
+        return value.substr(1, value.size() - 2);
+    }
+    return value;
+}
+
+/** @brief The quote character that is still open at the end of the line, 0 if none. */
+char openQuote(const std::string& content) {
+    char quote = 0;
+    for (char c : content) {
+        if (quote != 0) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        }
+    }
+    return quote;
+}
+
+bool isListItem(const std::string& content) { return content == "-" || content.rfind("- ", 0) == 0; }
+
+/** @brief Position of the ':' that separates key and value, npos if the line is no map entry. */
+size_t findKeySeparator(const std::string& content) {
+    char quote = 0;
+    for (size_t i = 0; i < content.size(); ++i) {
+        char c = content[i];
+        if (quote != 0) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == ':' && (i + 1 == content.size() || content[i + 1] == ' ')) {
+            return i;
+        }
+    }
+    return std::string::npos;
+}
+
+}// namespace
+
+class YamlParser {
+  public:
+    explicit YamlParser(const std::string& text) {
+        std::istringstream input(text);
+        std::string raw;
+        size_t number = 0;
+        while (std::getline(input, raw)) {
+            ++number;
+            auto content = stripComment(raw);
+            // A quoted scalar may continue on the following lines, which are folded into one line
+            auto startNumber = number;
+            while (openQuote(content) != 0 && std::getline(input, raw)) {
+                ++number;
+                content += " " + trim(raw);
+                if (openQuote(content) == 0) {
+                    content = stripComment(content);
+                }
+            }
+            auto trimmed = trim(content);
+            if (trimmed.empty() || trimmed == "---") {
+                continue;
+            }
+            if (content.find('\t') < content.find_first_not_of(" \t")) {
+                throw std::runtime_error("YAML line " + std::to_string(startNumber) + ": tabs are not allowed for indentation");
+            }
+            lines.push_back({startNumber, content.find_first_not_of(' '), trimmed});
+        }
+    }
+
+    YamlNode parseDocument() {
+        if (lines.empty()) {
+            return {};
+        }
+        auto node = parseBlock(lines[0].indent);
+        if (position < lines.size()) {
+            fail("unexpected indentation");
+        }
+        return node;
+    }
+
+  private:
+    [[noreturn]] void fail(const std::string& message) const {
+        auto number = position < lines.size() ? lines[position].number : lines.back().number;
+        throw std::runtime_error("YAML line " + std::to_string(number) + ": " + message);
+    }
+
+    YamlNode parseBlock(size_t indent) {
+        return isListItem(lines[position].content) ? parseList(indent) : parseMap(indent);
+    }
+
+    YamlNode parseList(size_t indent) {
+        YamlNode node;
+        node.kind = YamlNode::Kind::List;
+        while (position < lines.size() && lines[position].indent == indent && isListItem(lines[position].content)) {
+            auto& line = lines[position];
+            auto rest = trim(line.content.substr(1));
+            if (rest.empty()) {
+                ++position;
+                node.list.push_back(parseNested(indent));
+            } else if (findKeySeparator(rest) != std::string::npos) {
+                // "- key: value" starts a map whose keys are aligned with the first key
+                line.indent += line.content.find(rest);
+                line.content = rest;
+                node.list.push_back(parseMap(line.indent));
+            } else {
+                YamlNode item;
+                item.kind = YamlNode::Kind::Scalar;
+                item.scalar = unquote(rest);
+                node.list.push_back(std::move(item));
+                ++position;
+            }
+        }
+        return node;
+    }
+
+    YamlNode parseMap(size_t indent) {
+        YamlNode node;
+        node.kind = YamlNode::Kind::Map;
+        while (position < lines.size() && lines[position].indent >= indent) {
+            const auto& line = lines[position];
+            if (line.indent > indent) {
+                fail("unexpected indentation");
+            }
+            if (isListItem(line.content)) {
+                break;
+            }
+            auto separator = findKeySeparator(line.content);
+            if (separator == std::string::npos) {
+                fail("expected 'key: value'");
+            }
+            auto key = unquote(trim(line.content.substr(0, separator)));
+            auto value = trim(line.content.substr(separator + 1));
+            ++position;
+
+            YamlNode child;
+            if (!value.empty()) {
+                child.kind = YamlNode::Kind::Scalar;
+                child.scalar = unquote(value);
+            } else if (position < lines.size() && lines[position].indent == indent && isListItem(lines[position].content)) {
+                // A list may start at the indentation of its key
+                child = parseList(indent);
+            } else {
+                child = parseNested(indent);
+            }
+            node.map.emplace_back(std::move(key), std::move(child));
+        }
+        return node;
+    }
+
+    YamlNode parseNested(size_t parentIndent) {
+        if (position < lines.size() && lines[position].indent > parentIndent) {
+            return parseBlock(lines[position].indent);
+        }
+        return {};
+    }
+
+    std::vector<Line> lines;
+    size_t position = 0;
+};
+
+YamlNode YamlNode::parseFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open YAML file " + path);
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    try {
+        return parse(content.str());
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(path + ": " + e.what());
+    }
+}
+
+YamlNode YamlNode::parse(const std::string& text) { return YamlParser(text).parseDocument(); }
+
+YamlNode::Kind YamlNode::getKind() const { return kind; }
+
+bool YamlNode::isNull() const { return kind == Kind::Null; }
+
+const YamlNode& YamlNode::operator[](const std::string& key) const {
+    static const YamlNode null;
+    for (const auto& [name, value] : map) {
+        if (name == key) {
+            return value;
+        }
+    }
+    return null;
+}
+
+bool YamlNode::has(const std::string& key) const { return !(*this)[key].isNull(); }
+
+const std::vector<YamlNode>& YamlNode::items() const { return list; }
+
+const std::vector<std::pair<std::string, YamlNode>>& YamlNode::entries() const { return map; }
+
+std::string YamlNode::asString(const std::string& fallback) const { return kind == Kind::Scalar ? scalar : fallback; }
+
+uint64_t YamlNode::asUInt(uint64_t fallback) const {
+    if (kind != Kind::Scalar) {
+        return fallback;
+    }
+    size_t consumed = 0;
+    try {
+        auto value = std::stoull(scalar, &consumed);
+        if (consumed == scalar.size()) {
+            return value;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("YAML value '" + scalar + "' is not an unsigned integer");
+}
+
+double YamlNode::asDouble(double fallback) const {
+    if (kind != Kind::Scalar) {
+        return fallback;
+    }
+    size_t consumed = 0;
+    try {
+        auto value = std::stod(scalar, &consumed);
+        if (consumed == scalar.size()) {
+            return value;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("YAML value '" + scalar + "' is not a number");
+}
+
+bool YamlNode::asBool(bool fallback) const {
+    if (kind != Kind::Scalar) {
+        return fallback;
+    }
+    if (scalar == "true" || scalar == "True" || scalar == "yes") {
+        return true;
+    }
+    if (scalar == "false" || scalar == "False" || scalar == "no") {
+        return false;
+    }
+    throw std::invalid_argument("YAML value '" + scalar + "' is not a boolean");
+}
+
+}// namespace SNCB::Util